@@ -133,15 +133,19 @@ typedef void (APIENTRY *GLVULKANPROCNV)(void);
 #define GL_FALSE 0
 #define GL_TRUE 1
 #define GL_TRIANGLES 0x0004
+#define GL_TRIANGLE_STRIP 0x0005
 #define GL_QUADS 0x0007
+#define GL_ZERO 0
 #define GL_ONE 1
 #define GL_SRC_ALPHA 0x0302
 #define GL_ONE_MINUS_SRC_ALPHA 0x0303
+#define GL_DST_COLOR 0x0306
 #define GL_FRONT 0x0404
 #define GL_BACK 0x0405
 #define GL_FRONT_AND_BACK 0x0408
 #define GL_CULL_FACE 0x0B44
 #define GL_BLEND 0x0BE2
+#define GL_VIEWPORT 0x0BA2
 #define GL_DEPTH_TEST 0x0B71
 #define GL_SCISSOR_TEST 0x0C11
 #define GL_TEXTURE_2D 0x0DE1
@@ -162,10 +166,13 @@ typedef void (APIENTRY *GLVULKANPROCNV)(void);
 #define GL_TEXTURE_WRAP_T 0x2803
 #define GL_REPEAT 0x2901
 #define GL_CLAMP_TO_EDGE 0x812F
+#define GL_TEXTURE_MAX_LEVEL 0x813D
 #define GL_FRAGMENT_SHADER 0x8B30
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_COMPILE_STATUS 0x8B81
 #define GL_LINK_STATUS 0x8B82
+#define GL_ACTIVE_UNIFORMS 0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH 0x8B87
 #define GL_VERSION 0x1F02
 #define GL_LEQUAL 0x0203
 #define GL_RED 0x1903
@@ -196,6 +203,30 @@ typedef void (APIENTRY *GLVULKANPROCNV)(void);
 #define GL_STREAM_DRAW 0x88E0
 #define GL_STATIC_DRAW 0x88E4
 #define GL_DYNAMIC_DRAW 0x88E8
+#define GL_TEXTURE_BUFFER 0x8C2A
+#define GL_RGBA32F 0x8814
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#define GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH 0x8A35
+#define GL_ACTIVE_UNIFORM_BLOCKS 0x8A36
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GL_TIME_ELAPSED 0x88BF
 
 /* OpenGL Functions */
 typedef void (APIENTRYP PFNGLCLEARPROC)(GLbitfield mask);
@@ -204,11 +235,13 @@ typedef void (APIENTRYP PFNGLVIEWPORTPROC)(GLint x, GLint y, GLsizei width, GLsi
 typedef void (APIENTRYP PFNGLENABLEPROC)(GLenum cap);
 typedef void (APIENTRYP PFNGLDISABLEPROC)(GLenum cap);
 typedef void (APIENTRYP PFNGLBLENDFUNCPROC)(GLenum sfactor, GLenum dfactor);
+typedef void (APIENTRYP PFNGLBLENDFUNCSEPARATEPROC)(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
 typedef void (APIENTRYP PFNGLGENTEXTURESPROC)(GLsizei n, GLuint *textures);
 typedef void (APIENTRYP PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint *textures);
 typedef void (APIENTRYP PFNGLBINDTEXTUREPROC)(GLenum target, GLuint texture);
 typedef void (APIENTRYP PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLint param);
 typedef void (APIENTRYP PFNGLTEXIMAGE2DPROC)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels);
+typedef void (APIENTRYP PFNGLTEXSUBIMAGE2DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels);
 typedef void (APIENTRYP PFNGLGENERATEMIPMAPPROC)(GLenum target);
 typedef GLuint (APIENTRYP PFNGLCREATESHADERPROC)(GLenum type);
 typedef void (APIENTRYP PFNGLSHADERSOURCEPROC)(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length);
@@ -225,6 +258,8 @@ typedef void (APIENTRYP PFNGLDELETEPROGRAMPROC)(GLuint program);
 typedef void (APIENTRYP PFNGLUSEPROGRAMPROC)(GLuint program);
 typedef GLint (APIENTRYP PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const GLchar *name);
 typedef void (APIENTRYP PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
+typedef void (APIENTRYP PFNGLUNIFORM1IVPROC)(GLint location, GLsizei count, const GLint *value);
+typedef void (APIENTRYP PFNGLGETACTIVEUNIFORMPROC)(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
 typedef void (APIENTRYP PFNGLUNIFORM1FPROC)(GLint location, GLfloat v0);
 typedef void (APIENTRYP PFNGLUNIFORM2FPROC)(GLint location, GLfloat v0, GLfloat v1);
 typedef void (APIENTRYP PFNGLUNIFORM3FPROC)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
@@ -259,6 +294,31 @@ typedef void (APIENTRYP PFNGLDELETERENDERBUFFERSPROC)(GLsizei n, const GLuint *r
 typedef void (APIENTRYP PFNGLBINDRENDERBUFFERPROC)(GLenum target, GLuint renderbuffer);
 typedef void (APIENTRYP PFNGLRENDERBUFFERSTORAGEPROC)(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
 typedef void (APIENTRYP PFNGLFRAMEBUFFERRENDERBUFFERPROC)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBIPOINTERPROC)(GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer);
+typedef void (APIENTRYP PFNGLDRAWARRAYSINSTANCEDPROC)(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+typedef void (APIENTRYP PFNGLTEXBUFFERPROC)(GLenum target, GLenum internalformat, GLuint buffer);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBDIVISORPROC)(GLuint index, GLuint divisor);
+typedef void (APIENTRYP PFNGLGETINTEGERVPROC)(GLenum pname, GLint *data);
+typedef void *(APIENTRYP PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRYP PFNGLUNMAPBUFFERPROC)(GLenum target);
+typedef void (APIENTRYP PFNGLGENQUERIESPROC)(GLsizei n, GLuint *ids);
+typedef void (APIENTRYP PFNGLDELETEQUERIESPROC)(GLsizei n, const GLuint *ids);
+typedef void (APIENTRYP PFNGLBEGINQUERYPROC)(GLenum target, GLuint id);
+typedef void (APIENTRYP PFNGLENDQUERYPROC)(GLenum target);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTIVPROC)(GLuint id, GLenum pname, GLint *params);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64 *params);
+typedef void (APIENTRYP PFNGLBINDBUFFERRANGEPROC)(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+typedef GLuint (APIENTRYP PFNGLGETUNIFORMBLOCKINDEXPROC)(GLuint program, const GLchar *uniformBlockName);
+typedef void (APIENTRYP PFNGLUNIFORMBLOCKBINDINGPROC)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+typedef void (APIENTRYP PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC)(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName);
+typedef void (APIENTRYP PFNGLDRAWELEMENTSBASEVERTEXPROC)(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC)(GLsync sync);
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
 
 GLAPI PFNGLCLEARPROC glClear;
 GLAPI PFNGLCLEARCOLORPROC glClearColor;
@@ -266,6 +326,7 @@ GLAPI PFNGLVIEWPORTPROC glViewport;
 GLAPI PFNGLENABLEPROC glEnable;
 GLAPI PFNGLDISABLEPROC glDisable;
 GLAPI PFNGLBLENDFUNCPROC glBlendFunc;
+GLAPI PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate;
 GLAPI PFNGLDEPTHFUNCPROC glDepthFunc;
 GLAPI PFNGLACTIVETEXTUREPROC glActiveTexture;
 GLAPI PFNGLGETFLOATVPROC glGetFloatv;
@@ -287,6 +348,7 @@ GLAPI PFNGLDELETETEXTURESPROC glDeleteTextures;
 GLAPI PFNGLBINDTEXTUREPROC glBindTexture;
 GLAPI PFNGLTEXPARAMETERIPROC glTexParameteri;
 GLAPI PFNGLTEXIMAGE2DPROC glTexImage2D;
+GLAPI PFNGLTEXSUBIMAGE2DPROC glTexSubImage2D;
 GLAPI PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 GLAPI PFNGLCREATESHADERPROC glCreateShader;
 GLAPI PFNGLSHADERSOURCEPROC glShaderSource;
@@ -303,6 +365,8 @@ GLAPI PFNGLDELETEPROGRAMPROC glDeleteProgram;
 GLAPI PFNGLUSEPROGRAMPROC glUseProgram;
 GLAPI PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 GLAPI PFNGLUNIFORM1IPROC glUniform1i;
+GLAPI PFNGLUNIFORM1IVPROC glUniform1iv;
+GLAPI PFNGLGETACTIVEUNIFORMPROC glGetActiveUniform;
 GLAPI PFNGLUNIFORM1FPROC glUniform1f;
 GLAPI PFNGLUNIFORM2FPROC glUniform2f;
 GLAPI PFNGLUNIFORM3FPROC glUniform3f;
@@ -321,6 +385,31 @@ GLAPI PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
 GLAPI PFNGLDRAWARRAYSPROC glDrawArrays;
 GLAPI PFNGLDRAWELEMENTSPROC glDrawElements;
 GLAPI PFNGLGETSTRINGPROC glGetString;
+GLAPI PFNGLVERTEXATTRIBIPOINTERPROC glVertexAttribIPointer;
+GLAPI PFNGLDRAWARRAYSINSTANCEDPROC glDrawArraysInstanced;
+GLAPI PFNGLTEXBUFFERPROC glTexBuffer;
+GLAPI PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
+GLAPI PFNGLGETINTEGERVPROC glGetIntegerv;
+GLAPI PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+GLAPI PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+GLAPI PFNGLGENQUERIESPROC glGenQueries;
+GLAPI PFNGLDELETEQUERIESPROC glDeleteQueries;
+GLAPI PFNGLBEGINQUERYPROC glBeginQuery;
+GLAPI PFNGLENDQUERYPROC glEndQuery;
+GLAPI PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+GLAPI PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+GLAPI PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
+GLAPI PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
+GLAPI PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
+GLAPI PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC glGetActiveUniformBlockName;
+GLAPI PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex;
+GLAPI PFNGLFENCESYNCPROC glFenceSync;
+GLAPI PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+GLAPI PFNGLDELETESYNCPROC glDeleteSync;
+GLAPI PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+GLAPI PFNGLPROGRAMBINARYPROC glProgramBinary;
+GLAPI PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+GLAPI PFNGLBUFFERSTORAGEPROC glBufferStorage;
 
 #ifdef __cplusplus
 }
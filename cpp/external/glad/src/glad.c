@@ -48,6 +48,7 @@ PFNGLVIEWPORTPROC glViewport;
 PFNGLENABLEPROC glEnable;
 PFNGLDISABLEPROC glDisable;
 PFNGLBLENDFUNCPROC glBlendFunc;
+PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate;
 PFNGLDEPTHFUNCPROC glDepthFunc;
 PFNGLACTIVETEXTUREPROC glActiveTexture;
 PFNGLGETFLOATVPROC glGetFloatv;
@@ -69,6 +70,7 @@ PFNGLDELETETEXTURESPROC glDeleteTextures;
 PFNGLBINDTEXTUREPROC glBindTexture;
 PFNGLTEXPARAMETERIPROC glTexParameteri;
 PFNGLTEXIMAGE2DPROC glTexImage2D;
+PFNGLTEXSUBIMAGE2DPROC glTexSubImage2D;
 PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 PFNGLCREATESHADERPROC glCreateShader;
 PFNGLSHADERSOURCEPROC glShaderSource;
@@ -85,6 +87,8 @@ PFNGLDELETEPROGRAMPROC glDeleteProgram;
 PFNGLUSEPROGRAMPROC glUseProgram;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 PFNGLUNIFORM1IPROC glUniform1i;
+PFNGLUNIFORM1IVPROC glUniform1iv;
+PFNGLGETACTIVEUNIFORMPROC glGetActiveUniform;
 PFNGLUNIFORM1FPROC glUniform1f;
 PFNGLUNIFORM2FPROC glUniform2f;
 PFNGLUNIFORM3FPROC glUniform3f;
@@ -103,6 +107,31 @@ PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
 PFNGLDRAWARRAYSPROC glDrawArrays;
 PFNGLDRAWELEMENTSPROC glDrawElements;
 PFNGLGETSTRINGPROC glGetString;
+PFNGLVERTEXATTRIBIPOINTERPROC glVertexAttribIPointer;
+PFNGLDRAWARRAYSINSTANCEDPROC glDrawArraysInstanced;
+PFNGLTEXBUFFERPROC glTexBuffer;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
+PFNGLGETINTEGERVPROC glGetIntegerv;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+PFNGLGENQUERIESPROC glGenQueries;
+PFNGLDELETEQUERIESPROC glDeleteQueries;
+PFNGLBEGINQUERYPROC glBeginQuery;
+PFNGLENDQUERYPROC glEndQuery;
+PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
+PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC glGetActiveUniformBlockName;
+PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex;
+PFNGLFENCESYNCPROC glFenceSync;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+PFNGLDELETESYNCPROC glDeleteSync;
+PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+PFNGLPROGRAMBINARYPROC glProgramBinary;
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+PFNGLBUFFERSTORAGEPROC glBufferStorage;
 
 static void load_GL_VERSION_1_0(GLADloadproc load) {
     glClear = (PFNGLCLEARPROC)load("glClear");
@@ -115,6 +144,7 @@ static void load_GL_VERSION_1_0(GLADloadproc load) {
     glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
     glCullFace = (PFNGLCULLFACEPROC)load("glCullFace");
     glFrontFace = (PFNGLFRONTFACEPROC)load("glFrontFace");
+    glGetIntegerv = (PFNGLGETINTEGERVPROC)load("glGetIntegerv");
 }
 
 static void load_GL_VERSION_1_1(GLADloadproc load) {
@@ -124,17 +154,28 @@ static void load_GL_VERSION_1_1(GLADloadproc load) {
     glTexParameteri = (PFNGLTEXPARAMETERIPROC)load("glTexParameteri");
     glTexParameterf = (PFNGLTEXPARAMETERFPROC)load("glTexParameterf");
     glTexImage2D = (PFNGLTEXIMAGE2DPROC)load("glTexImage2D");
+    glTexSubImage2D = (PFNGLTEXSUBIMAGE2DPROC)load("glTexSubImage2D");
     glDrawArrays = (PFNGLDRAWARRAYSPROC)load("glDrawArrays");
     glDrawElements = (PFNGLDRAWELEMENTSPROC)load("glDrawElements");
     glGetFloatv = (PFNGLGETFLOATVPROC)load("glGetFloatv");
 }
 
+static void load_GL_VERSION_1_4(GLADloadproc load) {
+    glBlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)load("glBlendFuncSeparate");
+}
+
 static void load_GL_VERSION_1_5(GLADloadproc load) {
     glGenBuffers = (PFNGLGENBUFFERSPROC)load("glGenBuffers");
     glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)load("glDeleteBuffers");
     glBindBuffer = (PFNGLBINDBUFFERPROC)load("glBindBuffer");
     glBufferData = (PFNGLBUFFERDATAPROC)load("glBufferData");
     glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load("glBufferSubData");
+    glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)load("glUnmapBuffer");
+    glGenQueries = (PFNGLGENQUERIESPROC)load("glGenQueries");
+    glDeleteQueries = (PFNGLDELETEQUERIESPROC)load("glDeleteQueries");
+    glBeginQuery = (PFNGLBEGINQUERYPROC)load("glBeginQuery");
+    glEndQuery = (PFNGLENDQUERYPROC)load("glEndQuery");
+    glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load("glGetQueryObjectiv");
 }
 
 static void load_GL_VERSION_2_0(GLADloadproc load) {
@@ -153,6 +194,8 @@ static void load_GL_VERSION_2_0(GLADloadproc load) {
     glUseProgram = (PFNGLUSEPROGRAMPROC)load("glUseProgram");
     glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)load("glGetUniformLocation");
     glUniform1i = (PFNGLUNIFORM1IPROC)load("glUniform1i");
+    glUniform1iv = (PFNGLUNIFORM1IVPROC)load("glUniform1iv");
+    glGetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)load("glGetActiveUniform");
     glUniform1f = (PFNGLUNIFORM1FPROC)load("glUniform1f");
     glUniform2f = (PFNGLUNIFORM2FPROC)load("glUniform2f");
     glUniform3f = (PFNGLUNIFORM3FPROC)load("glUniform3f");
@@ -178,6 +221,42 @@ static void load_GL_VERSION_3_0(GLADloadproc load) {
     glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)load("glBindRenderbuffer");
     glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)load("glRenderbufferStorage");
     glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)load("glFramebufferRenderbuffer");
+    glVertexAttribIPointer = (PFNGLVERTEXATTRIBIPOINTERPROC)load("glVertexAttribIPointer");
+    glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+    glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC)load("glBindBufferRange");
+}
+
+static void load_GL_VERSION_3_1(GLADloadproc load) {
+    glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)load("glDrawArraysInstanced");
+    glTexBuffer = (PFNGLTEXBUFFERPROC)load("glTexBuffer");
+    glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load("glGetUniformBlockIndex");
+    glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load("glUniformBlockBinding");
+    glGetActiveUniformBlockName = (PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC)load("glGetActiveUniformBlockName");
+}
+
+static void load_GL_VERSION_3_2(GLADloadproc load) {
+    glDrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)load("glDrawElementsBaseVertex");
+    glFenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+    glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+    glDeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+}
+
+static void load_GL_VERSION_3_3(GLADloadproc load) {
+    glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)load("glVertexAttribDivisor");
+    glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+}
+
+/* Optional: only usable when the context reports 4.1 or newer (or
+   GL_NUM_PROGRAM_BINARY_FORMATS is nonzero) */
+static void load_GL_VERSION_4_1(GLADloadproc load) {
+    glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)load("glGetProgramBinary");
+    glProgramBinary = (PFNGLPROGRAMBINARYPROC)load("glProgramBinary");
+    glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+}
+
+/* Optional: only usable when the context reports 4.4 or newer */
+static void load_GL_VERSION_4_4(GLADloadproc load) {
+    glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
 }
 
 static void* glad_get_proc_from_userptr(void* userptr, const char *name) {
@@ -194,9 +273,15 @@ int gladLoadGLLoader(GLADloadproc load) {
     
     load_GL_VERSION_1_0(load);
     load_GL_VERSION_1_1(load);
+    load_GL_VERSION_1_4(load);
     load_GL_VERSION_1_5(load);
     load_GL_VERSION_2_0(load);
     load_GL_VERSION_3_0(load);
+    load_GL_VERSION_3_1(load);
+    load_GL_VERSION_3_2(load);
+    load_GL_VERSION_3_3(load);
+    load_GL_VERSION_4_1(load);
+    load_GL_VERSION_4_4(load);
     
     return GLVersion.major != 0 || GLVersion.minor != 0;
 }
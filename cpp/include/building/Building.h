@@ -29,6 +29,9 @@ public:
     int getHeight() const { return height; }
     float getBuildHeight() const { return buildHeight; }
     
+    // Light the building gives off at night (LightMap level, 0 = none)
+    int getLightLevel() const { return lightLevel; }
+    
     // Get colors for rendering
     glm::vec4 getTopColor() const { return topColor; }
     glm::vec4 getLeftColor() const { return leftColor; }
@@ -43,6 +46,7 @@ private:
     int width;
     int height;
     float buildHeight;
+    int lightLevel;
     glm::vec4 topColor;
     glm::vec4 leftColor;
     glm::vec4 rightColor;
@@ -10,6 +10,7 @@ class World;
 class Renderer;
 class IsometricRenderer;
 class Camera;
+class DrawList;
 
 /**
  * Building System
@@ -22,8 +23,8 @@ public:
     // Update buildings
     void update(float deltaTime);
     
-    // Render buildings
-    void render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera);
+    // Render buildings (queued in drawList, depth sorted with other objects)
+    void render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera, DrawList& drawList);
     
     // Place a building
     bool placeBuilding(int x, int y, BuildingType type);
@@ -47,7 +48,7 @@ private:
     // Check if tiles are available for building placement
     bool areTilesAvailable(int x, int y, int width, int height) const;
     
-    // Mark tiles as occupied/unoccupied
+    // Mark tiles as occupied/unoccupied (and as light blockers)
     void markTilesOccupied(int x, int y, int width, int height, bool occupied);
 };
 
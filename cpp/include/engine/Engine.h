@@ -4,11 +4,17 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <memory>
+#include <string>
+#include <vector>
 #include "Time.h"
 #include "Input.h"
+#include "JobSystem.h"
+#include "../rendering/DynamicResolution.h"
+#include "../rendering/RenderBackend.h"
 
 // Forward declarations
 class Renderer;
+class RenderBackend;
 class Camera;
 class Game;
 
@@ -27,6 +33,27 @@ public:
     // Run the main game loop
     void run();
     
+    // Headless mode: no window, GL context, input or renderer. Must be set
+    // before initialize(); the game is then driven with runHeadless().
+    void setHeadless(bool enabled) { headless = enabled; }
+    bool isHeadless() const { return headless; }
+    
+    // Headless only: optionally render every tick without a GPU
+    enum class HeadlessRendering {
+        None,       // Simulation only
+        Recording,  // Capture commands (CPU render cost, batch statistics)
+        Software    // Rasterize on the CPU (images, golden tests)
+    };
+    void setHeadlessRendering(HeadlessRendering mode) { headlessRendering = mode; }
+    
+    // Headless software rendering: write the final frame to this PNG
+    void setScreenshotPath(const std::string& path) { screenshotPath = path; }
+    
+    // Run Game::update back to back for maxTicks ticks or maxSeconds of wall
+    // time, whichever comes first (0 disables a limit), then log tick-time
+    // statistics. Returns the number of ticks simulated.
+    unsigned long long runHeadless(unsigned long long maxTicks, double maxSeconds);
+    
     // Shutdown the engine
     void shutdown();
     
@@ -37,7 +64,9 @@ public:
     Time* getTime() { return time.get(); }
     Input* getInput() { return input.get(); }
     Renderer* getRenderer() { return renderer.get(); }
+    RenderBackend* getRenderBackend() { return renderBackend.get(); }
     Camera* getCamera() { return camera.get(); }
+    JobSystem* getJobSystem() { return jobSystem.get(); }
     GLFWwindow* getWindow() { return window; }
     
     // Get window dimensions
@@ -47,22 +76,87 @@ public:
     // Set the game instance
     void setGame(Game* gameInstance) { this->game = gameInstance; }
     
+    // Fixed-timestep simulation settings
+    void setTickRate(float ticksPerSecond);
+    float getTickRate() const { return tickRate; }
+    float getFixedDeltaTime() const { return fixedDeltaTime; }
+    void setMaxCatchUpSteps(int steps) { maxCatchUpSteps = steps > 0 ? steps : 1; }
+    int getMaxCatchUpSteps() const { return maxCatchUpSteps; }
+    
+    // Fraction of a tick elapsed since the last simulation step (0..1),
+    // used to interpolate entity positions when rendering
+    float getInterpolationAlpha() const { return interpolationAlpha; }
+    
+    // Simulation statistics
+    unsigned long long getTickCount() const { return tickCount; }
+    unsigned long long getDroppedTickCount() const { return droppedTickCount; }
+    
+    // Dynamic resolution (off by default): the world is rendered offscreen
+    // at the controller's scale and stretched over the window; the UI is
+    // drawn afterwards at native resolution. Needs backend render targets.
+    DynamicResolution& getDynamicResolution() { return dynamicResolution; }
+    const DynamicResolution& getDynamicResolution() const { return dynamicResolution; }
+    
 private:
     // Window management
     GLFWwindow* window;
     int width;
     int height;
     const char* title;
+    bool headless;
+    HeadlessRendering headlessRendering;
+    std::string screenshotPath;
     
     // Core systems
     std::unique_ptr<Time> time;
     std::unique_ptr<Input> input;
+    std::unique_ptr<RenderBackend> renderBackend;
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<Camera> camera;
+    std::unique_ptr<JobSystem> jobSystem;
     
     // Game instance
     Game* game;
     
+    // Fixed-timestep state
+    float tickRate;             // Simulation ticks per second
+    float fixedDeltaTime;       // 1 / tickRate
+    int maxCatchUpSteps;        // Max ticks run in one frame before dropping time
+    double accumulator;         // Unsimulated time carried between frames
+    float interpolationAlpha;   // accumulator / fixedDeltaTime after stepping
+    unsigned long long tickCount;
+    unsigned long long droppedTickCount;
+    
+    // Dynamic resolution state; the scene target has the window's size and
+    // is drawn into a scaled viewport, so scale changes never reallocate it
+    DynamicResolution dynamicResolution;
+    RenderBackend::RenderTargetHandle sceneTarget;
+    glm::ivec2 sceneTargetSize;
+    
+    // Largest frame time fed into the accumulator (guards against long stalls)
+    static constexpr float MAX_FRAME_TIME = 0.25f;
+    static constexpr float DEFAULT_TICK_RATE = 30.0f;
+    static constexpr int DEFAULT_MAX_CATCH_UP_STEPS = 5;
+    
+    // Run as many fixed simulation steps as the accumulated time allows
+    void stepSimulation(float frameTime);
+    
+    // Summarize per-tick durations (milliseconds) collected by runHeadless()
+    void reportTickStatistics(std::vector<float>& tickTimes, double wallSeconds) const;
+    
+    // Summarize recorded render passes (headless render recording)
+    void reportRenderStatistics(std::vector<float>& renderTimes) const;
+    
+    // Log where dynamic resolution settled (when enabled)
+    void reportDynamicResolution() const;
+    
+    // Render one frame of the game through the current renderer
+    void renderFrame(float alpha);
+    
+    // Make sure the scene target matches the window; false (and dynamic
+    // resolution turned off) if the backend can't provide one
+    bool prepareSceneTarget();
+    
     // Initialize GLFW and create window
     bool initWindow();
     
@@ -30,10 +30,14 @@ public:
     glm::vec2 getMousePosition() const { return mousePosition; }
     glm::vec2 getMouseDelta() const { return mouseDelta; }
     
+    // Vertical scroll wheel movement since the last update (positive = away from the user)
+    float getScrollDelta() const { return scrollDelta; }
+    
     // Callbacks for GLFW
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
+    static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     
 private:
     GLFWwindow* window;
@@ -49,6 +53,7 @@ private:
     glm::vec2 mousePosition;
     glm::vec2 prevMousePosition;
     glm::vec2 mouseDelta;
+    float scrollDelta;
     
     static Input* instance;
 };
@@ -0,0 +1,118 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Job Counter
+ * Tracks outstanding jobs. A parent waits on the counter its children were
+ * submitted with; the counter reaches zero when all of them have finished.
+ */
+class JobCounter {
+public:
+    JobCounter() : value(0) {}
+
+    bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+    int getPending() const { return value.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> value;
+};
+
+/**
+ * Work-Stealing Job System
+ * Each worker owns a deque: it pushes and pops its own jobs at the back
+ * while idle workers steal from the front of other deques. Threads that
+ * wait on a counter keep executing that counter's jobs instead of blocking,
+ * so jobs may spawn and wait on child jobs freely. They skip unrelated
+ * jobs: a long job picked up while waiting (say a texture decode) would
+ * delay the wait well past the last of its own jobs.
+ *
+ * Jobs that must run on the main thread (anything touching the GL context)
+ * go through runOnMainThread() and are executed by pumpMainThreadJobs().
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+    // workerCount == 0 picks hardware_concurrency - 1 (at least one worker)
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    // Submit a job; counter (optional) is incremented now and decremented when it finishes
+    void run(Job job, JobCounter* counter = nullptr);
+
+    // Block until counter reaches zero, executing jobs submitted with it meanwhile
+    void wait(JobCounter& counter);
+
+    // Split [begin, end) into chunks of at most grainSize and run body(chunkBegin, chunkEnd)
+    // on the workers. Returns when every chunk has finished.
+    void parallelForChunks(size_t begin, size_t end, size_t grainSize, const RangeJob& body);
+
+    // Convenience: body(i) for every i in [begin, end)
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t)>& body);
+
+    // Queue a job for the main thread (GL uploads, window calls)
+    void runOnMainThread(Job job, JobCounter* counter = nullptr);
+
+    // Run queued main-thread jobs; call once per frame from the main thread.
+    // Returns the number of jobs executed.
+    size_t pumpMainThreadJobs(size_t maxJobs = static_cast<size_t>(-1));
+
+    // Thread queries
+    bool isMainThread() const { return std::this_thread::get_id() == mainThreadId; }
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    // Microbenchmark: compares job throughput against a single mutex-protected
+    // queue with the same number of workers and logs the results
+    static void runBenchmark(unsigned workerCount = 0, size_t jobCount = 200000);
+
+private:
+    struct QueuedJob {
+        Job function;
+        JobCounter* counter;
+    };
+
+    // One deque per thread slot; padded so neighbouring locks don't share a cache line
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // [0] = main/external threads, [i + 1] = worker i
+    std::thread::id mainThreadId;
+
+    // Sleeping support for idle workers
+    std::atomic<int> pendingJobs;
+    std::atomic<bool> stopping;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    // Main-thread affinity queue
+    std::mutex mainThreadMutex;
+    std::deque<QueuedJob> mainThreadJobs;
+
+    void workerLoop(unsigned queueIndex);
+
+    // Pop from own queue, otherwise steal from another; false if nothing was run.
+    // With a counter, only jobs submitted with it are taken.
+    bool tryRunOneJob(unsigned queueIndex, const JobCounter* only = nullptr);
+    bool popLocal(unsigned queueIndex, QueuedJob& out, const JobCounter* only);
+    bool steal(unsigned thiefIndex, QueuedJob& out, const JobCounter* only);
+    void execute(QueuedJob& job);
+
+    unsigned currentQueueIndex() const;
+};
+
+#endif // JOB_SYSTEM_H
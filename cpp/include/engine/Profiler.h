@@ -0,0 +1,171 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Compiled in by default (optimized builds are the ones worth profiling);
+// define PROFILER_ENABLED to 0 to strip every zone
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Profiler
+ * Scoped CPU timing zones. A zone records its name, start and end (in
+ * nanoseconds) into a ring buffer owned by the thread it ran on, so
+ * recording takes no lock and doesn't allocate after a thread's first
+ * zone. Once per frame the main thread collects every ring (endFrame()),
+ * summarizes the frame per zone and, while a trace is captured, keeps the
+ * events for a Chrome trace (chrome://tracing or ui.perfetto.dev).
+ *
+ * Off until setEnabled(true); a zone then costs one relaxed atomic load.
+ * Record through the PROFILE_* macros, which compile to nothing when
+ * PROFILER_ENABLED is 0. Zone names must outlive the profiler (string
+ * literals): only the pointer is stored.
+ */
+class Profiler {
+public:
+    // One zone name's share of a frame
+    struct ZoneStats {
+        const char* name;
+        uint32_t calls;
+        uint64_t totalNs; // Inclusive, summed over calls and threads
+        uint64_t maxNs;   // Longest single call
+    };
+    
+    struct FrameSummary {
+        uint64_t frame;      // Frames collected since enabled, from 1
+        uint64_t durationNs; // Since the previous endFrame()
+        std::vector<ZoneStats> zones; // Most total time first
+    };
+    
+    static Profiler& getInstance();
+    
+    // Enabling starts a fresh summary and drops zones recorded while off
+    void setEnabled(bool enabled);
+    static bool isActive() { return active.load(std::memory_order_relaxed); }
+    
+    // Nanoseconds on a steady clock
+    static uint64_t now();
+    
+    // Add a finished zone of the calling thread (see ProfileScope)
+    void record(const char* name, uint64_t start, uint64_t end);
+    
+    // Name the calling thread in traces
+    void setThreadName(const std::string& name);
+    
+    // Main thread, once per frame: collect the zones finished since the
+    // last call into the frame summary (and the trace)
+    void endFrame();
+    const FrameSummary& getLastFrame() const { return lastFrame; }
+    
+    // Keep collected events for writeChromeTrace(), up to MAX_TRACE_EVENTS
+    void setTraceCapture(bool capture) { traceCapture = capture; }
+    bool writeChromeTrace(const std::string& path) const;
+    
+    // Log each zone's average and worst time per frame since enabled
+    void logSummary() const;
+    
+private:
+    // Events each thread can record between two endFrame() calls; older
+    // ones are overwritten (and counted as dropped)
+    static constexpr size_t RING_CAPACITY = 16384;
+    static constexpr size_t MAX_TRACE_EVENTS = 2000000;
+    
+    struct Event {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+    
+    // Written only by its thread; read by the main thread in endFrame()
+    struct ThreadBuffer {
+        uint32_t id;
+        std::string name;
+        std::unique_ptr<Event[]> events; // RING_CAPACITY, indexed by count % capacity
+        std::atomic<uint64_t> written;   // Events recorded (published with release)
+        uint64_t collected;              // Events endFrame() has seen
+    };
+    
+    struct TraceEvent {
+        Event event;
+        uint32_t thread;
+    };
+    
+    // Per-zone totals across frames
+    struct ZoneTotals {
+        const char* name;
+        uint64_t calls;
+        uint64_t totalNs;
+        uint64_t maxFrameNs; // Most time in one frame
+    };
+    
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    
+    static std::atomic<bool> active;
+    static thread_local ThreadBuffer* localBuffer;
+    
+    // Registration (first zone of a thread) and collection
+    mutable std::mutex threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    
+    // Main thread only
+    uint64_t frameStart;
+    uint64_t droppedEvents;
+    FrameSummary lastFrame;
+    std::vector<ZoneTotals> totals;
+    bool traceCapture;
+    std::vector<TraceEvent> trace;
+    bool traceFullWarned;
+    std::vector<Event> copied; // One thread's new events, reused by endFrame()
+    
+    ThreadBuffer* registerThread();
+};
+
+/**
+ * Profile Scope
+ * Times the enclosing scope as a zone while the profiler is enabled.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* zoneName)
+        : name(Profiler::isActive() ? zoneName : nullptr)
+        , start(name ? Profiler::now() : 0)
+    {
+    }
+    
+    ~ProfileScope() {
+        if (name) {
+            Profiler::getInstance().record(name, start, Profiler::now());
+        }
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    
+private:
+    const char* name; // Null while the profiler is off
+    uint64_t start;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) Profiler::getInstance().setThreadName(name)
+#define PROFILE_END_FRAME() Profiler::getInstance().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
+
+#endif // PROFILER_H
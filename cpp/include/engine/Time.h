@@ -1,12 +1,42 @@
 #ifndef TIME_H
 #define TIME_H
 
+#include <cstddef>
+#include <vector>
+
 /**
  * Time Management System
- * Handles delta time and frame timing
+ * Handles delta time and frame timing.
+ * Backed by std::chrono::steady_clock so it works without a window (headless).
+ *
+ * Also keeps the last HISTORY_SIZE frame times, with the time each frame
+ * spent in its phases, for percentile statistics over rolling windows:
+ * an average hides stutter, the tail percentiles and hitch counts don't.
  */
 class Time {
 public:
+    // Parts of a frame timed separately (see recordPhase())
+    enum class Phase {
+        Simulation, // Fixed-step ticks run in the frame
+        Render,
+        Present,    // Buffer swap, including any wait for vsync
+        Count
+    };
+    
+    // Frames kept for statistics (over a minute at 60 fps)
+    static constexpr size_t HISTORY_SIZE = 4096;
+    
+    // Statistics of one series over a window, in milliseconds
+    struct FrameStats {
+        size_t frames;  // Frames in the window
+        float average;
+        float p50;
+        float p95;
+        float p99;
+        float max;
+        int hitches;    // Samples over the hitch threshold
+    };
+    
     Time();
     
     // Update time values each frame
@@ -21,16 +51,52 @@ public:
     // Get frames per second
     float getFPS() const { return fps; }
     
-    // Get current time in seconds (from glfwGetTime)
+    // Add time spent in a phase of the current frame (summed until the
+    // next update())
+    void recordPhase(Phase phase, float milliseconds);
+    
+    // Frame or phase times of the frames that ended in the last
+    // windowSeconds (as much of it as the history holds)
+    FrameStats getFrameStats(float windowSeconds) const;
+    FrameStats getPhaseStats(Phase phase, float windowSeconds) const;
+    
+    // Frames longer than this count as hitches (default: two 60 Hz frames)
+    void setHitchThreshold(float milliseconds) { hitchThreshold = milliseconds; }
+    float getHitchThreshold() const { return hitchThreshold; }
+    
+    // Log the statistics over the last 1, 10 and 60 seconds
+    void logFrameStats() const;
+    
+    static const char* getPhaseName(Phase phase);
+    
+    // Get current time in seconds since the process started (monotonic)
     static double getCurrentTime();
     
 private:
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::Count);
+    
+    struct FrameRecord {
+        float frameTime;               // Milliseconds
+        float phaseTimes[PHASE_COUNT]; // Milliseconds
+    };
+    
     float deltaTime;      // Time since last frame
     float totalTime;      // Total time since start
     double lastFrameTime; // Time of last frame
     float fps;            // Current FPS
     float fpsTimer;       // Timer for FPS calculation
     int frameCount;       // Frame counter for FPS
+    
+    std::vector<FrameRecord> history; // Ring of HISTORY_SIZE frames
+    size_t historyNext;               // Slot of the next frame
+    size_t historyCount;
+    FrameRecord current;              // Phases of the frame in progress
+    bool firstUpdate;                 // The first delta is startup, not a frame
+    float hitchThreshold;
+    mutable std::vector<float> sortScratch;
+    
+    // phaseIndex PHASE_COUNT selects the frame times
+    FrameStats computeStats(size_t phaseIndex, float windowSeconds) const;
 };
 
 #endif // TIME_H
@@ -2,6 +2,7 @@
 #define ENTITY_H
 
 #include <glm/glm.hpp>
+#include <cstdint>
 
 // Forward declarations
 class Renderer;
@@ -24,22 +25,38 @@ public:
     // Render entity
     virtual void render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera);
     
-    // Position
+    // Position; setPosition places the entity (no interpolation from the
+    // old position), movement goes through velocity and update()
     void setPosition(float x, float y);
     glm::vec2 getPosition() const { return position; }
     
+    // Fixed-timestep interpolation
+    // Call at the start of each simulation tick to remember the previous state
+    void savePreviousState() { previousPosition = position; }
+    glm::vec2 getPreviousPosition() const { return previousPosition; }
+    // Position blended between the previous and current tick (alpha in 0..1)
+    glm::vec2 getInterpolatedPosition(float alpha) const;
+    
     // Velocity
     void setVelocity(float vx, float vy);
     glm::vec2 getVelocity() const { return velocity; }
     
+    // Unique id (used as the key in spatial queries)
+    uint32_t getId() const { return id; }
+    
     // Active state
     void setActive(bool isActive) { this->active = isActive; }
     bool isActive() const { return active; }
     
 protected:
+    uint32_t id;
     glm::vec2 position;
+    glm::vec2 previousPosition;
     glm::vec2 velocity;
     bool active;
+    
+private:
+    static uint32_t nextId;
 };
 
 #endif // ENTITY_H
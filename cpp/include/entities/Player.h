@@ -26,6 +26,7 @@ public:
     
     // Interaction
     bool interact(float targetX, float targetY, World* world);
+    bool gatherNearest(World* world);  // Interact with the closest resource in range
     
     // Inventory
     int getWood() const { return inventory.at("wood"); }
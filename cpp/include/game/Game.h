@@ -1,14 +1,23 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <cstddef>
 #include <memory>
+#include <vector>
+#include "../rendering/DrawList.h"
 
 // Forward declarations
 class Engine;
 class World;
 class BuildingSystem;
-class Entity;
+class Player;
 class TextureManager;
+class SpatialHash;
+class BatchRenderer;
+class UIRenderer;
+class UICanvas;
+class UIPanel;
+class UILabel;
 
 /**
  * Main Game Class
@@ -22,18 +31,27 @@ public:
     // Initialize game
     bool initialize();
     
-    // Update game logic
+    // Update game logic (one fixed simulation tick)
     void update(float deltaTime);
     
-    // Render game
-    void render();
+    // Render game; alpha blends entity positions between the last two ticks
+    void render(float alpha = 1.0f);
     
-    // Handle input
+    // Render the UI over the finished frame, in window pixels (origin top-left)
+    void renderUI();
+    
+    // Handle input (once per rendered frame)
     void handleInput(float deltaTime);
     
     // Shutdown game
     void shutdown();
     
+    // Texture memory budget in bytes (0 = unlimited); set before initialize()
+    void setTextureBudget(size_t bytes) { textureBudget = bytes; }
+    
+    // Spatial index of active entities (for perception/proximity queries)
+    const SpatialHash* getEntityIndex() const { return entityIndex.get(); }
+    
 private:
     Engine* engine;
     
@@ -41,17 +59,40 @@ private:
     std::unique_ptr<TextureManager> textureManager;
     std::unique_ptr<World> world;
     std::unique_ptr<BuildingSystem> buildingSystem;
-    std::unique_ptr<Entity> player;
+    std::unique_ptr<Player> player;
+    std::unique_ptr<SpatialHash> entityIndex;
+    
+    // Depth-sorted objects of the current frame, drawn through the batcher
+    std::unique_ptr<BatchRenderer> batchRenderer;
+    DrawList drawList;
+    
+    // HUD: retained, rebuilt only when the building mode state changes
+    std::unique_ptr<UIRenderer> uiRenderer;
+    std::unique_ptr<UICanvas> hud;
+    UIPanel* buildPanel; // Owned by the hud
+    UILabel* buildLabel;
+    
+    // World view-projection of the last render, for the debug overlay
+    glm::mat4 worldViewProjection;
+    
+    size_t textureBudget;
     
     // Game state
     bool buildingMode;
     int selectedBuildingType;
+    bool showFrameGraph;
+    std::vector<float> frameGraphScratch;
     
     // Camera control
     void updateCamera(float deltaTime);
     
     // Building mode
     void updateBuildingMode();
+    
+    // HUD
+    void createHud();
+    void updateHud();
+    void renderFrameGraph();
 };
 
 #endif // GAME_H
@@ -0,0 +1,83 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Cooked Asset Pack
+ * One file holding textures ready for upload: RGBA8, bottom row first (as
+ * Texture expects), with the full mip chain precomputed. The runtime maps
+ * the file into memory and uploads straight from the mapping, so no PNG is
+ * decoded and no pixel is copied on the CPU.
+ *
+ * Entries are keyed by source path. Each records the source's size and
+ * modification time (checked at runtime: a changed source is treated as a
+ * miss and decoded as usual) and a hash of its contents (checked when
+ * cooking: unchanged sources reuse their cooked data).
+ *
+ * Layout: Header | entry table | path strings | pixel data (16-byte aligned)
+ */
+class AssetPack {
+public:
+    // Where --cook-assets writes and the game looks by default
+    static constexpr const char* DEFAULT_PATH = "cache/assets.pack";
+    
+    struct Entry {
+        uint64_t sourceHash;   // FNV-1a of the source file's bytes
+        uint64_t sourceSize;
+        int64_t sourceTime;    // Last write time, file clock ticks
+        uint32_t width;
+        uint32_t height;
+        uint32_t levels;       // Mip levels stored, level 0 first
+        uint32_t pathOffset;   // Into the path strings
+        uint32_t pathLength;
+        uint32_t reserved;
+        uint64_t dataOffset;   // From the start of the file
+        uint64_t dataSize;
+    };
+    
+    AssetPack();
+    ~AssetPack();
+    
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    
+    // Map a pack; false (and closed) if missing or invalid
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapped != nullptr; }
+    
+    // Entry for a source path, or null when absent or stale
+    const Entry* find(const std::string& sourcePath) const;
+    
+    // Mapped pixels of one mip level (RGBA8, bottom row first)
+    const uint8_t* getLevel(const Entry& entry, uint32_t level) const;
+    
+    size_t getEntryCount() const { return entryCount; }
+    
+    // Size in bytes of a full RGBA8 mip chain down to 1x1
+    static size_t mipChainSize(uint32_t width, uint32_t height, uint32_t* levels = nullptr);
+    
+    // Cook source images into a pack at outputPath, reusing entries of an
+    // existing pack there whose sources haven't changed
+    static bool cook(const std::vector<std::string>& sourcePaths, const std::string& outputPath);
+    
+private:
+    const uint8_t* mapped;
+    size_t mappedSize;
+    void* fileHandle;    // Platform handles of the mapping
+    void* mappingHandle;
+    
+    const Entry* entries;
+    size_t entryCount;
+    const char* paths;
+    std::unordered_map<std::string, size_t> entryIndex; // Source path -> entry
+    
+    std::string getPath(const Entry& entry) const;
+};
+
+#endif // ASSET_PACK_H
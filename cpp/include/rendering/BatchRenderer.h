@@ -1,20 +1,26 @@
 #ifndef BATCH_RENDERER_H
 #define BATCH_RENDERER_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
-#include <memory>
-#include "Shader.h"
+#include "RenderBackend.h"
 #include "Texture.h"
 
 /**
  * Batch Renderer for efficient sprite rendering
- * Batches multiple sprites into a single draw call for better performance
+ * Batches multiple sprites into a single draw call for better performance.
+ * Batches are submitted through a RenderBackend.
+ *
+ * When the backend supports instancing, unrotated quads are submitted as
+ * 20-byte SpriteInstances instead of four QuadVertex (160 bytes); each
+ * distinct size/texture region is interned once in a sprite rect table.
+ * Rotated quads, and every quad on other backends, use the vertex path.
  */
 class BatchRenderer {
 public:
-    BatchRenderer();
+    explicit BatchRenderer(RenderBackend* backend);
     ~BatchRenderer();
     
     // Initialize the batch renderer
@@ -43,29 +49,60 @@ public:
     void setViewMatrix(const glm::mat4& view);
     void setProjectionMatrix(const glm::mat4& projection);
     
+    // Use instancing when the backend has it (default); false forces quads
+    void setInstancingEnabled(bool enabled);
+    bool isInstancing() const { return instancing; }
+    
     // Get statistics
     size_t getDrawCallCount() const { return drawCallCount; }
     size_t getQuadCount() const { return quadCount; }
+    size_t getInstancedQuadCount() const { return instancedQuadCount; }
     void resetStatistics();
     
-private:
-    struct Vertex {
-        glm::vec3 position;
-        glm::vec4 color;
-        glm::vec2 texCoord;
-        float texIndex;
-    };
+    // Time submitting spriteCount sprites through both paths (no GPU needed)
+    static void runBenchmark(size_t spriteCount = 200000, int iterations = 20);
     
-    // Rendering resources
-    GLuint VAO, VBO, EBO;
-    std::unique_ptr<Shader> shader;
+    // Most entries in the sprite rect table before it starts over (half of
+    // GL's minimum texture buffer size, two texels per rect)
+    static constexpr size_t MAX_SPRITE_RECTS = 32768;
+    
+private:
+    RenderBackend* backend; // Not owned by BatchRenderer
     
     // Batch data
-    std::vector<Vertex> vertices;
+    std::vector<QuadVertex> vertices;
     std::vector<const Texture*> textures;
     size_t maxQuads;
     size_t currentQuadCount;
     
+    // Instanced path: pending sprites and the interned rect table
+    struct RectHash {
+        size_t operator()(const SpriteRect& rect) const;
+    };
+    struct RectEqual {
+        bool operator()(const SpriteRect& a, const SpriteRect& b) const;
+    };
+    bool instancing;
+    std::vector<SpriteInstance> instances;
+    std::vector<SpriteRect> spriteRects;
+    std::unordered_map<SpriteRect, uint16_t, RectHash, RectEqual> rectLookup;
+    size_t uploadedRectCount; // Table entries the backend has
+    
+    // Direct-mapped cache of texture + rect -> rect index and texture slot
+    // in front of both lookups. A frame uses few combinations, so sprites
+    // almost always hit, and a hit is a compare in drawQuad whatever the
+    // order: a previous-sprite shortcut mispredicts on every change.
+    struct SpriteKey {
+        const Texture* texture;
+        SpriteRect rect;
+        uint32_t batch;   // Slots are valid for one batch (batchNumber)
+        uint16_t rectIndex;
+        uint16_t texSlot;
+    };
+    static constexpr size_t SPRITE_CACHE_SIZE = 64;
+    SpriteKey spriteCache[SPRITE_CACHE_SIZE];
+    uint32_t batchNumber; // Advances whenever the texture slots are reset
+    
     // Matrices
     glm::mat4 viewMatrix;
     glm::mat4 projectionMatrix;
@@ -73,11 +110,14 @@ private:
     // Statistics
     size_t drawCallCount;
     size_t quadCount;
+    size_t instancedQuadCount;
     
     // Helper methods
-    void setupBuffers();
-    bool createBatchShader();
     float getTextureIndex(const Texture* texture);
+    uint16_t getSpriteRect(const SpriteRect& rect);
+    static size_t spriteCacheIndex(const Texture* texture, const glm::vec2& texCoordMin);
+    void cacheSprite(SpriteKey& sprite, const Texture* texture, const SpriteRect& rect);
+    static uint32_t packColor(const glm::vec4& color);
 };
 
 #endif // BATCH_RENDERER_H
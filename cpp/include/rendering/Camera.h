@@ -6,7 +6,8 @@
 
 /**
  * 2D Camera System
- * Handles viewport positioning for the game world
+ * Handles viewport positioning for the game world. Zoom scales world units
+ * to screen pixels (1 = one unit per pixel, below 1 shows more of the world).
  */
 class Camera {
 public:
@@ -22,6 +23,15 @@ public:
     float getX() const { return position.x; }
     float getY() const { return position.y; }
     
+    // Zoom, clamped to [MIN_ZOOM, MAX_ZOOM]
+    static constexpr float MIN_ZOOM = 0.1f;
+    static constexpr float MAX_ZOOM = 4.0f;
+    void setZoom(float newZoom);
+    float getZoom() const { return zoom; }
+    
+    // Multiply the zoom, keeping the world point under a screen position fixed
+    void zoomAt(float factor, const glm::vec2& screenPos, float screenWidth, float screenHeight);
+    
     // Camera speed
     void setSpeed(float newSpeed) { this->speed = newSpeed; }
     float getSpeed() const { return speed; }
@@ -40,6 +50,7 @@ public:
     
 private:
     glm::vec2 position;
+    float zoom;
     float speed;
 };
 
@@ -0,0 +1,119 @@
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+// Compiled in unless NDEBUG (release builds); define DEBUG_DRAW_ENABLED
+// to 0 or 1 to override
+#ifndef DEBUG_DRAW_ENABLED
+#ifdef NDEBUG
+#define DEBUG_DRAW_ENABLED 0
+#else
+#define DEBUG_DRAW_ENABLED 1
+#endif
+#endif
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class UIRenderer;
+
+/**
+ * Debug Draw
+ * Immediate-mode overlay for visualizing engine state. Primitives are
+ * recorded in world space during the frame (main thread only) and flushed
+ * into the UI's primitive stream, projected to window pixels: the whole
+ * overlay shares one batched draw with the frame's other immediate UI, and
+ * lines keep their width at every zoom level.
+ *
+ * Each primitive belongs to a category toggled at runtime (all start
+ * off); recording into a disabled category is a single branch. Record
+ * through the DEBUG_DRAW_* macros, which compile to nothing - arguments
+ * included - when DEBUG_DRAW_ENABLED is 0.
+ */
+class DebugDraw {
+public:
+    enum class Category : uint32_t {
+        General,
+        Chunks,      // Chunk bounds and cache state
+        SpatialHash, // Occupied entity index cells
+        Entities,    // Entity positions
+        Count
+    };
+    
+    static DebugDraw& getInstance();
+    
+    void setEnabled(Category category, bool enabled);
+    void toggle(Category category) { setEnabled(category, !isEnabled(category)); }
+    bool isEnabled(Category category) const { return (enabledMask & bit(category)) != 0; }
+    static const char* getCategoryName(Category category);
+    
+    // World-space primitives
+    void line(Category category, const glm::vec2& from, const glm::vec2& to, const glm::vec4& color);
+    void circle(Category category, const glm::vec2& center, float radius, const glm::vec4& color);
+    // Outline of the isometric tiles min..max (grid coordinates, inclusive)
+    void tileOutline(Category category, const glm::ivec2& min, const glm::ivec2& max, const glm::vec4& color);
+    void text(Category category, const glm::vec2& position, const std::string& text, const glm::vec3& color);
+    
+    // Text in window pixels (origin top-left)
+    void screenText(Category category, const glm::vec2& position, const std::string& text, const glm::vec3& color);
+    
+    // Tile size tileOutline() converts grid coordinates with
+    void setTileSize(int width, int height);
+    
+    // Project everything recorded since the last flush with the world
+    // view-projection and add it to the UI's current frame (between its
+    // beginFrame() and endFrame()), then start over
+    void flush(UIRenderer& ui, const glm::mat4& worldViewProjection);
+    
+    // Primitives recorded since the last flush
+    size_t getPrimitiveCount() const { return lines.size() + texts.size(); }
+    
+private:
+    DebugDraw();
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+    
+    static uint32_t bit(Category category) { return 1u << static_cast<uint32_t>(category); }
+    
+    static constexpr int CIRCLE_SEGMENTS = 24;
+    static constexpr float LINE_WIDTH = 2.0f; // Window pixels
+    
+    struct Line {
+        glm::vec2 from;
+        glm::vec2 to;
+        glm::vec4 color;
+    };
+    
+    struct Text {
+        glm::vec2 position;
+        std::string text;
+        glm::vec3 color;
+        bool screenSpace;
+    };
+    
+    uint32_t enabledMask;
+    int tileWidth;
+    int tileHeight;
+    std::vector<Line> lines;
+    std::vector<Text> texts;
+};
+
+#if DEBUG_DRAW_ENABLED
+#define DEBUG_DRAW_ON(category) DebugDraw::getInstance().isEnabled(DebugDraw::Category::category)
+#define DEBUG_DRAW_LINE(category, ...) DebugDraw::getInstance().line(DebugDraw::Category::category, __VA_ARGS__)
+#define DEBUG_DRAW_CIRCLE(category, ...) DebugDraw::getInstance().circle(DebugDraw::Category::category, __VA_ARGS__)
+#define DEBUG_DRAW_TILES(category, ...) DebugDraw::getInstance().tileOutline(DebugDraw::Category::category, __VA_ARGS__)
+#define DEBUG_DRAW_TEXT(category, ...) DebugDraw::getInstance().text(DebugDraw::Category::category, __VA_ARGS__)
+#define DEBUG_DRAW_SCREEN_TEXT(category, ...) DebugDraw::getInstance().screenText(DebugDraw::Category::category, __VA_ARGS__)
+#else
+#define DEBUG_DRAW_ON(category) false
+#define DEBUG_DRAW_LINE(category, ...) ((void)0)
+#define DEBUG_DRAW_CIRCLE(category, ...) ((void)0)
+#define DEBUG_DRAW_TILES(category, ...) ((void)0)
+#define DEBUG_DRAW_TEXT(category, ...) ((void)0)
+#define DEBUG_DRAW_SCREEN_TEXT(category, ...) ((void)0)
+#endif
+
+#endif // DEBUG_DRAW_H
@@ -47,10 +47,32 @@ public:
     void enableBlending(bool enable) override;
     void setBlendMode(int srcFactor, int dstFactor) override;
     
+    void setViewProjection(const glm::mat4& view, const glm::mat4& projection) override;
+    void bindTexture(int slot, const Texture* texture) override;
+    void drawQuads(const QuadVertex* vertices, size_t quadCount) override;
+    
+    GeometryHandle createStaticGeometry(const QuadVertex* vertices, size_t quadCount) override;
+    bool updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) override;
+    void destroyStaticGeometry(GeometryHandle handle) override;
+    void drawStaticGeometry(GeometryHandle handle) override;
+    
+    bool supportsInstancing() const override;
+    void setSpriteRects(const SpriteRect* rects, size_t rectCount) override;
+    void drawSprites(const SpriteInstance* instances, size_t instanceCount) override;
+    
+    bool supportsRenderTargets() const override;
+    RenderTargetHandle createRenderTarget(int width, int height) override;
+    void destroyRenderTarget(RenderTargetHandle handle) override;
+    void setRenderTarget(RenderTargetHandle handle) override;
+    RenderTargetHandle getRenderTarget() const override { return INVALID_TARGET; }
+    const Texture* getRenderTargetTexture(RenderTargetHandle handle) const override;
+    
+    float getGpuFrameTime() const override { return 0.0f; }
+    
     const char* getName() const override;
     const char* getVersion() const override;
     RenderBackendType getType() const override;
-    
+
 #ifdef DIRECTX_AVAILABLE
     // DirectX-specific methods
     ID3D11Device* getDevice() const { return device.Get(); }
@@ -60,7 +82,7 @@ public:
 
 private:
     bool initialized;
-    
+
 #ifdef DIRECTX_AVAILABLE
     // DirectX 11 resources
     ComPtr<ID3D11Device> device;
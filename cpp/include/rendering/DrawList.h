@@ -0,0 +1,117 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Texture;
+class BatchRenderer;
+
+/**
+ * Sorted Sprite Draw List
+ * Collects a frame's sprites with a packed 64-bit sort key and submits them
+ * to a BatchRenderer in key order:
+ *
+ *   bits 63..60  layer
+ *   bits 59..40  isometric depth (IsometricUtils::getRenderOrder, biased)
+ *   bits 39..24  texture key (groups equal-depth sprites by texture)
+ *   bits 23..0   submission index
+ *
+ * The submission index makes keys unique, so equal layer/depth/texture
+ * sprites keep their submission order (multi-quad sprites stay intact).
+ * Before sorting, the fields are repacked densely using the ranges seen
+ * this frame (a frame's depths span a few thousand values, texture ids are
+ * small), which usually leaves ~20 bits: two passes of an 11-bit LSD radix
+ * sort. The sort produces sprite indices, and once the digits left and the
+ * index fit in 4 bytes the passes move 4-byte elements instead of keys.
+ *
+ * Consecutive frames mostly submit the same sprites in the same order, so
+ * the sort first checks whether last frame's order still sorts the keys
+ * (reads only), falling back to the radix sort when anything moved.
+ */
+class DrawList {
+public:
+    // Coarse ordering; everything in a layer is depth sorted
+    enum class Layer : uint8_t {
+        Ground = 0,   // Flat things on the ground (shadows, markers)
+        Objects = 1,  // Decorations, buildings, entities
+        Overlay = 2   // Always on top (previews, highlights)
+    };
+    
+    struct Sprite {
+        glm::vec2 position;
+        glm::vec2 size;
+        glm::vec4 color;
+        glm::vec2 texCoordMin;
+        glm::vec2 texCoordMax;
+        const Texture* texture; // Null = untextured
+    };
+    
+    DrawList();
+    
+    // Drop all sprites (keeps capacity)
+    void clear();
+    void reserve(size_t spriteCount);
+    
+    // Add a sprite; higher depth draws later within a layer
+    void add(
+        Layer layer,
+        int depth,
+        const glm::vec2& position,
+        const glm::vec2& size,
+        const Texture* texture,
+        const glm::vec4& color = glm::vec4(1.0f),
+        const glm::vec2& texCoordMin = glm::vec2(0.0f, 0.0f),
+        const glm::vec2& texCoordMax = glm::vec2(1.0f, 1.0f)
+    );
+    
+    // Sort by key (no-op when already sorted)
+    void sort();
+    
+    // Sort if needed and draw every sprite through the batcher, in order
+    void submit(BatchRenderer& batchRenderer);
+    
+    size_t size() const { return sprites.size(); }
+    bool empty() const { return sprites.empty(); }
+    
+    // Sprite at a position of the sorted order (call sort() first)
+    const Sprite& getSorted(size_t index) const { return sprites[order[index]]; }
+    
+    // Sort key without the submission index
+    static uint64_t makeSortKey(Layer layer, int depth, uint32_t textureKey);
+    
+    // Most sprites one list can hold (the index field is 24 bits)
+    static constexpr size_t MAX_SPRITES = size_t(1) << 24;
+    
+    // Time sorting spriteCount random sprites (cold, and again as an
+    // unchanged frame) against std::sort
+    static void runBenchmark(size_t spriteCount = 200000, int iterations = 50);
+    
+private:
+    static constexpr uint64_t INDEX_MASK = (uint64_t(1) << 24) - 1;
+    
+    std::vector<Sprite> sprites;
+    std::vector<uint64_t> keys;         // Sort key | index into sprites
+    std::vector<uint64_t> scratch;      // Radix sort ping-pong buffer (8-byte passes)
+    std::vector<uint32_t> order;        // Sprite indices in sorted (or last sort's) order
+    std::vector<uint32_t> orderScratch; // Radix sort ping-pong buffer (4-byte passes)
+    bool sorted;
+    bool overflowWarned;
+    
+    // Field ranges of the keys added since clear(), for repacking
+    uint32_t minDepth;
+    uint32_t maxDepth;
+    uint32_t maxLayer;
+    uint32_t textureBits; // OR of all texture keys
+    
+    // True if last sort's order still sorts the keys
+    bool tryPreviousOrder();
+    
+    // Repack the keys' fields to the given widths and LSD radix sort them
+    // into order (stable: equal keys keep their index order). May
+    // overwrite keys.
+    void radixSort(int layerWidth, int depthWidth, int textureWidth);
+};
+
+#endif // DRAW_LIST_H
@@ -0,0 +1,89 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Dynamic Resolution Controller
+ * Picks the fraction of the window resolution the world is rendered at so
+ * that the measured render time stays near a target. Pixel cost grows with
+ * the area (scale squared), so a frame over budget shrinks the scale by
+ * sqrt(target / measured); headroom grows it back in small steps. Render
+ * times are smoothed and changes spaced ADJUST_INTERVAL frames apart (GPU
+ * timings arrive a few frames late), so one spike doesn't cause a visible
+ * resolution jump.
+ */
+class DynamicResolution {
+public:
+    DynamicResolution();
+    
+    // Off by default; enabling starts at full resolution
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+    
+    // Render time to aim for, in milliseconds
+    void setTargetFrameTime(float milliseconds);
+    float getTargetFrameTime() const { return targetFrameTime; }
+    
+    // Limits of the scale (fraction of the window size per axis)
+    void setScaleRange(float minScale, float maxScale);
+    
+    // Record a finished frame: its total frame time (history only) and the
+    // render time the controller steers by, both in milliseconds. Returns
+    // true when the scale changed.
+    bool update(float frameTime, float renderTime);
+    
+    float getScale() const { return scale; }
+    
+    // Size to render at for a window size (at least 1x1)
+    glm::ivec2 getRenderSize(int width, int height) const;
+    
+    // The last HISTORY_SIZE frame times and scales, oldest first
+    static constexpr size_t HISTORY_SIZE = 240;
+    void getFrameTimeHistory(std::vector<float>& out) const;
+    void getScaleHistory(std::vector<float>& out) const;
+    
+    // Summary over the history
+    struct Stats {
+        float scale;
+        float minScale;          // Lowest scale in the history
+        float targetFrameTime;
+        float averageFrameTime;
+        float maxFrameTime;
+        float averageRenderTime;
+        unsigned long long scaleChanges; // Since enabled
+    };
+    Stats getStats() const;
+    
+private:
+    // Weight of the newest frame in the smoothed render time
+    static constexpr float SMOOTHING = 0.1f;
+    // Frames between scale changes
+    static constexpr int ADJUST_INTERVAL = 15;
+    // Smoothed render time over target * OVER_BUDGET shrinks the scale,
+    // under target * UNDER_BUDGET grows it by GROW_STEP
+    static constexpr float OVER_BUDGET = 1.05f;
+    static constexpr float UNDER_BUDGET = 0.85f;
+    static constexpr float GROW_STEP = 0.05f;
+    
+    bool enabled;
+    float targetFrameTime;
+    float minScale;
+    float maxScale;
+    float scale;
+    float smoothedRenderTime; // 0 until the first frame
+    int framesSinceChange;
+    unsigned long long scaleChanges;
+    
+    // Ring buffers, next write at historyNext
+    std::vector<float> frameTimes;
+    std::vector<float> renderTimes;
+    std::vector<float> scales;
+    size_t historyNext;
+    
+    void copyHistory(const std::vector<float>& ring, std::vector<float>& out) const;
+};
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -5,6 +5,8 @@
 #include "Renderer.h"
 #include "Camera.h"
 
+class DrawList;
+
 /**
  * Isometric Rendering System
  * Specialized renderer for isometric tile-based graphics
@@ -51,6 +53,18 @@ public:
         const glm::vec4& rightColor
     );
     
+    // Queue an isometric cube into a draw list, depth sorted at the tile center.
+    // Below LOW_DETAIL_TILE_PIXELS of on-screen tile width it is one quad.
+    static constexpr float LOW_DETAIL_TILE_PIXELS = 16.0f;
+    void addIsometricCube(
+        DrawList& drawList,
+        int gridX, int gridY,
+        float height,
+        const glm::vec4& topColor,
+        const glm::vec4& leftColor,
+        const glm::vec4& rightColor
+    );
+    
     // Convert grid coordinates to screen position
     glm::vec2 gridToScreen(int gridX, int gridY) const;
     glm::vec2 tileToScreen(float x, float y) const; // For float positions (entities)
@@ -2,7 +2,13 @@
 #define OPENGL_BACKEND_H
 
 #include "RenderBackend.h"
+#include "Framebuffer.h"
+#include "ShaderLibrary.h"
+#include "StreamBuffer.h"
 #include <glad/glad.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 /**
  * OpenGL Rendering Backend Implementation
@@ -27,6 +33,28 @@ public:
     void enableBlending(bool enable) override;
     void setBlendMode(int srcFactor, int dstFactor) override;
     
+    void setViewProjection(const glm::mat4& view, const glm::mat4& projection) override;
+    void bindTexture(int slot, const Texture* texture) override;
+    void drawQuads(const QuadVertex* vertices, size_t quadCount) override;
+    
+    GeometryHandle createStaticGeometry(const QuadVertex* vertices, size_t quadCount) override;
+    bool updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) override;
+    void destroyStaticGeometry(GeometryHandle handle) override;
+    void drawStaticGeometry(GeometryHandle handle) override;
+    
+    bool supportsInstancing() const override;
+    void setSpriteRects(const SpriteRect* rects, size_t rectCount) override;
+    void drawSprites(const SpriteInstance* instances, size_t instanceCount) override;
+    
+    bool supportsRenderTargets() const override;
+    RenderTargetHandle createRenderTarget(int width, int height) override;
+    void destroyRenderTarget(RenderTargetHandle handle) override;
+    void setRenderTarget(RenderTargetHandle handle) override;
+    RenderTargetHandle getRenderTarget() const override { return currentRenderTarget; }
+    const Texture* getRenderTargetTexture(RenderTargetHandle handle) const override;
+    
+    float getGpuFrameTime() const override { return gpuFrameTime; }
+    
     const char* getName() const override;
     const char* getVersion() const override;
     RenderBackendType getType() const override;
@@ -34,6 +62,76 @@ public:
 private:
     bool initialized;
     std::string versionString;
+    
+    // Quad pipeline: one shader for all 2D draws. Quad vertices and sprite
+    // instances are streamed through one ring buffer; each draw addresses
+    // its slice with a base vertex / attribute offset.
+    static constexpr size_t MAX_QUADS_PER_DRAW = 10000;
+    static constexpr size_t VERTEX_STREAM_REGION = 4 * 1024 * 1024;
+    Shader* quadShader; // Owned by shaderLibrary
+    GLuint VAO, EBO;
+    std::unique_ptr<StreamBuffer> vertexStream;
+    
+    // Backend shaders; the library also owns the view/projection uniform buffer
+    ShaderLibrary shaderLibrary;
+    
+    // Texture ids currently bound per slot (skips redundant binds)
+    GLuint boundTextures[MAX_TEXTURE_SLOTS];
+    
+    // 1x1 white, bound in place of missing or evicted textures so quads
+    // that still reference their slot show the vertex color, not black
+    GLuint fallbackTexture;
+    
+    // Static geometry: one VAO/VBO per handle, sharing the quad index buffer
+    struct StaticGeometry {
+        GLuint vao;
+        GLuint vbo;
+        size_t quadCount;
+        size_t capacity; // Quads the VBO can hold without reallocating
+    };
+    std::unordered_map<GeometryHandle, StaticGeometry> staticGeometry;
+    GeometryHandle nextGeometryHandle;
+    
+    // Instanced sprite pipeline (null shader = instancing unavailable). The
+    // rect table is a texture buffer of two RGBA32F texels per rect, read on
+    // the texture unit after the quad slots.
+    static constexpr size_t MAX_SPRITES_PER_DRAW = 16384;
+    static constexpr int SPRITE_RECT_UNIT = MAX_TEXTURE_SLOTS;
+    Shader* spriteShader; // Owned by shaderLibrary
+    GLuint spriteVAO;
+    GLuint rectBuffer, rectTexture;
+    std::vector<glm::vec4> rectTexels; // Upload scratch
+    
+    // Offscreen render targets; the screen viewport is saved on entering one
+    struct RenderTarget {
+        std::unique_ptr<Framebuffer> framebuffer;
+        GLint viewport[4];
+    };
+    std::unordered_map<RenderTargetHandle, RenderTarget> renderTargets;
+    RenderTargetHandle nextRenderTarget;
+    RenderTargetHandle currentRenderTarget;
+    GLint screenViewport[4];
+    
+    // GPU frame timing: a ring of GL_TIME_ELAPSED queries, one per frame,
+    // read back once available so the CPU never waits on them
+    static constexpr int GPU_TIMER_QUERIES = 4;
+    GLuint gpuTimerQueries[GPU_TIMER_QUERIES];
+    uint64_t gpuTimerIssued;  // Frames whose query was started
+    uint64_t gpuTimerRead;    // Frames whose result was read or dropped
+    float gpuFrameTime;
+    
+    bool createStreams();
+    void destroyStreams();
+    bool createQuadPipeline();
+    void destroyQuadPipeline();
+    bool createSpritePipeline();
+    void destroySpritePipeline();
+    // Point the vertex attributes of the bound VAO at the bound QuadVertex buffer
+    void setupQuadVertexAttributes();
+    // Point the per-instance attributes of the bound VAO at offset in the bound buffer
+    void setupSpriteAttributes(size_t offset);
+    // Bind sampler textures[i] to texture unit i
+    static void setTextureSlots(const Shader& shader);
 };
 
 #endif // OPENGL_BACKEND_H
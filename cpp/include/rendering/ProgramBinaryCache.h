@@ -0,0 +1,46 @@
+#ifndef PROGRAM_BINARY_CACHE_H
+#define PROGRAM_BINARY_CACHE_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+class Shader;
+
+/**
+ * Program Binary Cache
+ * Keeps linked shader programs on disk (one file per program) so later
+ * launches can skip GLSL compilation. Entries are keyed by a hash of both
+ * shader sources and the driver string (vendor, renderer, version); a file
+ * written by another driver, or one the driver refuses, is ignored and
+ * replaced after compiling from source.
+ *
+ * Needs a current GL context that reports at least one program binary
+ * format (GL 4.1 or ARB_get_program_binary); otherwise it stays disabled.
+ */
+class ProgramBinaryCache {
+public:
+    explicit ProgramBinaryCache(const std::string& directory);
+    
+    // Query driver support and identity; false if binaries are unavailable
+    bool initialize();
+    bool isEnabled() const { return enabled; }
+    
+    // Cache key for a program built from these sources on this driver
+    uint64_t makeKey(const char* vertexSource, const char* fragmentSource) const;
+    
+    // Load the cached binary for key into shader (false = compile instead)
+    bool load(uint64_t key, Shader& shader) const;
+    
+    // Save a linked program (built with setBinaryRetrievable) under key
+    bool store(uint64_t key, const Shader& shader) const;
+    
+private:
+    std::string directory;
+    std::string driver; // Vendor | renderer | version of the current context
+    bool enabled;
+    
+    std::string pathFor(uint64_t key) const;
+};
+
+#endif // PROGRAM_BINARY_CACHE_H
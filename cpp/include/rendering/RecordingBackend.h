@@ -0,0 +1,191 @@
+#ifndef RECORDING_BACKEND_H
+#define RECORDING_BACKEND_H
+
+#include "RenderBackend.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Recording Rendering Backend
+ * Captures the command stream (state changes, texture binds, quad draws)
+ * into memory instead of talking to a GPU. Used to measure CPU-side render
+ * cost and batch efficiency headless, to inspect what a frame submitted,
+ * and to replay a captured frame into another backend.
+ */
+class RecordingBackend : public RenderBackend {
+public:
+    enum class CommandType : uint8_t {
+        BeginFrame,
+        EndFrame,
+        Clear,
+        ClearDepth,
+        SetViewport,
+        EnableDepthTest,
+        EnableBlending,
+        SetBlendMode,
+        SetViewProjection,
+        BindTexture,
+        DrawQuads,
+        CreateGeometry,
+        UpdateGeometry,
+        DestroyGeometry,
+        DrawGeometry,
+        SetSpriteRects,
+        DrawSprites
+    };
+    
+    /**
+     * One recorded command. Payload fields depend on the type:
+     *  Clear: values = rgba        SetViewport: ints = x, y, w, h
+     *  Enable*: ints[0] = 0/1      SetBlendMode: ints[0..1] = factors
+     *  SetViewProjection: index = matrix pair
+     *  BindTexture: ints[0] = slot, texture
+     *  DrawQuads: index = first vertex, count = quads
+     *  *Geometry: index = geometry handle, count = quads
+     *  SetSpriteRects: index = first rect, count = rects
+     *  DrawSprites: index = first instance, count = sprites
+     */
+    struct Command {
+        CommandType type;
+        int ints[4];
+        float values[4];
+        const Texture* texture;
+        uint32_t index;
+        uint32_t count;
+    };
+    
+    struct Counters {
+        uint64_t frames = 0;
+        uint64_t commands = 0;
+        uint64_t drawCalls = 0;
+        uint64_t quads = 0;
+        uint64_t textureBinds = 0;
+        uint64_t redundantTextureBinds = 0; // Same texture already in that slot
+        uint64_t stateChanges = 0;          // Viewport, depth, blend, matrices
+        uint64_t clears = 0;
+        uint64_t geometryUploads = 0;       // Static geometry creates and updates
+        uint64_t instancedQuads = 0;        // Quads drawn as sprite instances
+        uint64_t uploadBytes = 0;           // Per-draw vertex, instance and rect data
+        
+        double quadsPerDrawCall() const {
+            return drawCalls > 0 ? static_cast<double>(quads) / static_cast<double>(drawCalls) : 0.0;
+        }
+    };
+    
+    RecordingBackend();
+    ~RecordingBackend() override;
+    
+    // RenderBackend interface
+    bool initialize() override;
+    void shutdown() override;
+    
+    void beginFrame() override;
+    void endFrame() override;
+    
+    void clear(float r, float g, float b, float a) override;
+    void clearDepth() override;
+    
+    void setViewport(int x, int y, int width, int height) override;
+    void enableDepthTest(bool enable) override;
+    void enableBlending(bool enable) override;
+    void setBlendMode(int srcFactor, int dstFactor) override;
+    
+    void setViewProjection(const glm::mat4& view, const glm::mat4& projection) override;
+    void bindTexture(int slot, const Texture* texture) override;
+    void drawQuads(const QuadVertex* vertices, size_t quadCount) override;
+    
+    GeometryHandle createStaticGeometry(const QuadVertex* vertices, size_t quadCount) override;
+    bool updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) override;
+    void destroyStaticGeometry(GeometryHandle handle) override;
+    void drawStaticGeometry(GeometryHandle handle) override;
+    
+    bool supportsInstancing() const override { return instancing; }
+    void setSpriteRects(const SpriteRect* rects, size_t rectCount) override;
+    void drawSprites(const SpriteInstance* instances, size_t instanceCount) override;
+    
+    bool supportsRenderTargets() const override;
+    RenderTargetHandle createRenderTarget(int width, int height) override;
+    void destroyRenderTarget(RenderTargetHandle handle) override;
+    void setRenderTarget(RenderTargetHandle handle) override;
+    RenderTargetHandle getRenderTarget() const override { return INVALID_TARGET; }
+    const Texture* getRenderTargetTexture(RenderTargetHandle handle) const override;
+    
+    float getGpuFrameTime() const override { return 0.0f; }
+    
+    const char* getName() const override;
+    const char* getVersion() const override;
+    RenderBackendType getType() const override;
+    
+    // When false (default) each beginFrame() discards the previous capture,
+    // keeping memory flat for long benchmark runs
+    void setKeepHistory(bool keep) { keepHistory = keep; }
+    
+    // Counters only (no command/vertex storage) for the lowest overhead
+    void setCaptureCommands(bool capture) { captureCommands = capture; }
+    
+    // Report instancing as (un)available, to compare both submission paths
+    void setInstancingSupported(bool supported) { instancing = supported; }
+    
+    // Drop the capture and reset all counters
+    void reset();
+    
+    // Inspection
+    const std::vector<Command>& getCommands() const { return commands; }
+    const std::vector<QuadVertex>& getVertices() const { return vertices; }
+    const std::vector<SpriteInstance>& getSpriteInstances() const { return spriteInstances; }
+    const std::vector<SpriteRect>& getSpriteRects() const { return spriteRects; }
+    const glm::mat4& getViewMatrix(uint32_t index) const { return matrices[index * 2]; }
+    const glm::mat4& getProjectionMatrix(uint32_t index) const { return matrices[index * 2 + 1]; }
+    
+    // Counters of the last completed frame and of everything since reset()
+    const Counters& getFrameCounters() const { return lastFrame; }
+    const Counters& getTotalCounters() const { return total; }
+    
+    // Quads currently held by a static geometry handle (0 if unknown)
+    size_t getStaticGeometryQuadCount(GeometryHandle handle) const;
+    
+    // Re-issue the captured command stream into another backend. Static
+    // geometry is recreated in the target from its latest contents; sprites
+    // are expanded to quads for targets without instancing.
+    void replay(RenderBackend& target) const;
+    
+    // Human-readable dump of the capture (one line per command)
+    std::string describe(size_t maxCommands = 200) const;
+    
+    static const char* commandName(CommandType type);
+    
+private:
+    bool initialized;
+    bool keepHistory;
+    bool captureCommands;
+    bool instancing;
+    
+    std::vector<Command> commands;
+    std::vector<QuadVertex> vertices;
+    std::vector<SpriteInstance> spriteInstances;
+    std::vector<SpriteRect> spriteRects; // Every table set during the capture
+    
+    // The rect table lives across frames like static geometry: the current
+    // one, and the one in effect when the capture started (for replay)
+    std::vector<SpriteRect> activeRects;
+    std::vector<SpriteRect> initialRects;
+    std::vector<glm::mat4> matrices; // view, projection pairs
+    
+    // Static geometry lives across frames (not part of the capture)
+    std::unordered_map<GeometryHandle, std::vector<QuadVertex>> staticGeometry;
+    GeometryHandle nextGeometryHandle;
+    
+    // Current texture per slot, for redundant-bind detection
+    const Texture* boundTextures[MAX_TEXTURE_SLOTS];
+    
+    Counters currentFrame;
+    Counters lastFrame;
+    Counters total;
+    
+    Command& record(CommandType type);
+    void count(uint64_t Counters::*field, uint64_t amount = 1);
+};
+
+#endif // RECORDING_BACKEND_H
@@ -2,17 +2,63 @@
 #define RENDER_BACKEND_H
 
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+class Texture;
+
 /**
  * Rendering Backend Type
  */
 enum class RenderBackendType {
     OpenGL,
     DirectX11,
+    Recording, // Captures commands in memory (no GPU)
+    Software,  // CPU rasterizer (no GPU)
     Auto  // Select best available backend
 };
 
+/**
+ * Quad Vertex
+ * Vertex layout for all 2D geometry submitted through a backend.
+ * Quads are four consecutive vertices (top-left, top-right, bottom-right,
+ * bottom-left); texIndex selects a bound texture slot, negative = untextured.
+ */
+struct QuadVertex {
+    glm::vec3 position;
+    glm::vec4 color;
+    glm::vec2 texCoord;
+    float texIndex;
+};
+
+/**
+ * Sprite Rect
+ * Entry of the sprite rect table used by instanced drawing: quad size and
+ * texture region shared by every instance that refers to it.
+ */
+struct SpriteRect {
+    glm::vec2 size;
+    glm::vec2 texCoordMin;
+    glm::vec2 texCoordMax;
+};
+
+/**
+ * Sprite Instance
+ * Compact per-sprite data for instanced drawing: 20 bytes instead of four
+ * 40-byte QuadVertex. The backend expands the corners (same order and
+ * texture coordinates as an unrotated quad) from the rect table.
+ */
+struct SpriteInstance {
+    glm::vec2 position; // Corner at texCoordMin, as the quad position
+    float depth;
+    uint32_t color;     // RGBA8, red in the lowest byte
+    uint16_t rect;      // Index into the sprite rect table
+    uint16_t texSlot;   // Bound texture slot, UNTEXTURED for color only
+    
+    static constexpr uint16_t UNTEXTURED = 0xFFFF;
+};
+
 /**
  * Abstract Rendering Backend Interface
  * Provides a common interface for different rendering APIs (OpenGL, DirectX)
@@ -39,6 +85,59 @@ public:
     virtual void enableBlending(bool enable) = 0;
     virtual void setBlendMode(int srcFactor, int dstFactor) = 0;
     
+    // 2D drawing
+    // Texture slots available to one drawQuads() call (GL 3.3 guarantees 16)
+    static constexpr int MAX_TEXTURE_SLOTS = 16;
+    
+    virtual void setViewProjection(const glm::mat4& view, const glm::mat4& projection) = 0;
+    virtual void bindTexture(int slot, const Texture* texture) = 0;
+    // Draw quadCount quads (4 * quadCount vertices) using the bound texture slots
+    virtual void drawQuads(const QuadVertex* vertices, size_t quadCount) = 0;
+    
+    // Static geometry: quads uploaded once and drawn many times (terrain chunks).
+    // Handles are backend-specific; 0 is never a valid handle.
+    using GeometryHandle = uint32_t;
+    static constexpr GeometryHandle INVALID_GEOMETRY = 0;
+    
+    virtual GeometryHandle createStaticGeometry(const QuadVertex* vertices, size_t quadCount) = 0;
+    // Replace the contents of existing geometry; returns false if the handle is unknown
+    virtual bool updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) = 0;
+    virtual void destroyStaticGeometry(GeometryHandle handle) = 0;
+    // Draw all quads of the geometry with the currently bound texture slots
+    virtual void drawStaticGeometry(GeometryHandle handle) = 0;
+    
+    // Instanced sprites. Optional: when supportsInstancing() is false the
+    // other two calls do nothing and callers submit quads instead.
+    virtual bool supportsInstancing() const = 0;
+    // Replace the sprite rect table that SpriteInstance::rect indexes
+    virtual void setSpriteRects(const SpriteRect* rects, size_t rectCount) = 0;
+    // Draw instanceCount sprites using the bound texture slots
+    virtual void drawSprites(const SpriteInstance* instances, size_t instanceCount) = 0;
+    
+    // Offscreen render targets: RGBA8 color, no depth. Optional: when
+    // supportsRenderTargets() is false createRenderTarget() returns
+    // INVALID_TARGET and the other calls do nothing.
+    using RenderTargetHandle = uint32_t;
+    static constexpr RenderTargetHandle INVALID_TARGET = 0;
+    
+    virtual bool supportsRenderTargets() const = 0;
+    virtual RenderTargetHandle createRenderTarget(int width, int height) = 0;
+    virtual void destroyRenderTarget(RenderTargetHandle handle) = 0;
+    // Draw into a target (the caller clears it) or back to the screen with
+    // INVALID_TARGET, which restores the default blend mode. Each target
+    // and the screen remember their viewport: a target starts out fully
+    // covered, and setViewport() while it is bound changes its own.
+    // Inside a target, blending keeps color premultiplied by alpha, so
+    // composite targets with (ONE, ONE_MINUS_SRC_ALPHA).
+    virtual void setRenderTarget(RenderTargetHandle handle) = 0;
+    virtual RenderTargetHandle getRenderTarget() const = 0;
+    // Color of a target, bindable like any texture (owned by the backend)
+    virtual const Texture* getRenderTargetTexture(RenderTargetHandle handle) const = 0;
+    
+    // GPU time of the most recent frame whose timing is known, in
+    // milliseconds (results lag a few frames); 0 when not measured
+    virtual float getGpuFrameTime() const = 0;
+    
     // Get backend info
     virtual const char* getName() const = 0;
     virtual const char* getVersion() const = 0;
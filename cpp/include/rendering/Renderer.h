@@ -1,19 +1,19 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
-#include <memory>
-#include "Shader.h"
+#include "RenderBackend.h"
 #include "Texture.h"
 
 /**
  * 2D Sprite Renderer
- * Handles rendering of textured quads (sprites/tiles)
+ * Handles rendering of textured quads (sprites/tiles).
+ * Builds quad vertices on the CPU and submits them through a RenderBackend,
+ * so it never talks to the graphics API directly.
  */
 class Renderer {
 public:
-    Renderer();
+    explicit Renderer(RenderBackend* backend);
     ~Renderer();
     
     // Initialize renderer
@@ -30,6 +30,20 @@ public:
     void setViewMatrix(const glm::mat4& view);
     void setProjectionMatrix(const glm::mat4& projection);
     
+    const glm::mat4& getViewMatrix() const { return viewMatrix; }
+    const glm::mat4& getProjectionMatrix() const { return projectionMatrix; }
+    
+    // Size in pixels of the screen the matrices project onto (level of detail)
+    void setViewportSize(int width, int height) { viewportSize = glm::ivec2(width, height); }
+    const glm::ivec2& getViewportSize() const { return viewportSize; }
+    
+    // World-space rectangle the current matrices show (for culling)
+    void getVisibleBounds(glm::vec2& outMin, glm::vec2& outMax) const;
+    
+    // Screen pixels per world unit along x (level of detail); 0 until the
+    // viewport size is set
+    float getPixelsPerUnit() const;
+    
     // Draw a textured quad (sprite/tile)
     void drawQuad(
         const glm::vec2& position,
@@ -53,23 +67,47 @@ public:
     void drawRect(float x, float y, float width, float height, const glm::vec4& color);
     void drawLine(float x1, float y1, float x2, float y2, const glm::vec4& color, float thickness = 1.0f);
     
-    // Get default shader
-    Shader* getShader() { return shader.get(); }
+    // Draw prebuilt static geometry; textures[i] is bound to slot i first
+    void drawStaticGeometry(
+        RenderBackend::GeometryHandle geometry,
+        const Texture* const* textures,
+        int textureCount
+    );
+    
+    // Draw prebuilt quads in one call; textures[i] is bound to slot i first
+    void drawQuads(
+        const QuadVertex* vertices,
+        size_t quadCount,
+        const Texture* const* textures,
+        int textureCount
+    );
+    
+    // Fill four vertices (quad order) exactly as drawQuad() would, for
+    // callers that prebuild geometry; texIndex < 0 means untextured
+    static void buildQuadVertices(
+        QuadVertex* out,
+        const glm::vec2& position,
+        const glm::vec2& size,
+        const glm::vec4& color,
+        float texIndex,
+        float rotation = 0.0f,
+        const glm::vec2& texCoordMin = glm::vec2(0.0f, 0.0f),
+        const glm::vec2& texCoordMax = glm::vec2(1.0f, 1.0f)
+    );
+    
+    // Backend all drawing goes through (not owned)
+    RenderBackend* getBackend() { return backend; }
     
 private:
-    // Shader and VAO/VBO for quad rendering
-    std::unique_ptr<Shader> shader;
-    GLuint VAO, VBO, EBO;
+    RenderBackend* backend; // Not owned by Renderer
     
     // View and projection matrices
     glm::mat4 viewMatrix;
     glm::mat4 projectionMatrix;
+    bool matricesDirty;
+    glm::ivec2 viewportSize; // Pushed to the backend lazily on the next draw
     
-    // Setup quad geometry
-    void setupQuad();
-    
-    // Create default shader
-    bool createDefaultShader();
+    void flushMatrices();
 };
 
 #endif // RENDERER_H
@@ -3,14 +3,32 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
  * Shader Program Management
- * Handles shader compilation and uniform setting
+ * Handles shader compilation and uniform setting. Active uniforms and
+ * uniform blocks are reflected once at link time into tables keyed by the
+ * FNV-1a hash of their names, so setting a uniform never asks the driver
+ * for a location. Hash names at compile time where it matters:
+ *     static constexpr Shader::UniformId COLOR = Shader::uniformId("color");
  */
 class Shader {
 public:
+    using UniformId = uint32_t;
+    
+    // FNV-1a hash of a uniform name; array elements are "name[i]"
+    static constexpr UniformId uniformId(const char* name) {
+        uint32_t hash = 2166136261u;
+        while (*name) {
+            hash = (hash ^ static_cast<uint8_t>(*name++)) * 16777619u;
+        }
+        return hash;
+    }
+    
     Shader();
     ~Shader();
     
@@ -20,22 +38,57 @@ public:
     // Load shaders from files
     bool loadFromFiles(const char* vertexPath, const char* fragmentPath);
     
+    // Load a program binary from getBinary(); fails quietly when the driver
+    // rejects it (different driver or GPU), so callers can compile instead
+    bool loadFromBinary(GLenum format, const void* data, size_t length);
+    
+    // Ask the driver to keep the linked binary around (set before loading)
+    void setBinaryRetrievable(bool retrievable) { binaryRetrievable = retrievable; }
+    
+    // Linked program binary (needs setBinaryRetrievable before linking)
+    bool getBinary(GLenum& format, std::vector<uint8_t>& data) const;
+    
     // Use this shader program
     void use() const;
     
-    // Uniform setters
-    void setInt(const char* name, int value) const;
-    void setFloat(const char* name, float value) const;
-    void setVec2(const char* name, const glm::vec2& value) const;
-    void setVec3(const char* name, const glm::vec3& value) const;
-    void setVec4(const char* name, const glm::vec4& value) const;
-    void setMat4(const char* name, const glm::mat4& value) const;
+    // Uniform setters (unknown uniforms are ignored, as with location -1)
+    void setInt(UniformId id, int value) const;
+    void setIntArray(UniformId id, const int* values, int count) const;
+    void setFloat(UniformId id, float value) const;
+    void setVec2(UniformId id, const glm::vec2& value) const;
+    void setVec3(UniformId id, const glm::vec3& value) const;
+    void setVec4(UniformId id, const glm::vec4& value) const;
+    void setMat4(UniformId id, const glm::mat4& value) const;
+    
+    // Same, hashing the name at the call
+    void setInt(const char* name, int value) const { setInt(uniformId(name), value); }
+    void setIntArray(const char* name, const int* values, int count) const { setIntArray(uniformId(name), values, count); }
+    void setFloat(const char* name, float value) const { setFloat(uniformId(name), value); }
+    void setVec2(const char* name, const glm::vec2& value) const { setVec2(uniformId(name), value); }
+    void setVec3(const char* name, const glm::vec3& value) const { setVec3(uniformId(name), value); }
+    void setVec4(const char* name, const glm::vec4& value) const { setVec4(uniformId(name), value); }
+    void setMat4(const char* name, const glm::mat4& value) const { setMat4(uniformId(name), value); }
+    
+    // Reflected uniform location (-1 if the program has no such uniform)
+    GLint getUniformLocation(UniformId id) const;
+    bool hasUniform(const char* name) const { return getUniformLocation(uniformId(name)) != -1; }
+    int getUniformCount() const { return static_cast<int>(uniformLocations.size()); }
+    
+    // Reflected uniform block index (GL_INVALID_INDEX if absent), and
+    // routing a block to a uniform buffer binding point
+    GLuint getUniformBlockIndex(const char* name) const;
+    bool bindUniformBlock(const char* name, GLuint binding) const;
     
     // Get program ID
     GLuint getID() const { return programID; }
     
 private:
     GLuint programID;
+    bool binaryRetrievable;
+    
+    // Name hash -> location / block index, filled by reflect()
+    std::unordered_map<UniformId, GLint> uniformLocations;
+    std::unordered_map<UniformId, GLuint> uniformBlocks;
     
     // Compile a shader
     GLuint compileShader(GLenum type, const char* source);
@@ -43,6 +96,9 @@ private:
     // Link shader program
     bool linkProgram(GLuint vertexShader, GLuint fragmentShader);
     
+    // Read active uniforms and uniform blocks of the linked program
+    void reflect();
+    
     // Check compilation/linking errors
     void checkCompileErrors(GLuint shader, const char* type);
 };
@@ -5,16 +5,39 @@
 #include <unordered_map>
 #include <memory>
 #include "Shader.h"
+#include "StreamBuffer.h"
+#include "ProgramBinaryCache.h"
 
 /**
  * Shader Library for managing multiple shaders
- * Provides shader caching and retrieval by name
+ * Provides shader caching and retrieval by name. The library also owns the
+ * per-frame uniform buffer behind the Matrices block (view, projection):
+ * every shader it loads has the block routed to MATRICES_BINDING, so one
+ * upload per camera change serves all of them.
+ *
+ * With a binary cache enabled, loadFromSource first tries a program binary
+ * saved by an earlier launch and only compiles on a miss.
  */
 class ShaderLibrary {
 public:
+    // Uniform buffer binding point of the shared Matrices block
+    static constexpr GLuint MATRICES_BINDING = 0;
+    
+    // Time spent getting shaders ready, split by how they were obtained
+    struct LoadStats {
+        int fromCache = 0;
+        int compiled = 0;
+        double cacheMilliseconds = 0.0;
+        double compileMilliseconds = 0.0;
+    };
+    
     ShaderLibrary();
     ~ShaderLibrary();
     
+    // Cache linked programs in directory (needs a GL context); false if the
+    // driver can't provide binaries, in which case everything compiles
+    bool enableBinaryCache(const std::string& directory);
+    
     // Load shader from files
     bool loadFromFiles(const std::string& name, const char* vertexPath, const char* fragmentPath);
     
@@ -37,8 +60,37 @@ public:
     // Load common built-in shaders
     bool loadBuiltInShaders();
     
+    // Per-frame uniforms (need a GL context): create/destroy the buffer,
+    // and fence what a frame wrote once it is submitted
+    bool initializeFrameUniforms(bool allowPersistent);
+    void shutdownFrameUniforms();
+    void beginFrame();
+    void endFrame();
+    
+    // Upload and bind view/projection for the following draws (skipped when
+    // neither changed since the last call this frame)
+    void setViewProjection(const glm::mat4& view, const glm::mat4& projection);
+    
+    // Null before initializeFrameUniforms
+    const StreamBuffer* getFrameUniforms() const { return frameUniforms.get(); }
+    
+    const LoadStats& getLoadStats() const { return loadStats; }
+    
 private:
+    static constexpr size_t FRAME_UNIFORM_REGION = 64 * 1024;
+    
     std::unordered_map<std::string, std::unique_ptr<Shader>> shaders;
+    std::unique_ptr<ProgramBinaryCache> binaryCache;
+    LoadStats loadStats;
+    
+    std::unique_ptr<StreamBuffer> frameUniforms;
+    size_t uniformAlignment;
+    glm::mat4 currentView;
+    glm::mat4 currentProjection;
+    bool matricesValid;
+    
+    // Take ownership of a loaded shader, routing its Matrices block
+    void add(const std::string& name, std::unique_ptr<Shader> shader);
     
     // Built-in shader sources
     bool loadDefaultShader();
@@ -0,0 +1,169 @@
+#ifndef SOFTWARE_BACKEND_H
+#define SOFTWARE_BACKEND_H
+
+#include "RenderBackend.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+class Texture;
+
+/**
+ * Software Rendering Backend
+ * Rasterizes the engine's quads on the CPU into an RGBA8 framebuffer, for
+ * machines without a GPU (CI, soak runs, golden-image tests).
+ *
+ * Quads are transformed and binned into screen tiles as they are submitted;
+ * endFrame() rasterizes the tiles in parallel on the job system. Each tile
+ * replays its quads in submission order, so the output is deterministic and
+ * matches the GL path's painter's order (all 2D geometry sits at depth 0).
+ * Texels are sampled nearest-neighbour with GL_REPEAT wrapping and blended
+ * with SRC_ALPHA / ONE_MINUS_SRC_ALPHA, four pixels at a time with SSE2 when
+ * available; (DST_COLOR, ZERO) multiplies instead (light maps), and any
+ * other blend mode falls back to alpha blending.
+ *
+ * Render targets are framebuffers of their own, sampled through a CPU
+ * texture that is refreshed when drawing leaves the target (so they need
+ * Texture::setCpuOnly). Inside one, alpha accumulates as coverage, as on GL.
+ */
+class SoftwareBackend : public RenderBackend {
+public:
+    static constexpr int TILE_SIZE = 64;
+    
+    SoftwareBackend(int width, int height, JobSystem* jobSystem = nullptr);
+    ~SoftwareBackend() override;
+    
+    // RenderBackend interface
+    bool initialize() override;
+    void shutdown() override;
+    
+    void beginFrame() override;
+    void endFrame() override;
+    
+    void clear(float r, float g, float b, float a) override;
+    void clearDepth() override;
+    
+    void setViewport(int x, int y, int width, int height) override;
+    void enableDepthTest(bool enable) override;
+    void enableBlending(bool enable) override;
+    void setBlendMode(int srcFactor, int dstFactor) override;
+    
+    void setViewProjection(const glm::mat4& view, const glm::mat4& projection) override;
+    void bindTexture(int slot, const Texture* texture) override;
+    void drawQuads(const QuadVertex* vertices, size_t quadCount) override;
+    
+    GeometryHandle createStaticGeometry(const QuadVertex* vertices, size_t quadCount) override;
+    bool updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) override;
+    void destroyStaticGeometry(GeometryHandle handle) override;
+    void drawStaticGeometry(GeometryHandle handle) override;
+    
+    bool supportsInstancing() const override;
+    void setSpriteRects(const SpriteRect* rects, size_t rectCount) override;
+    void drawSprites(const SpriteInstance* instances, size_t instanceCount) override;
+    
+    bool supportsRenderTargets() const override;
+    RenderTargetHandle createRenderTarget(int width, int height) override;
+    void destroyRenderTarget(RenderTargetHandle handle) override;
+    void setRenderTarget(RenderTargetHandle handle) override;
+    RenderTargetHandle getRenderTarget() const override { return currentRenderTarget; }
+    const Texture* getRenderTargetTexture(RenderTargetHandle handle) const override;
+    
+    float getGpuFrameTime() const override { return 0.0f; }
+    
+    const char* getName() const override;
+    const char* getVersion() const override;
+    RenderBackendType getType() const override;
+    
+    // Resize the framebuffer (contents are discarded)
+    void resize(int width, int height);
+    
+    // Framebuffer access: RGBA8, top row first. Valid after endFrame(),
+    // with no render target bound.
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const uint8_t* getPixels() const { return reinterpret_cast<const uint8_t*>(colorBuffer.data()); }
+    
+    // Write the last finished frame as a PNG
+    bool saveScreenshot(const std::string& path) const;
+    
+    // Quads rasterized in the last frame (after clipping to the screen)
+    size_t getLastFrameQuadCount() const { return lastFrameQuadCount; }
+    
+private:
+    // A quad after transformation: screen-space parallelogram with an
+    // affine texture mapping and a single tint color
+    struct ScreenQuad {
+        float originX, originY;   // Screen position of the bottom-left vertex
+        float dsdx, dsdy;         // Gradient of s (along the quad's width axis)
+        float dtdx, dtdy;         // Gradient of t (along the quad's height axis)
+        float uvOriginX, uvOriginY;
+        float uvSX, uvSY;         // Texture coordinate change over s = 0..1
+        float uvTX, uvTY;         // Texture coordinate change over t = 0..1
+        int minX, minY, maxX, maxY; // Pixel bounds (inclusive, clipped)
+        uint32_t color;           // Packed RGBA8 tint
+        const Texture* texture;   // Null = untextured
+        int level;                // Mip level sampled (from the texel footprint)
+    };
+    
+    int width;
+    int height;
+    JobSystem* jobSystem; // Not owned
+    
+    // Viewport and matrices
+    int viewportX, viewportY, viewportWidth, viewportHeight;
+    glm::mat4 viewProjection;
+    bool blendingEnabled;
+    bool multiplyBlending; // (DST_COLOR, ZERO) instead of alpha blending
+    bool coverageAlpha;    // Alpha blends with (ONE, ONE_MINUS_SRC_ALPHA) (render targets)
+    
+    // Texture slots (textures must carry CPU pixels, see Texture::setCpuOnly)
+    const Texture* boundTextures[MAX_TEXTURE_SLOTS];
+    
+    // Static geometry is kept as plain vertex arrays and drawn like any quads
+    std::unordered_map<GeometryHandle, std::vector<QuadVertex>> staticGeometry;
+    GeometryHandle nextGeometryHandle;
+    
+    // Frame data
+    std::vector<uint32_t> colorBuffer;
+    std::vector<ScreenQuad> quads;
+    std::vector<std::vector<uint32_t>> tileBins; // Quad indices per tile
+    int tilesX;
+    int tilesY;
+    bool clearPending;
+    uint32_t clearColor;
+    size_t lastFrameQuadCount;
+    bool missingPixelsWarned;
+    
+    // While a target is bound its pixels and size are swapped with the
+    // screen's, so colorBuffer, width and height are always the ones drawn
+    // to. Target rows are stored bottom first, like the texture's.
+    struct RenderTarget {
+        std::vector<uint32_t> colorBuffer;
+        int width;
+        int height;
+        int viewport[4];
+        std::unique_ptr<Texture> texture; // Copy of the color for sampling
+    };
+    std::unordered_map<RenderTargetHandle, RenderTarget> renderTargets;
+    RenderTargetHandle nextRenderTarget;
+    RenderTargetHandle currentRenderTarget;
+    int screenViewport[4];
+    
+    // Exchange the framebuffer drawn to with a target's (or back)
+    void swapColorBuffer(RenderTarget& target);
+    
+    // Rasterize everything submitted so far and reset the bins
+    void flush();
+    void rasterizeTile(int tileIndex);
+    void rasterizeQuad(const ScreenQuad& quad, int tileMinX, int tileMinY, int tileMaxX, int tileMaxY);
+    
+    // Mip level of the quad's texture for its on-screen scale
+    static int selectLevel(const ScreenQuad& quad);
+    
+    static uint32_t packColor(const glm::vec4& color);
+};
+
+#endif // SOFTWARE_BACKEND_H
@@ -0,0 +1,86 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Streaming Buffer for per-frame GPU data
+ * A ring of equally sized regions in one GL buffer, for data rewritten
+ * every frame (quad vertices, sprite instances, matrices). Writes append
+ * to the current region; when a frame ends or the region fills up, the
+ * region is fenced and the ring moves on. A region is only written again
+ * once its fence has signaled, so the CPU never overwrites data the GPU is
+ * still reading and the driver never has to synchronize behind our back
+ * (as glBufferSubData into a single busy buffer does).
+ *
+ * Modes, best first:
+ *  Persistent:      one coherent mapping for the buffer's lifetime (GL 4.4)
+ *  Unsynchronized:  glMapBufferRange per write, safe thanks to the fences
+ *  Orphaning:       no fences; the buffer storage is orphaned on each wrap
+ */
+class StreamBuffer {
+public:
+    enum class Mode {
+        Persistent,
+        Unsynchronized,
+        Orphaning
+    };
+    
+    struct Stats {
+        uint64_t bytesStreamed = 0;
+        uint64_t writes = 0;
+        uint64_t stallsAvoided = 0; // Writes that needed no synchronization
+        uint64_t stalls = 0;        // Fence waits that blocked on the GPU
+        uint64_t orphans = 0;       // Storage reallocations (orphaning mode)
+    };
+    
+    StreamBuffer(GLenum target, size_t regionSize, int regionCount = 3);
+    ~StreamBuffer();
+    
+    // Create the buffer; persistent mapping is used only when allowed
+    bool initialize(bool allowPersistent);
+    void shutdown();
+    
+    // Fence the region written this frame and move on to the next
+    void endFrame();
+    
+    // Copy size bytes (at most the region size) into the ring. Returns the
+    // byte offset in the buffer, a multiple of alignment; the buffer is
+    // left bound to the target.
+    size_t write(const void* data, size_t size, size_t alignment);
+    
+    GLuint getBuffer() const { return buffer; }
+    Mode getMode() const { return mode; }
+    size_t getRegionSize() const { return regionSize; }
+    const Stats& getStats() const { return stats; }
+    
+    static const char* modeName(Mode mode);
+    
+private:
+    GLenum target;
+    size_t regionSize;
+    int regionCount;
+    
+    GLuint buffer;
+    Mode mode;
+    uint8_t* mapped; // Persistent mapping (null in other modes)
+    
+    std::vector<GLsync> fences; // One per region, null when not in flight
+    int region;                 // Region being written
+    size_t cursor;              // Next free byte (absolute offset)
+    bool regionAcquired;        // Fence of the current region already waited on
+    
+    Stats stats;
+    
+    // Fence the current region and start the next one
+    void advanceRegion();
+    
+    // Make the current region writable (wait for its fence, or orphan);
+    // true if that had to block
+    bool acquireRegion();
+};
+
+#endif // STREAM_BUFFER_H
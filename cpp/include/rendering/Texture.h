@@ -2,7 +2,10 @@
 #define TEXTURE_H
 
 #include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 /**
  * Texture Management
@@ -19,6 +22,34 @@ public:
     // Load texture from memory
     bool loadFromMemory(unsigned char* data, int width, int height, int channels);
     
+    // Load texture from decodeImage() output, optionally with mipmaps
+    bool loadFromImage(unsigned char* data, int width, int height, int channels, bool generateMipmap);
+    
+    // Allocate uninitialized RGBA8 storage, clamped and linearly filtered
+    // (render target color); fails in CPU-only mode
+    bool createEmpty(int width, int height);
+    
+    // Overwrite all pixels of a loaded RGBA8 texture without mipmaps (same
+    // size, bottom row first), reusing its storage; for data the CPU
+    // recomputes while the game runs (light maps)
+    bool update(const unsigned char* data);
+    
+    // Load RGBA8 pixels with a precomputed mip chain (level 0 first, each
+    // level half the previous, down to 1x1), e.g. straight from an AssetPack
+    bool loadFromMipChain(const std::vector<const unsigned char*>& levels, int width, int height);
+    
+    // Decode an image file, bottom row first (as the GL upload expects).
+    // Safe on any thread; null on failure (decodeError() says why on the
+    // same thread). Release the pixels with freeImage().
+    static unsigned char* decodeImage(const char* path, int& width, int& height, int& channels);
+    static const char* decodeError();
+    static void freeImage(unsigned char* data);
+    
+    // Next mip level of RGBA8 pixels (half size, at least 1x1): 2x2 box
+    // filter weighted by alpha, so transparent texels don't darken the
+    // edges of sprites
+    static void downsample(const unsigned char* source, int width, int height, unsigned char* destination);
+    
     // Bind texture to a texture unit
     void bind(unsigned int unit = 0) const;
     
@@ -50,12 +81,47 @@ public:
     int getActualWidth() const { return width; }
     int getActualHeight() const { return height; }
     
+    // Residency: release() frees the pixels (GL storage or CPU copy) but
+    // keeps the object, so pointers held by caches stay valid; loading
+    // again brings it back. A released texture binds as "no texture".
+    void release();
+    bool isResident() const { return textureID != 0 || !pixels.empty(); }
+    
+    // Bytes the pixels occupy, mip levels included (0 when released)
+    size_t getMemoryBytes() const;
+    
+    // Usage stamps: backends mark textures as they bind them, the texture
+    // manager advances the frame and evicts the least recently used
+    void markUsed() const { lastUsedFrame = currentFrame; }
+    uint64_t getLastUsedFrame() const { return lastUsedFrame; }
+    static void advanceFrame() { ++currentFrame; }
+    static uint64_t getCurrentFrame() { return currentFrame; }
+    
+    // CPU-only mode (no GL context, e.g. software rendering): textures keep
+    // their pixels in memory as RGBA8 and never create GL objects
+    static void setCpuOnly(bool enabled) { cpuOnly = enabled; }
+    static bool isCpuOnly() { return cpuOnly; }
+    
+    // RGBA8 pixels of a mip level, bottom row first (same orientation as
+    // the GL upload); null unless the texture was loaded in CPU-only mode.
+    // Level n is max(1, size >> n); mipmapped CPU textures keep every level.
+    const unsigned char* getPixels(int level = 0) const {
+        return level < getLevelCount() ? pixels.data() + levelOffsets[level] : nullptr;
+    }
+    int getLevelCount() const { return static_cast<int>(levelOffsets.size()); }
+    
 private:
     GLuint textureID;
     int width;
     int height;
     int channels;
     bool mipmapsEnabled;
+    std::vector<unsigned char> pixels;
+    std::vector<size_t> levelOffsets; // Start of each level in pixels
+    mutable uint64_t lastUsedFrame;
+    
+    static bool cpuOnly;
+    static uint64_t currentFrame;
 };
 
 #endif // TEXTURE_H
@@ -3,19 +3,88 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <mutex>
 #include <vector>
+#include <chrono>
+#include <functional>
 #include "Texture.h"
+#include "AssetPack.h"
+#include "../engine/JobSystem.h"
 
 /**
  * Texture Manager
- * Centralized texture loading and caching system
+ * Centralized texture loading and caching system.
+ *
+ * With a job system set, loads are asynchronous: files are decoded on the
+ * workers in parallel and queued, and processUploads() creates the GL
+ * textures on the main thread. A texture is absent from getTexture() until
+ * it has been uploaded, so callers draw their untextured fallback meanwhile.
+ *
+ * With an asset pack open, textures it holds are uploaded at once from the
+ * mapped pack (mip chain included) instead of being decoded.
+ *
+ * With a memory budget set, beginFrame() evicts the textures drawn least
+ * recently until the resident ones fit. An evicted texture keeps its
+ * Texture object (pointers stay valid, it draws as untextured: vertex
+ * color only) and is reloaded from its source as soon as something draws
+ * it again. getResidencyChanges() tells caches that baked textures in
+ * when to look again.
  */
 class TextureManager {
 public:
+    // A texture to load: manager name, source file, mipmapping
+    struct TextureSource {
+        std::string name;
+        std::string path;
+        bool generateMipmap;
+    };
+    
     TextureManager();
     ~TextureManager();
     
+    // Serve loads from a cooked pack where it has a current entry
+    bool openAssetPack(const std::string& path);
+    size_t getPackHits() const { return packHits; }
+    
+    // Texture memory in bytes allowed to stay resident (0 = unlimited)
+    void setMemoryBudget(size_t bytes) { memoryBudget = bytes; }
+    size_t getMemoryBudget() const { return memoryBudget; }
+    
+    // Once per frame before drawing (main thread): reload evicted textures
+    // drawn last frame, then evict unused ones while over the budget
+    void beginFrame();
+    
+    struct MemoryReport {
+        size_t budget;        // 0 = unlimited
+        size_t residentBytes;
+        int residentCount;
+        size_t evictedBytes;  // What the evicted textures took while resident
+        int evictedCount;
+        uint64_t evictions;   // Totals since creation
+        uint64_t reloads;
+    };
+    MemoryReport getMemoryReport() const;
+    void logMemoryReport() const;
+    
+    // Changes whenever a texture is evicted or reloaded
+    uint64_t getResidencyChanges() const { return evictions + reloads; }
+    
+    // Decode on this job system from now on (not owned; null = load synchronously)
+    void setJobSystem(JobSystem* jobs) { jobSystem = jobs; }
+    
+    // Upload up to maxUploads finished decodes (main thread); returns how
+    // many new textures became available (reloads of evicted ones excluded)
+    size_t processUploads(size_t maxUploads = static_cast<size_t>(-1));
+    
+    // Wait for every queued decode and upload it (main thread)
+    void finishLoading();
+    
+    // Textures queued for decoding or waiting for upload
+    bool isLoading() const { return pendingCount > 0; }
+    int getPendingCount() const { return pendingCount; }
+    
     // Load a single texture
     bool loadTexture(const std::string& name, const std::string& path, bool generateMipmap = true);
     
@@ -29,6 +98,12 @@ public:
     // Load all ground tile textures
     bool loadGroundTiles();
     
+    // What the loaders above load, for cooking ahead of time
+    static std::vector<TextureSource> getTileVariationSources(const std::string& baseName,
+                                                              const std::string& directory, int count);
+    static std::vector<TextureSource> getDecorationSources();
+    static std::vector<TextureSource> getStartupSources();
+    
     // Get texture by name
     Texture* getTexture(const std::string& name);
     const Texture* getTexture(const std::string& name) const;
@@ -43,14 +118,70 @@ public:
     // Get number of loaded textures
     size_t getTextureCount() const { return textures.size(); }
     
-    // Clear all textures
+    // Clear all textures (waits for decodes in flight)
     void clear();
     
 private:
+    // A decode result waiting for its upload
+    struct DecodedImage {
+        std::string name;
+        std::string path;
+        unsigned char* data; // Texture::freeImage; null when decoding failed
+        std::string error;
+        int width;
+        int height;
+        int channels;
+        bool generateMipmap;
+        double decodeMilliseconds;
+    };
+    
     std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
     
+    AssetPack pack;
+    size_t packHits;
+    
+    // Textures drawn within this many frames are never evicted
+    static constexpr uint64_t EVICTION_MIN_AGE = 2;
+    
+    std::unordered_map<std::string, TextureSource> sources; // How to reload each texture
+    std::unordered_map<std::string, size_t> evictedBytes;   // Evicted textures, size when resident
+    size_t memoryBudget;
+    uint64_t evictions;
+    uint64_t reloads;
+    bool overBudget; // Warned that the textures in use exceed the budget
+    
+    JobSystem* jobSystem; // Not owned
+    JobCounter decodeCounter;
+    std::mutex decodedMutex;
+    std::vector<DecodedImage> decoded; // Filled by workers, drained by processUploads
+    std::unordered_set<std::string> queuedNames; // Main thread only
+    int pendingCount;
+    
+    // Current loading burst, for the summary logged when it completes
+    std::chrono::steady_clock::time_point burstStart;
+    int burstTextures;
+    double burstDecodeMilliseconds;
+    double burstSlowestDecode;
+    
+    // Load from the pack, a synchronous decode or a queued one
+    bool startLoad(const std::string& name, const std::string& path, bool generateMipmap);
+    
+    // Run load on the texture registered as name, created on first load
+    // (reloads fill the evicted object in place)
+    bool uploadTexture(const std::string& name, const std::string& path, bool generateMipmap,
+                       const std::function<bool(Texture&)>& load);
+    
+    // Evict least recently drawn textures until within the budget
+    void enforceBudget();
+    
+    // Queue a decode job for a texture
+    void queueDecode(const std::string& name, const std::string& path, bool generateMipmap);
+    
+    // Wait for decode jobs and free results that were never uploaded
+    void discardPendingLoads();
+    
     // Helper to format numbered texture names
-    std::string formatTextureName(const std::string& baseName, int index) const;
+    static std::string formatTextureName(const std::string& baseName, int index);
 };
 
 #endif // TEXTURE_MANAGER_H
@@ -0,0 +1,84 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "rendering/RenderBackend.h"
+
+class Texture;
+
+/**
+ * Glyph Atlas
+ * The UI font: printable ASCII glyphs of an embedded 5x7 bitmap font,
+ * packed into one texture at startup. The font is monospaced, so text is
+ * measured without the atlas; each font pixel covers PIXEL_SIZE screen
+ * pixels at scale 1.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+    
+    bool initialize();
+    void shutdown();
+    
+    // Sampled with nearest filtering (null before initialize)
+    const Texture* getTexture() const { return texture.get(); }
+    
+    // Texture region of a character's glyph (unknown characters show '?'),
+    // texCoordMin at the glyph's top-left
+    void getGlyphRegion(char c, glm::vec2& texCoordMin, glm::vec2& texCoordMax) const;
+    
+    // Metrics in screen pixels at scale 1
+    static constexpr int GLYPH_WIDTH = 5;  // Font pixels
+    static constexpr int GLYPH_HEIGHT = 7;
+    static constexpr float PIXEL_SIZE = 2.0f;
+    static constexpr float ADVANCE = (GLYPH_WIDTH + 1) * PIXEL_SIZE;
+    static glm::vec2 measureText(const std::string& text, float scale);
+    
+private:
+    // Atlas layout: one CELL_SIZE square per glyph, COLUMNS per row
+    static constexpr int CELL_SIZE = 8;
+    static constexpr int COLUMNS = 16;
+    static constexpr int ATLAS_WIDTH = 128;
+    static constexpr int ATLAS_HEIGHT = 64;
+    
+    std::unique_ptr<Texture> texture;
+};
+
+/**
+ * Text Layout Cache
+ * Glyph quads of laid out strings, keyed by text and style (scale and
+ * color) and positioned at the origin: drawing cached text is a copy with
+ * an offset. UI strings are few and mostly static, so the cache is simply
+ * emptied when it grows past MAX_ENTRIES.
+ */
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(const GlyphAtlas* atlas);
+    
+    // Quads of the text with its top-left at (0, 0); texSlot is the slot
+    // the atlas will be bound to
+    const std::vector<QuadVertex>& getLayout(const std::string& text, float scale, const glm::vec3& color, int texSlot);
+    
+    void clear() { layouts.clear(); }
+    
+    // Statistics
+    size_t getEntryCount() const { return layouts.size(); }
+    unsigned long long getHits() const { return hits; }
+    unsigned long long getMisses() const { return misses; }
+    
+private:
+    static constexpr size_t MAX_ENTRIES = 1024;
+    
+    const GlyphAtlas* atlas; // Not owned
+    std::unordered_map<std::string, std::vector<QuadVertex>> layouts;
+    std::string keyScratch;
+    unsigned long long hits;
+    unsigned long long misses;
+};
+
+#endif // GLYPH_ATLAS_H
@@ -32,10 +32,11 @@ private:
     Engine* engine;
     GameStateManager* stateManager;
     
-    // UI Elements
-    std::unique_ptr<UIPanel> backgroundPanel;
-    std::unique_ptr<UILabel> titleLabel;
-    std::vector<std::unique_ptr<UIButton>> menuButtons;
+    // UI tree; the other elements are owned by the canvas
+    std::unique_ptr<UICanvas> canvas;
+    UIPanel* backgroundPanel;
+    UILabel* titleLabel;
+    std::vector<UIButton*> menuButtons;
     
     // Mouse state
     float mouseX, mouseY;
@@ -1,31 +1,81 @@
 #ifndef UI_RENDERER_H
 #define UI_RENDERER_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
+#include "rendering/RenderBackend.h"
+#include "ui/GlyphAtlas.h"
 
 // Forward declarations
-class Shader;
+class Renderer;
+
+/**
+ * UI Geometry
+ * Quads of UI elements in screen pixels (origin top-left), collected on the
+ * CPU so a whole tree or frame goes to the backend in one draw call. Text
+ * is copied from cached layouts and samples the glyph atlas in FONT_SLOT.
+ */
+class UIGeometry {
+public:
+    static constexpr int FONT_SLOT = 0;
+    
+    UIGeometry() : textLayouts(nullptr) {}
+    
+    // Layouts text comes from (not owned); without them text is skipped
+    void setTextLayouts(TextLayoutCache* layouts) { textLayouts = layouts; }
+    
+    void clear() { vertices.clear(); }
+    
+    void addRect(float x, float y, float width, float height, const glm::vec4& color);
+    void addRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness = 2.0f);
+    void addLine(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float thickness = 1.0f);
+    void addText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
+    
+    // Size of text drawn by addText()
+    static glm::vec2 measureText(const std::string& text, float scale) { return GlyphAtlas::measureText(text, scale); }
+    
+    const QuadVertex* getVertices() const { return vertices.data(); }
+    size_t getQuadCount() const { return vertices.size() / 4; }
+    
+private:
+    TextLayoutCache* textLayouts;
+    std::vector<QuadVertex> vertices;
+};
 
 /**
  * UI Element Base Class
+ * Node of a retained UI tree. Elements append their quads to a UIGeometry
+ * when the tree is rebuilt; changing anything that affects the look marks
+ * the element and its ancestors dirty, which is what triggers a rebuild.
+ * Positions are absolute screen pixels; children draw over their parent.
  */
 class UIElement {
 public:
     UIElement(float x, float y, float width, float height)
-        : position(x, y), size(width, height), visible(true), enabled(true) {}
+        : position(x, y), size(width, height), visible(true), enabled(true), dirty(true), parent(nullptr) {}
     virtual ~UIElement() = default;
     
-    virtual void render() = 0;
+    // Append this element's own quads (not its children's)
+    virtual void build(UIGeometry& geometry) const = 0;
     virtual bool contains(float x, float y) const;
     
-    void setPosition(float x, float y) { position = glm::vec2(x, y); }
-    void setSize(float w, float h) { size = glm::vec2(w, h); }
-    void setVisible(bool v) { visible = v; }
+    // Take ownership of a child; returns it for further setup
+    template <typename T>
+    T* addChild(std::unique_ptr<T> child) {
+        T* added = child.get();
+        child->parent = this;
+        children.push_back(std::move(child));
+        markDirty();
+        return added;
+    }
+    const std::vector<std::unique_ptr<UIElement>>& getChildren() const { return children; }
+    
+    void setPosition(float x, float y);
+    void setSize(float w, float h);
+    void setVisible(bool v); // Hides the children too
     void setEnabled(bool e) { enabled = e; }
     
     glm::vec2 getPosition() const { return position; }
@@ -33,11 +83,46 @@ public:
     bool isVisible() const { return visible; }
     bool isEnabled() const { return enabled; }
     
+    // Something in this subtree changed since the last rebuild
+    bool isDirty() const { return dirty; }
+    
 protected:
     glm::vec2 position;
     glm::vec2 size;
     bool visible;
     bool enabled;
+    
+    // Call after any change that affects build()
+    void markDirty();
+    
+private:
+    friend class UIRenderer; // Clears the dirty flags on rebuild
+    
+    bool dirty;
+    UIElement* parent;
+    std::vector<std::unique_ptr<UIElement>> children;
+};
+
+/**
+ * UI Canvas
+ * Root of a UI tree; draws nothing itself and holds the backend geometry
+ * the tree was last built into.
+ */
+class UICanvas : public UIElement {
+public:
+    UICanvas(float width, float height);
+    ~UICanvas() override;
+    
+    void build(UIGeometry& geometry) const override { (void)geometry; }
+    
+    // Free the backend geometry (rebuilt on the next render)
+    void releaseGeometry();
+    
+private:
+    friend class UIRenderer;
+    
+    RenderBackend* backend; // Backend that owns the geometry (not owned)
+    RenderBackend::GeometryHandle geometry;
 };
 
 /**
@@ -50,20 +135,20 @@ public:
     UIButton(float x, float y, float width, float height, const std::string& text);
     ~UIButton() override = default;
     
-    void render() override;
+    void build(UIGeometry& geometry) const override;
     void onClick(ClickCallback callback) { clickCallback = callback; }
     void handleClick();
     
-    void setText(const std::string& txt) { this->text = txt; }
+    void setText(const std::string& txt);
     std::string getText() const { return text; }
     
-    void setHovered(bool h) { hovered = h; }
+    void setHovered(bool h);
     bool isHovered() const { return hovered; }
     
     // Colors
-    void setColor(const glm::vec3& c) { this->color = c; }
-    void setHoverColor(const glm::vec3& c) { this->hoverColor = c; }
-    void setTextColor(const glm::vec3& c) { this->textColor = c; }
+    void setColor(const glm::vec3& c);
+    void setHoverColor(const glm::vec3& c);
+    void setTextColor(const glm::vec3& c);
     
 private:
     std::string text;
@@ -83,9 +168,9 @@ public:
     UIPanel(float x, float y, float width, float height);
     ~UIPanel() override = default;
     
-    void render() override;
+    void build(UIGeometry& geometry) const override;
     
-    void setColor(const glm::vec4& c) { this->color = c; }
+    void setColor(const glm::vec4& c);
     glm::vec4 getColor() const { return color; }
     
 private:
@@ -93,21 +178,21 @@ private:
 };
 
 /**
- * UI Text Label
+ * UI Text Label (sized to its text)
  */
 class UILabel : public UIElement {
 public:
     UILabel(float x, float y, const std::string& text);
     ~UILabel() override = default;
     
-    void render() override;
+    void build(UIGeometry& geometry) const override;
     
-    void setText(const std::string& txt) { this->text = txt; }
+    void setText(const std::string& txt);
     std::string getText() const { return text; }
     
-    void setColor(const glm::vec3& c) { this->color = c; }
+    void setColor(const glm::vec3& c);
     glm::vec3 getColor() const { return color; }
-    void setScale(float s) { this->scale = s; }
+    void setScale(float s);
     
 private:
     std::string text;
@@ -117,23 +202,31 @@ private:
 
 /**
  * UI Renderer
- * Handles rendering of UI elements
+ * Draws retained UI trees and immediate-mode primitives through the
+ * Renderer, in screen pixels. A canvas costs one draw call and is only
+ * rebuilt on frames where something in it changed; primitives drawn
+ * between beginFrame() and endFrame() are collected into one more call.
  */
 class UIRenderer {
 public:
     UIRenderer();
     ~UIRenderer();
     
-    bool initialize(int screenWidth, int screenHeight);
+    bool initialize(Renderer* renderer, int screenWidth, int screenHeight);
     void shutdown();
     
-    // Rendering
+    // Rendering: beginFrame() sets up screen-space matrices, endFrame()
+    // draws the primitives collected since
     void beginFrame();
     void endFrame();
     
-    // Primitive rendering
+    // Rebuild the canvas if it is dirty, then draw it
+    void render(UICanvas& canvas);
+    
+    // Immediate-mode primitives, for content that changes every frame
     void drawRect(float x, float y, float width, float height, const glm::vec4& color);
     void drawRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness = 2.0f);
+    void drawLine(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float thickness = 1.0f);
     void drawText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
     
     // Screen dimensions
@@ -141,21 +234,25 @@ public:
     int getWidth() const { return screenWidth; }
     int getHeight() const { return screenHeight; }
     
+    // Canvas rebuilds so far
+    unsigned long long getRebuildCount() const { return rebuildCount; }
+    const TextLayoutCache& getTextLayouts() const { return textLayouts; }
+    
 private:
+    Renderer* renderer; // Not owned
     int screenWidth;
     int screenHeight;
     
-    // Shader for UI rendering
-    std::unique_ptr<Shader> uiShader;
-    
-    // Vertex array and buffer for quad rendering
-    GLuint VAO, VBO;
+    GlyphAtlas glyphAtlas;
+    TextLayoutCache textLayouts;
+    const Texture* fontTexture; // Bound to FONT_SLOT; null without text
+    UIGeometry buildGeometry; // Scratch for canvas rebuilds
+    UIGeometry frameGeometry; // Immediate-mode primitives of this frame
+    unsigned long long rebuildCount;
     
-    // Simple bitmap font rendering (TODO: Replace with proper font rendering)
-    void initSimpleFontRendering();
-    GLuint fontVAO, fontVBO;
+    // Append visible elements depth first and clear their dirty flags
+    void buildTree(UIElement& element);
     
-    void setupQuadBuffers();
 };
 
 #endif // UI_RENDERER_H
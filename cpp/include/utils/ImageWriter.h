@@ -0,0 +1,28 @@
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Image Writing Helpers
+ * Minimal dependency-free PNG encoder for screenshots and golden images
+ */
+namespace ImageWriter {
+    
+    // Encode 8-bit RGBA pixels (top row first, tightly packed) as a PNG.
+    // Uses stored (uncompressed) deflate blocks: larger files, but trivially
+    // fast and byte-for-byte deterministic, which is what golden images need.
+    bool encodePNG(int width, int height, const uint8_t* rgba, std::vector<uint8_t>& out);
+    
+    // Encode and write to disk; returns false on I/O failure
+    bool writePNG(const std::string& path, int width, int height, const uint8_t* rgba);
+    
+    // Checksums used by the PNG container (exposed for reuse by asset tools)
+    uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+    uint32_t adler32(const uint8_t* data, size_t length, uint32_t adler = 1);
+    
+} // namespace ImageWriter
+
+#endif // IMAGE_WRITER_H
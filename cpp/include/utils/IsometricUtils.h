@@ -18,10 +18,17 @@ namespace IsometricUtils {
     // Convert screen position to world grid coordinates
     glm::ivec2 screenToWorld(float screenX, float screenY, int tileWidth, int tileHeight);
     
+    // Sub-tile steps per unit of render order (so entities sort within a tile)
+    constexpr int RENDER_ORDER_STEPS = 16;
+    
     // Calculate rendering order for isometric tiles
-    // Returns a value used for depth sorting (back-to-front rendering)
+    // Returns a value used for depth sorting (back-to-front rendering):
+    // higher values are nearer the viewer and render later
     int getRenderOrder(int gridX, int gridY);
     
+    // Render order for float world positions (entities, tile centers)
+    int getRenderOrder(float worldX, float worldY);
+    
 } // namespace IsometricUtils
 
 #endif // ISOMETRIC_UTILS_H
@@ -7,10 +7,33 @@
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+
+// Least severe level compiled in (0 DEBUG ... 4 FATAL): everything unless
+// NDEBUG (release builds), which drops DEBUG. Define LOG_MIN_LEVEL to
+// override; LOG_* calls below it compile to nothing, message included.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
 
 /**
  * Logger System
- * Thread-safe logging system for capturing errors, warnings, and events
+ * Thread-safe asynchronous logging for capturing errors, warnings, and events.
+ *
+ * Callers push the raw message and its time into a bounded lock-free ring
+ * and return; a background thread formats the entries and writes them to
+ * the file and console in batches. ERROR and FATAL wake the writer at
+ * once; other levels wait for the next batch. When the ring is full a
+ * message is dropped and counted rather than stall the caller (ERROR and
+ * FATAL first wait up to URGENT_WAIT for room). If the log file can't be
+ * opened, messages go to the console only. A crash handler drains the
+ * ring before the process dies.
  */
 class Logger {
 public:
@@ -28,22 +51,33 @@ public:
     static Logger& getInstance();
 
     /**
-     * Initialize the logger with a log file path
+     * Initialize the logger with a log file path and start the writer thread.
+     * Returns false if the file can't be opened; logging then continues on
+     * the console only and is not retried
      */
     bool initialize(const std::string& logFilePath = "logs/engine.log");
 
     /**
      * Log a message
      */
-    void log(Level level, const std::string& message);
-    void debug(const std::string& message);
-    void info(const std::string& message);
-    void warning(const std::string& message);
-    void error(const std::string& message);
-    void fatal(const std::string& message);
+    void log(Level level, std::string message);
+    void debug(std::string message);
+    void info(std::string message);
+    void warning(std::string message);
+    void error(std::string message);
+    void fatal(std::string message);
+
+    /**
+     * Runtime level filter (on top of LOG_MIN_LEVEL); the LOG_* macros
+     * skip building messages below it
+     */
+    void setMinLevel(Level level) { minLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static bool isEnabled(Level level) {
+        return static_cast<int>(level) >= getInstance().minLevel.load(std::memory_order_relaxed);
+    }
 
     /**
-     * Flush logs to disk
+     * Write everything logged so far and flush it to disk (on the calling thread)
      */
     void flush();
 
@@ -65,15 +99,54 @@ public:
 private:
     Logger();
     ~Logger();
-    
+
     // Prevent copying
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    // Entries the ring holds (a power of two)
+    static constexpr size_t RING_CAPACITY = 8192;
+
+    // Longest an entry waits for the writer thread
+    static constexpr std::chrono::milliseconds WRITE_INTERVAL{ 50 };
+
+    // Longest ERROR/FATAL wait for room in a full ring before being dropped
+    static constexpr std::chrono::milliseconds URGENT_WAIT{ 200 };
+
+    using Clock = std::chrono::system_clock;
+
+    /**
+     * Ring slot. sequence says whose turn it is: equal to the push position
+     * when free, position + 1 once written (bounded MPMC queue scheme,
+     * used here with a single consumer)
+     */
+    struct Entry {
+        std::atomic<size_t> sequence;
+        Level level;
+        Clock::time_point time;
+        std::string message;
+    };
+
     std::ofstream logFile;
-    std::mutex logMutex;
-    bool initialized;
+    std::mutex logMutex; // Consumer side: the file, the ring's read position
+    std::atomic<bool> initialized;
     std::string sessionId;
+    std::atomic<int> minLevel;
+
+    std::unique_ptr<Entry[]> ring;
+    std::atomic<size_t> pushPosition;
+    std::atomic<size_t> popPosition; // Written under logMutex
+    std::atomic<size_t> droppedCount;
+
+    std::thread writerThread;
+    std::atomic<bool> running;
+    std::atomic<bool> wakeRequested;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    // Reused between batches by the consumer
+    std::string fileBatch;
+    std::string consoleBatch;
 
     /**
      * Generate a unique session ID
@@ -81,14 +154,70 @@ private:
     std::string generateSessionId();
 
     /**
-     * Write log entry to file and console
+     * Claim a slot and publish the entry; false when the ring is full
      */
-    void writeLog(Level level, const std::string& message);
+    bool tryPush(Level level, Clock::time_point time, std::string& message);
+
+    /**
+     * Ask the writer thread to drain now
+     */
+    void wakeWriter();
+
+    /**
+     * Writer thread: drain the ring every WRITE_INTERVAL or when woken
+     */
+    void writerLoop();
+
+    /**
+     * Format and write every published entry to file and console (logMutex held)
+     */
+    void drainLocked();
+
+    static std::string formatTimestamp(Clock::time_point time);
+
+    /**
+     * Drain what can be drained on a fatal signal or std::terminate
+     */
+    static void installCrashHandler();
+    static void handleCrash(int signal);
 };
 
-// Convenience macros for logging
-#define LOG_DEBUG(msg) Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) Logger::getInstance().info(msg)
-#define LOG_WARNING(msg) Logger::getInstance().warning(msg)
-#define LOG_ERROR(msg) Logger::getInstance().error(msg)
-#define LOG_FATAL(msg) Logger::getInstance().fatal(msg)
+// Convenience macros for logging. The message expression is only evaluated
+// when the level is enabled, so callers can build it freely.
+#define LOG_AT_LEVEL(level, msg) \
+    do { \
+        if (Logger::isEnabled(level)) { \
+            Logger::getInstance().log(level, msg); \
+        } \
+    } while (0)
+
+// Compiled-out levels still name the message (never evaluating it) so
+// variables only used for logging don't trigger unused warnings
+#define LOG_DISABLED(msg) \
+    do { \
+        if (false) { \
+            (void)(msg); \
+        } \
+    } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(msg) LOG_AT_LEVEL(Logger::Level::DEBUG, msg)
+#else
+#define LOG_DEBUG(msg) LOG_DISABLED(msg)
+#endif
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO(msg) LOG_AT_LEVEL(Logger::Level::INFO, msg)
+#else
+#define LOG_INFO(msg) LOG_DISABLED(msg)
+#endif
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(msg) LOG_AT_LEVEL(Logger::Level::WARNING, msg)
+#else
+#define LOG_WARNING(msg) LOG_DISABLED(msg)
+#endif
+#if LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(msg) LOG_AT_LEVEL(Logger::Level::ERROR, msg)
+#else
+#define LOG_ERROR(msg) LOG_DISABLED(msg)
+#endif
+#define LOG_FATAL(msg) LOG_AT_LEVEL(Logger::Level::FATAL, msg)
@@ -0,0 +1,194 @@
+#ifndef CHUNK_MESH_CACHE_H
+#define CHUNK_MESH_CACHE_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../rendering/RenderBackend.h"
+
+// Forward declarations
+class World;
+class Tile;
+class Texture;
+class TextureManager;
+class LightMap;
+class Renderer;
+class IsometricRenderer;
+class JobSystem;
+class DrawList;
+
+/**
+ * Chunk Mesh Cache
+ * Keeps the static part of the world cached per World::CHUNK_SIZE chunk:
+ * ground tiles as prebuilt backend geometry, decorations as a prebuilt
+ * sprite list that is fed to the frame's DrawList (decorations must depth
+ * sort against buildings and entities, so they can't be baked).
+ *
+ * Chunks are rebuilt only when marked dirty and only once they come into
+ * view. Rebuilds run on the job system; uploads happen on the calling
+ * (main) thread. Drawing a visible chunk's ground costs one draw call per
+ * batch of up to MAX_TEXTURE_SLOTS distinct textures - usually one.
+ *
+ * Zoomed out, a chunk is drawn as an impostor instead: one quad showing an
+ * offscreen image of its ground and decorations, rendered once and kept
+ * until the chunk is dirtied. Between IMPOSTOR_FADE_START and
+ * IMPOSTOR_FADE_END pixels of on-screen chunk width the impostor fades in
+ * over the full detail; below it replaces it, so the cost per chunk stays
+ * constant however far out the view goes. Impostors need a backend with
+ * render targets and draw under buildings and entities (their decorations
+ * no longer depth sort), which only shows at strategic zoom levels.
+ *
+ * Ground whose texture is evicted is built with the tile color instead
+ * (white texture-less quads would stand out), and rebuilt textured once
+ * the texture is back; drawing such a chunk keeps requesting the reload.
+ *
+ * With a LightMap, the chunks' light textures are multiplied over the
+ * ground and impostors (one quad per chunk, batched by texture slots)
+ * and decorations are tinted by the light of their tile.
+ */
+class ChunkMeshCache {
+public:
+    ChunkMeshCache(const World* world, TextureManager* textureManager);
+    ~ChunkMeshCache();
+    
+    // Job system used for rebuilds (not owned; may be null)
+    void setJobSystem(JobSystem* jobs) { jobSystem = jobs; }
+    
+    // Invalidate the chunk containing a tile, or everything
+    void markTileDirty(int x, int y);
+    void markAllDirty();
+    
+    // Rebuild visible dirty chunks, draw the ground of every visible chunk
+    // and add their decorations to drawList (skipped when null), lit by
+    // lightMap (unlit when null)
+    void render(Renderer* renderer, IsometricRenderer* isoRenderer, DrawList* drawList, LightMap* lightMap = nullptr);
+    
+    // Free all backend geometry (chunks rebuild on the next render)
+    void releaseGeometry();
+    
+    // Allow impostors for zoomed-out views (on by default)
+    void setImpostorsEnabled(bool enabled);
+    
+    // Statistics of the last render()
+    int getChunkCount() const { return static_cast<int>(chunks.size()); }
+    int getVisibleChunkCount() const { return lastVisibleChunks; }
+    int getRebuiltChunkCount() const { return lastRebuiltChunks; }
+    int getImpostorChunkCount() const { return lastImpostorChunks; }
+    int getImpostorRenderCount() const { return lastImpostorRenders; }
+    
+private:
+    // One draw call: geometry plus the textures its slots refer to
+    struct Batch {
+        RenderBackend::GeometryHandle geometry;
+        std::vector<const Texture*> textures;
+    };
+    
+    // CPU result of a rebuild, waiting for upload
+    struct BuildBatch {
+        std::vector<const Texture*> textures;
+        std::vector<QuadVertex> vertices;
+    };
+    
+    // A decoration sprite, ready for the draw list
+    struct Decoration {
+        glm::vec2 position;
+        glm::ivec2 tile;
+        int depth; // IsometricUtils::getRenderOrder of the tile center
+        const Texture* texture;
+    };
+    
+    struct Chunk {
+        std::vector<Batch> ground;
+        std::vector<BuildBatch> pendingGround;
+        std::vector<Decoration> decorations;
+        std::vector<const Texture*> missingGround; // Evicted ground textures, drawn as tile colors
+        glm::vec2 boundsMin; // World-space bounds of every quad the chunk can emit
+        glm::vec2 boundsMax;
+        bool dirty;
+        RenderBackend::RenderTargetHandle impostor;
+        int impostorWidth;      // Texture width of the impostor
+        bool impostorDirty;     // Impostor shows an older build of the chunk
+        uint64_t impostorFrame; // Last frame the impostor was drawn
+    };
+    
+    // Impostor texture width: the chunk's on-screen width rounded up to a
+    // power of two within these limits; the height follows the chunk's aspect
+    static constexpr int IMPOSTOR_MIN_WIDTH = 64;
+    static constexpr int IMPOSTOR_MAX_WIDTH = 512;
+    // On-screen chunk width in pixels: impostor only below the start (the
+    // texture is at least 1:1 there), full detail only above the end
+    static constexpr float IMPOSTOR_FADE_START = 512.0f;
+    static constexpr float IMPOSTOR_FADE_END = 768.0f;
+    // Impostors rendered per frame, spreading the cost of zooming out
+    static constexpr int MAX_IMPOSTOR_RENDERS = 8;
+    // Render target memory kept; the least recently drawn are recycled
+    static constexpr size_t MAX_IMPOSTOR_BYTES = 48 * 1024 * 1024;
+    // Decorations narrower than this on screen are skipped
+    static constexpr float MIN_DECORATION_PIXELS = 12.0f;
+    
+    const World* world; // Not owned
+    TextureManager* textureManager; // Not owned
+    JobSystem* jobSystem; // Not owned
+    RenderBackend* backend; // Backend that owns the geometry (not owned)
+    
+    int chunksX;
+    int chunksY;
+    std::vector<Chunk> chunks;
+    
+    // Tile size the meshes were built with; a change invalidates everything
+    int builtTileWidth;
+    int builtTileHeight;
+    
+    int lastVisibleChunks;
+    int lastRebuiltChunks;
+    
+    // TextureManager::getResidencyChanges() the chunks were checked against
+    uint64_t residencyChanges;
+    
+    bool impostorsEnabled;
+    size_t impostorBytes; // Render targets created, in use or free
+    std::vector<std::pair<int, RenderBackend::RenderTargetHandle>> freeImpostors; // Width, target
+    uint64_t frame;
+    int lastImpostorChunks;
+    int lastImpostorRenders;
+    
+    // Dirty the chunks whose ground was built with textures since evicted,
+    // or without textures since reloaded
+    void checkTextureResidency();
+    
+    // Build one chunk's ground vertices and decoration list (thread-safe per chunk)
+    void buildChunk(int index, int tileWidth, int tileHeight);
+    
+    // Move pending batches into backend geometry (main thread)
+    void uploadChunk(Chunk& chunk);
+    
+    // Render a chunk's current build into an impostor of the given width
+    // (main thread); false if no render target is available or a texture
+    // isn't resident
+    bool renderImpostor(Renderer* renderer, Chunk& chunk, int width);
+    
+    // Multiply the light textures of the visible chunks over what is drawn
+    void renderLight(Renderer* renderer, LightMap& lightMap, const std::vector<int>& visible);
+    
+    // Render target for an impostor: free, new or recycled
+    RenderBackend::RenderTargetHandle acquireImpostor(int width);
+    void releaseImpostors();
+    
+    // Impostor height and memory for a width, at the built tile size
+    int getImpostorHeight(int width) const;
+    size_t getImpostorBytes(int width) const;
+    
+    // Texture used for a tile's ground quad (null = colored tile)
+    const Texture* getGroundTexture(const Tile& tile) const;
+    
+    // Append a ground quad, opening a new batch when texture slots run out
+    static void appendQuad(
+        std::vector<BuildBatch>& batches,
+        const glm::vec2& position,
+        const glm::vec2& size,
+        const Texture* texture,
+        const glm::vec4& color
+    );
+};
+
+#endif // CHUNK_MESH_CACHE_H
@@ -0,0 +1,123 @@
+#ifndef LIGHT_MAP_H
+#define LIGHT_MAP_H
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Forward declarations
+class Texture;
+
+/**
+ * Light Map
+ * Per-tile light for the day/night cycle. Point lights (emitter tiles,
+ * e.g. lit buildings) spread by flood fill, losing one level per tile
+ * and stopped by opaque tiles; sunlight has nothing overhead to cast
+ * shadows, so it is one world-wide level mixed in when colors are
+ * composed. A tile shows the brighter of the two.
+ *
+ * Edits are incremental. A new or brighter light floods out from its
+ * tile only; a dimmed light or a new blocker first retracts the light
+ * that came through the tile, then refills the hole from the light
+ * around it. The work is bounded by the light radius (MAX_LIGHT tiles),
+ * never the world size, and changing the daylight only recolors.
+ *
+ * Each chunk has a small RGBA texture of its tiles' final colors (with a
+ * one-tile border from the neighbouring chunks, so filtering is seamless)
+ * that is recomposed lazily when something in it changed.
+ */
+class LightMap {
+public:
+    // Brightest light level; a light reaches MAX_LIGHT - 1 tiles
+    static constexpr int MAX_LIGHT = 15;
+    
+    LightMap(int width, int height, int chunkSize);
+    ~LightMap();
+    
+    // Light a tile emits, 0 to MAX_LIGHT (0 = none); opaque tiles can emit
+    void setEmitter(int x, int y, int level);
+    int getEmitter(int x, int y) const;
+    
+    // Opaque tiles block light
+    void setOpaque(int x, int y, bool opaque);
+    bool isOpaque(int x, int y) const;
+    
+    // Propagated point light of a tile, 0 to MAX_LIGHT
+    int getLevel(int x, int y) const;
+    
+    // Sunlight from 0 (night) to 1 (day), quantized so a slow cycle only
+    // recolors when the change is visible
+    void setDaylight(float daylight);
+    float getDaylight() const { return daylight; }
+    
+    // Full daylight outshines every light: nothing to draw
+    bool isFullyLit() const { return daylight >= 1.0f; }
+    
+    // Final color of a tile, for tinting sprites; opaque tiles take the
+    // brightest light next to them (their sides face the open tiles)
+    glm::vec3 getColor(int x, int y) const;
+    
+    // Light texture of a chunk, composed or updated when stale (main
+    // thread, GL context current). getTextureSize() texels square, bottom
+    // row first: texel (1 + i, 1 + j) is the chunk's tile (i, j) and the
+    // outer ring repeats the neighbouring tiles.
+    const Texture* getChunkTexture(int chunkX, int chunkY);
+    int getTextureSize() const { return chunkSize + 2; }
+    
+    // Free the textures (recreated on next use)
+    void releaseTextures();
+    
+    // Statistics: tiles visited by the last edit, chunk textures composed
+    int getLastUpdateTileCount() const { return lastUpdateTiles; }
+    unsigned long long getComposeCount() const { return composeCount; }
+    
+private:
+    struct Chunk {
+        std::unique_ptr<Texture> texture;
+        bool dirty; // Texture shows older levels or colors
+    };
+    
+    int width;
+    int height;
+    int chunkSize;
+    int chunksX;
+    int chunksY;
+    
+    std::vector<uint8_t> levels;   // Propagated light per tile
+    std::vector<uint8_t> emitters; // Light emitted per tile
+    std::vector<uint8_t> opaque;   // 1 where light is blocked
+    std::vector<Chunk> chunks;
+    
+    float daylight;
+    glm::vec3 palette[MAX_LIGHT + 1]; // Color of each level at this daylight
+    
+    // Work lists, kept to avoid allocating on every edit
+    std::vector<int> addQueue; // Tiles to spread light from
+    std::vector<std::pair<int, uint8_t>> removeQueue; // Tiles darkened, with their old level
+    std::vector<unsigned char> composeBuffer;
+    
+    int lastUpdateTiles;
+    unsigned long long composeCount;
+    
+    bool isValid(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    
+    // In-bounds 4-neighbours of a tile; returns how many
+    int getNeighbours(int index, int out[4]) const;
+    
+    // Change a tile's level and mark every chunk texture showing it
+    void setLevel(int index, int level);
+    
+    // Darken what was lit through a tile, queueing the light around the
+    // hole (and emitters in it) to refill it
+    void removeLight(int index);
+    
+    // Flood out from the queued tiles
+    void spreadLight();
+    
+    void updatePalette();
+    void composeChunk(int chunkX, int chunkY);
+};
+
+#endif // LIGHT_MAP_H
@@ -0,0 +1,107 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Uniform Spatial Hash
+ * Buckets points (entities, resource tiles) into square cells so proximity
+ * queries only touch nearby cells instead of scanning everything.
+ * Positions are in tile units; the default cell is one world chunk.
+ */
+class SpatialHash {
+public:
+    using Id = uint32_t;
+
+    static constexpr float DEFAULT_CELL_SIZE = 16.0f; // Matches World::CHUNK_SIZE
+
+    explicit SpatialHash(float cellSize = DEFAULT_CELL_SIZE);
+
+    // Insert an item (replaces the position if the id is already present)
+    void insert(Id id, const glm::vec2& position);
+
+    // Move an item. Only touches the buckets when the item changes cell.
+    // Returns true if the item was re-bucketed.
+    bool update(Id id, const glm::vec2& position);
+
+    // Remove an item
+    bool remove(Id id);
+
+    // Remove all items
+    void clear();
+
+    // Item queries
+    bool contains(Id id) const;
+    size_t size() const { return locations.size(); }
+    float getCellSize() const { return cellSize; }
+
+    // All items within radius of center (appended to out, unordered)
+    void queryRadius(const glm::vec2& center, float radius, std::vector<Id>& out) const;
+
+    // All items inside the axis-aligned rectangle [min, max] (appended to out)
+    void queryRect(const glm::vec2& min, const glm::vec2& max, std::vector<Id>& out) const;
+
+    // Up to k items closest to center, nearest first (appended to out).
+    // Items farther than maxRadius are ignored.
+    void queryNearest(const glm::vec2& center, size_t k, float maxRadius, std::vector<Id>& out) const;
+
+    // Radius query for many queriers at once. Results are written in CSR form:
+    // the hits for centers[i] are results[offsets[i]] .. results[offsets[i + 1] - 1].
+    // Queriers sharing a cell share the bucket scan, so this is much cheaper
+    // than issuing queryRadius() per querier for crowded scenes.
+    void queryRadiusBatch(
+        const std::vector<glm::vec2>& centers,
+        float radius,
+        std::vector<Id>& results,
+        std::vector<size_t>& offsets
+    ) const;
+
+    // Visit every occupied cell as visit(cellMin, cellMax, itemCount), in
+    // no particular order (debug views)
+    template <typename Visitor>
+    void forEachCell(Visitor&& visit) const {
+        for (const auto& cell : cells) {
+            if (cell.second.empty()) {
+                continue;
+            }
+            glm::vec2 cellMin(static_cast<float>(static_cast<int32_t>(cell.first >> 32)),
+                              static_cast<float>(static_cast<int32_t>(static_cast<uint32_t>(cell.first))));
+            cellMin *= cellSize;
+            visit(cellMin, cellMin + glm::vec2(cellSize), cell.second.size());
+        }
+    }
+
+private:
+    struct Entry {
+        Id id;
+        glm::vec2 position;
+    };
+
+    struct Location {
+        int64_t cellKey;
+        uint32_t index; // Index of the entry inside its cell bucket
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    std::unordered_map<int64_t, std::vector<Entry>> cells;
+    std::unordered_map<Id, Location> locations;
+
+    // Cell coordinate helpers
+    int cellCoord(float value) const;
+    static int64_t makeKey(int cellX, int cellY);
+    int64_t keyFor(const glm::vec2& position) const;
+
+    // Swap-remove an entry from its bucket, fixing up the moved entry's location
+    void eraseFromCell(int64_t cellKey, uint32_t index);
+
+    // Visit every entry in the cells overlapping [min, max]
+    template <typename Visitor>
+    void forEachInCells(const glm::vec2& min, const glm::vec2& max, Visitor&& visit) const;
+};
+
+#endif // SPATIAL_HASH_H
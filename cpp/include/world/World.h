@@ -5,6 +5,9 @@
 #include <memory>
 #include "Tile.h"
 #include "Biome.h"
+#include "SpatialHash.h"
+#include "ChunkMeshCache.h"
+#include "LightMap.h"
 #include "../utils/NoiseGenerator.h"
 
 // Forward declarations
@@ -13,6 +16,8 @@ class IsometricRenderer;
 class Camera;
 class Texture;
 class TextureManager;
+class JobSystem;
+class DrawList;
 
 /**
  * World Management
@@ -20,17 +25,23 @@ class TextureManager;
  */
 class World {
 public:
+    // Side length (in tiles) of a world chunk
+    static constexpr int CHUNK_SIZE = 16;
+    
+    // Seconds of a full day/night cycle
+    static constexpr float DAY_LENGTH = 240.0f;
+    
     World(int width, int height, TextureManager* textureManager = nullptr);
     ~World();
     
     // Initialize world with procedural generation
     void generate();
     
-    // Update world
+    // Update world (advances the time of day)
     void update(float deltaTime);
     
-    // Render world
-    void render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera);
+    // Render world: ground is drawn now, decorations are queued in drawList
+    void render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera, DrawList& drawList);
     
     // Get tile at grid position
     Tile* getTile(int x, int y);
@@ -43,6 +54,40 @@ public:
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     
+    // Resource queries (tiles with Tile::isResource)
+    // Appends the grid positions of resources within radius tiles of center
+    void queryResources(const glm::vec2& center, float radius, std::vector<glm::ivec2>& out) const;
+    
+    // Nearest resource within maxRadius; returns false if there is none
+    bool findNearestResource(const glm::vec2& center, float maxRadius, glm::ivec2& outTile) const;
+    
+    // Clear a resource decoration (e.g. after gathering) and drop it from the index
+    bool removeResource(int x, int y);
+    
+    // Spatial index of resource tiles (positioned at tile centers)
+    const SpatialHash& getResourceIndex() const { return resourceIndex; }
+    
+    // Job system used to parallelize generation and chunk rebuilds (not owned; may be null)
+    void setJobSystem(JobSystem* jobs);
+    
+    // Call after changing how a tile looks (type, variation, decoration)
+    // through getTile(), so its cached chunk geometry is rebuilt
+    void markTileDirty(int x, int y);
+    
+    // Rebuild every chunk when next seen (e.g. once streamed textures arrive)
+    void markAllDirty();
+    
+    // Cached static geometry of the ground and decorations
+    const ChunkMeshCache& getChunkMeshes() const { return *chunkMeshes; }
+    
+    // Tile lighting; buildings register their lights and blockers here
+    LightMap& getLightMap() { return *lightMap; }
+    const LightMap& getLightMap() const { return *lightMap; }
+    
+    // Time of day in [0, 1): 0 is midnight, 0.5 noon
+    void setTimeOfDay(float time);
+    float getTimeOfDay() const { return timeOfDay; }
+    
     // Load world from scene file
     bool loadFromFile(const char* filename);
     
@@ -56,6 +101,11 @@ private:
     std::vector<std::vector<std::unique_ptr<Biome>>> biomeMap;
     std::unique_ptr<NoiseGenerator> noiseGen;
     TextureManager* textureManager; // Not owned by World
+    JobSystem* jobSystem; // Not owned by World
+    SpatialHash resourceIndex;
+    std::unique_ptr<ChunkMeshCache> chunkMeshes;
+    std::unique_ptr<LightMap> lightMap;
+    float timeOfDay;
     
     // Generate biome map using noise
     void generateBiomeMap();
@@ -66,6 +116,13 @@ private:
     // Generate decorations (trees, rocks, bushes) using noise for distribution
     void generateDecorations();
     
+    // Rebuild the resource index from the current tiles
+    void rebuildResourceIndex();
+    
+    // Helper: tile <-> spatial hash id conversion
+    SpatialHash::Id tileId(int x, int y) const { return static_cast<SpatialHash::Id>(y * width + x); }
+    glm::ivec2 tileFromId(SpatialHash::Id id) const;
+    
     // Helper: Get biome type from noise values
     BiomeType getBiomeFromNoise(float temperature, float moisture) const;
 };
@@ -23,6 +23,7 @@ void Building::initializeFromType() {
             width = 2;
             height = 2;
             buildHeight = 40.0f;
+            lightLevel = 10;
             topColor = glm::vec4(0.8f, 0.2f, 0.2f, 1.0f);
             leftColor = glm::vec4(0.6f, 0.15f, 0.15f, 1.0f);
             rightColor = glm::vec4(0.7f, 0.17f, 0.17f, 1.0f);
@@ -32,6 +33,7 @@ void Building::initializeFromType() {
             width = 1;
             height = 1;
             buildHeight = 80.0f;
+            lightLevel = 14;
             topColor = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
             leftColor = glm::vec4(0.3f, 0.3f, 0.3f, 1.0f);
             rightColor = glm::vec4(0.4f, 0.4f, 0.4f, 1.0f);
@@ -41,6 +43,7 @@ void Building::initializeFromType() {
             width = 3;
             height = 3;
             buildHeight = 30.0f;
+            lightLevel = 6;
             topColor = glm::vec4(0.6f, 0.4f, 0.2f, 1.0f);
             leftColor = glm::vec4(0.45f, 0.3f, 0.15f, 1.0f);
             rightColor = glm::vec4(0.52f, 0.35f, 0.17f, 1.0f);
@@ -1,5 +1,6 @@
 #include "building/BuildingSystem.h"
 #include "world/World.h"
+#include "world/LightMap.h"
 #include "rendering/Renderer.h"
 #include "rendering/IsometricRenderer.h"
 #include <iostream>
@@ -14,18 +15,32 @@ void BuildingSystem::update(float deltaTime) {
     (void)deltaTime; // Unused - reserved for future construction progress
 }
 
-void BuildingSystem::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera) {
-    (void)renderer; // Unused - using isoRenderer for rendering
+void BuildingSystem::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera, DrawList& drawList) {
     (void)camera; // Unused - camera handled by renderer
-    // Render all buildings
+    
+    // Render buildings in view (cube faces span the tile and its height)
+    glm::vec2 viewMin(0.0f);
+    glm::vec2 viewMax(0.0f);
+    renderer->getVisibleBounds(viewMin, viewMax);
+    const float tileWidth = static_cast<float>(isoRenderer->getTileWidth());
+    const float tileHeight = static_cast<float>(isoRenderer->getTileHeight());
+    const LightMap& lightMap = world->getLightMap();
     for (const auto& building : buildings) {
-        isoRenderer->drawIsometricCube(
+        glm::vec2 basePos = isoRenderer->gridToScreen(building->getX(), building->getY());
+        if (basePos.x + tileWidth < viewMin.x || basePos.x > viewMax.x ||
+            basePos.y + tileHeight < viewMin.y || basePos.y - building->getBuildHeight() > viewMax.y) {
+            continue;
+        }
+        
+        glm::vec4 light(lightMap.getColor(building->getX(), building->getY()), 1.0f);
+        isoRenderer->addIsometricCube(
+            drawList,
             building->getX(),
             building->getY(),
             building->getBuildHeight(),
-            building->getTopColor(),
-            building->getLeftColor(),
-            building->getRightColor()
+            building->getTopColor() * light,
+            building->getLeftColor() * light,
+            building->getRightColor() * light
         );
     }
 }
@@ -41,6 +56,7 @@ bool BuildingSystem::placeBuilding(int x, int y, BuildingType type) {
     
     // Mark tiles as occupied
     markTilesOccupied(x, y, building->getWidth(), building->getHeight(), true);
+    world->getLightMap().setEmitter(x, y, building->getLightLevel());
     
     buildings.push_back(std::move(building));
     
@@ -87,6 +103,7 @@ bool BuildingSystem::removeBuilding(int x, int y) {
     for (auto it = buildings.begin(); it != buildings.end(); ++it) {
         if ((*it)->getX() == x && (*it)->getY() == y) {
             // Mark tiles as unoccupied
+            world->getLightMap().setEmitter(x, y, 0);
             markTilesOccupied(x, y, (*it)->getWidth(), (*it)->getHeight(), false);
             
             buildings.erase(it);
@@ -115,11 +132,13 @@ bool BuildingSystem::areTilesAvailable(int x, int y, int width, int height) cons
 }
 
 void BuildingSystem::markTilesOccupied(int x, int y, int width, int height, bool occupied) {
+    LightMap& lightMap = world->getLightMap();
     for (int dy = 0; dy < height; ++dy) {
         for (int dx = 0; dx < width; ++dx) {
             Tile* tile = world->getTile(x + dx, y + dy);
             if (tile) {
                 tile->setOccupied(occupied);
+                lightMap.setOpaque(x + dx, y + dy, occupied); // Buildings block light
             }
         }
     }
@@ -1,16 +1,37 @@
 #include "engine/Engine.h"
+#include "engine/Profiler.h"
 #include "rendering/Renderer.h"
+#include "rendering/OpenGLBackend.h"
+#include "rendering/RecordingBackend.h"
+#include "rendering/SoftwareBackend.h"
+#include "rendering/Texture.h"
 #include "rendering/Camera.h"
 #include "game/Game.h"
 #include "utils/Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
 
 Engine::Engine(int width, int height, const char* title)
     : window(nullptr)
     , width(width)
     , height(height)
     , title(title)
+    , headless(false)
+    , headlessRendering(HeadlessRendering::None)
     , game(nullptr)
+    , tickRate(DEFAULT_TICK_RATE)
+    , fixedDeltaTime(1.0f / DEFAULT_TICK_RATE)
+    , maxCatchUpSteps(DEFAULT_MAX_CATCH_UP_STEPS)
+    , accumulator(0.0)
+    , interpolationAlpha(0.0f)
+    , tickCount(0)
+    , droppedTickCount(0)
+    , sceneTarget(RenderBackend::INVALID_TARGET)
+    , sceneTargetSize(0, 0)
 {
 }
 
@@ -21,6 +42,37 @@ Engine::~Engine() {
 bool Engine::initialize() {
     LOG_INFO("Initializing engine...");
     
+    if (headless) {
+        // Simulation-only systems; nothing here may touch GLFW or GL
+        jobSystem = std::make_unique<JobSystem>();
+        time = std::make_unique<Time>();
+        camera = std::make_unique<Camera>(0.0f, 0.0f);
+        
+        // No GL context: any texture loaded from here on stays in memory
+        Texture::setCpuOnly(true);
+        
+        // Optional GPU-free rendering
+        if (headlessRendering == HeadlessRendering::Recording) {
+            renderBackend = std::make_unique<RecordingBackend>();
+        } else if (headlessRendering == HeadlessRendering::Software) {
+            renderBackend = std::make_unique<SoftwareBackend>(width, height, jobSystem.get());
+        }
+        
+        if (renderBackend) {
+            if (!renderBackend->initialize()) {
+                LOG_ERROR("Failed to initialize headless render backend");
+                return false;
+            }
+            renderer = std::make_unique<Renderer>(renderBackend.get());
+            renderer->initialize();
+        }
+        
+        LOG_INFO(std::string("Engine initialized in headless mode (no window, ") +
+                 (renderBackend ? renderBackend->getName() : "null") + " renderer)");
+        std::cout << "Engine initialized in headless mode" << std::endl;
+        return true;
+    }
+    
     // Initialize GLFW and create window
     if (!initWindow()) {
         LOG_ERROR("Failed to initialize window");
@@ -36,12 +88,21 @@ bool Engine::initialize() {
     LOG_INFO("OpenGL initialized successfully");
     
     // Create core systems
+    jobSystem = std::make_unique<JobSystem>();
     time = std::make_unique<Time>();
     input = std::make_unique<Input>(window);
     camera = std::make_unique<Camera>(0.0f, 0.0f);
-    renderer = std::make_unique<Renderer>();
+    renderBackend = std::make_unique<OpenGLBackend>();
+    renderer = std::make_unique<Renderer>(renderBackend.get());
     LOG_INFO("Core systems created");
     
+    // Initialize render backend
+    if (!renderBackend->initialize()) {
+        LOG_ERROR("Failed to initialize render backend");
+        std::cerr << "Failed to initialize render backend" << std::endl;
+        return false;
+    }
+    
     // Initialize renderer
     if (!renderer->initialize()) {
         LOG_ERROR("Failed to initialize renderer");
@@ -64,51 +125,74 @@ void Engine::run() {
         return;
     }
     
-    LOG_INFO("Starting game loop");
+    LOG_INFO("Starting game loop (simulation at " + std::to_string(static_cast<int>(tickRate)) + " Hz)");
+    PROFILE_THREAD_NAME("Main");
     
     // Main game loop
     int frameCount = 0;
+    accumulator = 0.0;
     try {
         while (!shouldClose()) {
             frameCount++;
             
             try {
+                PROFILE_SCOPE("Frame");
+                
                 // Update time
                 time->update();
                 float deltaTime = time->getDeltaTime();
                 
+                // Finish work that background jobs handed back to the main thread
+                {
+                    PROFILE_SCOPE("Engine::pumpMainThreadJobs");
+                    jobSystem->pumpMainThreadJobs();
+                }
+                
                 // Update camera
                 camera->update(deltaTime);
                 
-                // Update game
-                game->update(deltaTime);
-                
-                // Render
-                renderer->beginFrame();
-                renderer->clear(0.1f, 0.1f, 0.15f, 1.0f);
+                // Per-frame input (edge-triggered keys must not be lost or
+                // repeated when a frame runs zero or several ticks)
+                {
+                    PROFILE_SCOPE("Game::handleInput");
+                    game->handleInput(deltaTime);
+                }
                 
-                // Set view and projection matrices
-                renderer->setViewMatrix(camera->getViewMatrix());
-                renderer->setProjectionMatrix(camera->getProjectionMatrix(
-                    static_cast<float>(width), 
-                    static_cast<float>(height)
-                ));
+                // Advance the simulation in fixed steps
+                double simulationStart = Time::getCurrentTime();
+                stepSimulation(deltaTime);
                 
-                // Render game
-                game->render();
+                // Render game, interpolating between the last two ticks
+                double renderStart = Time::getCurrentTime();
+                time->recordPhase(Time::Phase::Simulation, static_cast<float>((renderStart - simulationStart) * 1000.0));
+                renderFrame(interpolationAlpha);
+                time->recordPhase(Time::Phase::Render, static_cast<float>((Time::getCurrentTime() - renderStart) * 1000.0));
                 
-                renderer->endFrame();
+                // Steer the resolution by GPU time when the backend measures
+                // it (that is what resolution changes), else CPU render time
+                if (dynamicResolution.isEnabled()) {
+                    float renderTime = renderBackend->getGpuFrameTime();
+                    if (renderTime <= 0.0f) {
+                        renderTime = static_cast<float>((Time::getCurrentTime() - renderStart) * 1000.0);
+                    }
+                    dynamicResolution.update(deltaTime * 1000.0f, renderTime);
+                }
                 
                 // Update input (at end of frame)
                 input->update();
                 
-                // Swap buffers
+                // Swap buffers (waits for vsync)
+                PROFILE_SCOPE("Engine::swapBuffers");
+                double presentStart = Time::getCurrentTime();
                 glfwSwapBuffers(window);
+                time->recordPhase(Time::Phase::Present, static_cast<float>((Time::getCurrentTime() - presentStart) * 1000.0));
             } catch (const std::exception& e) {
                 LOG_ERROR(std::string("Error in game loop (frame ") + std::to_string(frameCount) + "): " + e.what());
                 std::cerr << "Error in game loop: " << e.what() << std::endl;
                 // Continue running but log the error
             }
+            
+            PROFILE_END_FRAME();
         }
     } catch (const std::exception& e) {
         LOG_FATAL(std::string("Fatal error in game loop: ") + e.what());
@@ -116,7 +200,294 @@ void Engine::run() {
         throw;
     }
     
-    LOG_INFO("Game loop ended normally");
+    LOG_INFO("Game loop ended normally (" + std::to_string(tickCount) + " ticks, " +
+             std::to_string(droppedTickCount) + " dropped)");
+    time->logFrameStats();
+    reportDynamicResolution();
+}
+
+void Engine::renderFrame(float alpha) {
+    PROFILE_SCOPE("Engine::renderFrame");
+    renderer->beginFrame();
+    
+    // Dynamic resolution: below full size the world goes into the scene
+    // target at a fraction of the window size (the camera still covers the
+    // same world area); at full size it skips the extra pass
+    glm::ivec2 sceneSize = dynamicResolution.getRenderSize(width, height);
+    const bool scaled = sceneSize != glm::ivec2(width, height) && prepareSceneTarget();
+    if (scaled) {
+        renderBackend->setRenderTarget(sceneTarget);
+        renderBackend->setViewport(0, 0, sceneSize.x, sceneSize.y);
+    } else {
+        sceneSize = glm::ivec2(width, height);
+    }
+    renderer->clear(0.1f, 0.1f, 0.15f, 1.0f);
+    
+    // Set view and projection matrices
+    renderer->setViewportSize(sceneSize.x, sceneSize.y);
+    renderer->setViewMatrix(camera->getViewMatrix());
+    renderer->setProjectionMatrix(camera->getProjectionMatrix(
+        static_cast<float>(width), 
+        static_cast<float>(height)
+    ));
+    
+    game->render(alpha);
+    
+    const float screenWidth = static_cast<float>(width);
+    const float screenHeight = static_cast<float>(height);
+    renderer->setViewMatrix(glm::mat4(1.0f));
+    if (scaled) {
+        // Stretch the used corner over the window (bilinear). The scene is
+        // opaque but its alpha isn't, so copy without blending.
+        renderBackend->setRenderTarget(RenderBackend::INVALID_TARGET);
+        renderBackend->enableBlending(false);
+        renderer->setProjectionMatrix(glm::ortho(0.0f, screenWidth, 0.0f, screenHeight, -1.0f, 1.0f));
+        renderer->drawQuad(
+            glm::vec2(0.0f), glm::vec2(screenWidth, screenHeight),
+            renderBackend->getRenderTargetTexture(sceneTarget), glm::vec4(1.0f), 0.0f,
+            glm::vec2(0.0f), glm::vec2(sceneSize) / glm::vec2(sceneTargetSize)
+        );
+        renderBackend->enableBlending(true);
+    }
+    
+    // UI at native resolution, in window pixels (origin top-left like the mouse)
+    renderer->setViewportSize(width, height);
+    renderer->setProjectionMatrix(glm::ortho(0.0f, screenWidth, screenHeight, 0.0f, -1.0f, 1.0f));
+    game->renderUI();
+    
+    renderer->endFrame();
+}
+
+bool Engine::prepareSceneTarget() {
+    if (sceneTarget != RenderBackend::INVALID_TARGET && sceneTargetSize == glm::ivec2(width, height)) {
+        return true;
+    }
+    
+    if (sceneTarget != RenderBackend::INVALID_TARGET) {
+        renderBackend->destroyRenderTarget(sceneTarget);
+    }
+    sceneTarget = renderBackend->createRenderTarget(width, height);
+    sceneTargetSize = glm::ivec2(width, height);
+    if (sceneTarget == RenderBackend::INVALID_TARGET) {
+        LOG_WARNING(std::string("Dynamic resolution needs render targets, which the ") +
+                    renderBackend->getName() + " backend lacks; rendering at native resolution");
+        dynamicResolution.setEnabled(false);
+        return false;
+    }
+    return true;
+}
+
+unsigned long long Engine::runHeadless(unsigned long long maxTicks, double maxSeconds) {
+    if (!game) {
+        LOG_ERROR("No game instance set!");
+        std::cerr << "No game instance set!" << std::endl;
+        return 0;
+    }
+    
+    if (maxTicks == 0 && maxSeconds <= 0.0) {
+        LOG_WARNING("Headless run has no tick or time limit; defaulting to 1000 ticks");
+        maxTicks = 1000;
+    }
+    
+    LOG_INFO("Starting headless run (" +
+             (maxTicks > 0 ? std::to_string(maxTicks) + " ticks" : std::string("no tick limit")) + ", " +
+             (maxSeconds > 0.0 ? std::to_string(maxSeconds) + " s" : std::string("no time limit")) + ")");
+    
+    std::vector<float> tickTimes;
+    tickTimes.reserve(maxTicks > 0 ? static_cast<size_t>(maxTicks) : 4096);
+    std::vector<float> renderTimes;
+    if (renderer) {
+        renderTimes.reserve(tickTimes.capacity());
+    }
+    
+    // Ticks run back to back: the goal is throughput and timing data, not real time
+    PROFILE_THREAD_NAME("Main");
+    const double startTime = Time::getCurrentTime();
+    unsigned long long ticks = 0;
+    
+    while (maxTicks == 0 || ticks < maxTicks) {
+        double tickStart = Time::getCurrentTime();
+        if (maxSeconds > 0.0 && tickStart - startTime >= maxSeconds) {
+            break;
+        }
+        
+        // Jobs may still hand work back to the "main" thread without a window
+        jobSystem->pumpMainThreadJobs();
+        
+        try {
+            PROFILE_SCOPE("Engine::tick");
+            game->update(fixedDeltaTime);
+        } catch (const std::exception& e) {
+            LOG_ERROR(std::string("Error in headless tick ") + std::to_string(ticks) + ": " + e.what());
+            std::cerr << "Error in headless tick: " << e.what() << std::endl;
+        }
+        
+        double tickEnd = Time::getCurrentTime();
+        tickTimes.push_back(static_cast<float>((tickEnd - tickStart) * 1000.0));
+        ++ticks;
+        ++tickCount;
+        
+        // One recorded frame per tick (render time is kept out of the tick stats)
+        if (renderer) {
+            renderFrame(1.0f);
+            double renderEnd = Time::getCurrentTime();
+            renderTimes.push_back(static_cast<float>((renderEnd - tickEnd) * 1000.0));
+            if (dynamicResolution.isEnabled()) {
+                dynamicResolution.update(static_cast<float>((renderEnd - tickStart) * 1000.0), renderTimes.back());
+            }
+        }
+        
+        // Each tick is a profiler frame
+        PROFILE_END_FRAME();
+    }
+    
+    reportTickStatistics(tickTimes, Time::getCurrentTime() - startTime);
+    reportRenderStatistics(renderTimes);
+    reportDynamicResolution();
+    
+    if (!screenshotPath.empty()) {
+        if (renderBackend && renderBackend->getType() == RenderBackendType::Software) {
+            static_cast<SoftwareBackend*>(renderBackend.get())->saveScreenshot(screenshotPath);
+        } else {
+            LOG_WARNING("Screenshots need the software renderer (--software-render)");
+        }
+    }
+    return ticks;
+}
+
+void Engine::reportTickStatistics(std::vector<float>& tickTimes, double wallSeconds) const {
+    if (tickTimes.empty()) {
+        LOG_INFO("Headless run finished without simulating any ticks");
+        return;
+    }
+    
+    double total = 0.0;
+    for (float t : tickTimes) {
+        total += t;
+    }
+    
+    // Sorted copy for percentiles; the run is over so reorder in place
+    std::sort(tickTimes.begin(), tickTimes.end());
+    auto percentile = [&tickTimes](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(tickTimes.size() - 1) + 0.5);
+        return tickTimes[index];
+    };
+    
+    const size_t count = tickTimes.size();
+    const double simulatedSeconds = static_cast<double>(count) * fixedDeltaTime;
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "Headless run: " << count << " ticks in " << wallSeconds << " s wall ("
+       << simulatedSeconds << " s simulated, "
+       << std::setprecision(1) << (wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0) << "x real time)";
+    LOG_INFO(ss.str());
+    std::cout << ss.str() << std::endl;
+    
+    ss.str("");
+    ss << std::fixed << std::setprecision(4)
+       << "Tick time (ms): min " << tickTimes.front()
+       << ", avg " << (total / static_cast<double>(count))
+       << ", p50 " << percentile(0.50)
+       << ", p99 " << percentile(0.99)
+       << ", max " << tickTimes.back()
+       << " (budget " << (fixedDeltaTime * 1000.0f) << ")";
+    LOG_INFO(ss.str());
+    std::cout << ss.str() << std::endl;
+}
+
+void Engine::reportRenderStatistics(std::vector<float>& renderTimes) const {
+    if (renderTimes.empty()) {
+        return;
+    }
+    
+    double total = 0.0;
+    for (float t : renderTimes) {
+        total += t;
+    }
+    std::sort(renderTimes.begin(), renderTimes.end());
+    size_t p99Index = static_cast<size_t>(0.99 * static_cast<double>(renderTimes.size() - 1) + 0.5);
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4)
+       << "Render time (ms, " << renderBackend->getName() << " backend): min " << renderTimes.front()
+       << ", avg " << (total / static_cast<double>(renderTimes.size()))
+       << ", p99 " << renderTimes[p99Index]
+       << ", max " << renderTimes.back();
+    LOG_INFO(ss.str());
+    std::cout << ss.str() << std::endl;
+    
+    if (renderBackend && renderBackend->getType() == RenderBackendType::Recording) {
+        const RecordingBackend* recorder = static_cast<const RecordingBackend*>(renderBackend.get());
+        const RecordingBackend::Counters& frame = recorder->getFrameCounters();
+        
+        ss.str("");
+        ss << std::fixed << std::setprecision(1)
+           << "Last frame: " << frame.drawCalls << " draw calls, " << frame.quads << " quads ("
+           << frame.quadsPerDrawCall() << " per draw), " << frame.textureBinds << " texture binds ("
+           << frame.redundantTextureBinds << " redundant), " << frame.stateChanges << " state changes, "
+           << frame.instancedQuads << " instanced quads, " << (frame.uploadBytes / 1024.0) << " KB uploaded, "
+           << recorder->getTotalCounters().geometryUploads << " static geometry uploads overall";
+        LOG_INFO(ss.str());
+        std::cout << ss.str() << std::endl;
+    }
+}
+
+void Engine::reportDynamicResolution() const {
+    if (!dynamicResolution.isEnabled()) {
+        return;
+    }
+    
+    DynamicResolution::Stats stats = dynamicResolution.getStats();
+    glm::ivec2 renderSize = dynamicResolution.getRenderSize(width, height);
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "Dynamic resolution: scale " << stats.scale << " (" << renderSize.x << "x" << renderSize.y
+       << ", min " << stats.minScale << " over the last "
+       << DynamicResolution::HISTORY_SIZE << " frames, " << stats.scaleChanges << " changes), frame time avg "
+       << stats.averageFrameTime << " ms, max " << stats.maxFrameTime << " ms, render avg "
+       << stats.averageRenderTime << " ms (target " << stats.targetFrameTime << ")";
+    LOG_INFO(ss.str());
+    std::cout << ss.str() << std::endl;
+}
+
+void Engine::setTickRate(float ticksPerSecond) {
+    if (ticksPerSecond <= 0.0f) {
+        LOG_WARNING("Ignoring invalid tick rate: " + std::to_string(ticksPerSecond));
+        return;
+    }
+    
+    tickRate = ticksPerSecond;
+    fixedDeltaTime = 1.0f / ticksPerSecond;
+}
+
+void Engine::stepSimulation(float frameTime) {
+    PROFILE_SCOPE("Engine::stepSimulation");
+    
+    // Spiral-of-death guard: a long stall (debugger, window drag, disk hitch)
+    // must not queue up seconds of simulation
+    if (frameTime > MAX_FRAME_TIME) {
+        frameTime = MAX_FRAME_TIME;
+    }
+    accumulator += frameTime;
+    
+    int steps = 0;
+    while (accumulator >= fixedDeltaTime && steps < maxCatchUpSteps) {
+        game->update(fixedDeltaTime);
+        accumulator -= fixedDeltaTime;
+        ++steps;
+        ++tickCount;
+    }
+    
+    // Still behind after the catch-up budget: drop whole ticks so the
+    // simulation slows down instead of falling further behind every frame
+    if (accumulator >= fixedDeltaTime) {
+        double dropped = std::floor(accumulator / fixedDeltaTime);
+        droppedTickCount += static_cast<unsigned long long>(dropped);
+        accumulator -= dropped * fixedDeltaTime;
+    }
+    
+    interpolationAlpha = static_cast<float>(accumulator / fixedDeltaTime);
 }
 
 void Engine::shutdown() {
@@ -127,16 +498,24 @@ void Engine::shutdown() {
     }
     
     renderer.reset();
+    sceneTarget = RenderBackend::INVALID_TARGET; // Freed with the backend
+    renderBackend.reset();
     camera.reset();
     input.reset();
     time.reset();
     
+    // Joins the workers; anything still queued for the main thread is dropped
+    jobSystem.reset();
+    
     if (window) {
         glfwDestroyWindow(window);
         window = nullptr;
     }
     
-    glfwTerminate();
+    // GLFW was never initialized in headless mode
+    if (!headless) {
+        glfwTerminate();
+    }
     LOG_INFO("Engine shutdown complete");
 }
 
@@ -158,7 +537,7 @@ bool Engine::initWindow() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    
+
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
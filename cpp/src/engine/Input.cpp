@@ -9,6 +9,7 @@ Input::Input(GLFWwindow* window)
     , mousePosition(0.0f, 0.0f)
     , prevMousePosition(0.0f, 0.0f)
     , mouseDelta(0.0f, 0.0f)
+    , scrollDelta(0.0f)
 {
     // Initialize arrays
     std::memset(keyStates, 0, sizeof(keyStates));
@@ -23,6 +24,7 @@ Input::Input(GLFWwindow* window)
     glfwSetKeyCallback(window, keyCallback);
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
     glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetScrollCallback(window, scrollCallback);
 }
 
 void Input::update() {
@@ -34,6 +36,9 @@ void Input::update() {
     mouseDelta = mousePosition - prevMousePosition;
     prevMousePosition = mousePosition;
     
+    // Scroll events arrive during polling
+    scrollDelta = 0.0f;
+    
     // Poll events
     glfwPollEvents();
 }
@@ -102,3 +107,10 @@ void Input::cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
     if (!instance) return;
     instance->mousePosition = glm::vec2(static_cast<float>(xpos), static_cast<float>(ypos));
 }
+
+void Input::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    (void)window; // Unused - accessing instance
+    (void)xoffset; // Unused - no horizontal scrolling
+    if (!instance) return;
+    instance->scrollDelta += static_cast<float>(yoffset);
+}
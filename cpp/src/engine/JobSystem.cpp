@@ -0,0 +1,415 @@
+#include "engine/JobSystem.h"
+#include "engine/Profiler.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    // Queue slot of the calling thread; 0 for the main thread and any thread
+    // the job system did not create
+    thread_local unsigned tlsQueueIndex = 0;
+    thread_local const void* tlsOwner = nullptr;
+
+    // Cheap per-thread xorshift for picking steal victims
+    unsigned nextRandom() {
+        thread_local unsigned state = static_cast<unsigned>(
+            std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : mainThreadId(std::this_thread::get_id())
+    , pendingJobs(0)
+    , stopping(false)
+{
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    queues.reserve(workerCount + 1);
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+
+    LOG_INFO("Job system started with " + std::to_string(workerCount) + " worker threads");
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping.store(true);
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned JobSystem::currentQueueIndex() const {
+    return tlsOwner == this ? tlsQueueIndex : 0;
+}
+
+void JobSystem::run(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    WorkQueue& queue = *queues[currentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(QueuedJob{std::move(job), counter});
+    }
+
+    pendingJobs.fetch_add(1, std::memory_order_release);
+
+    // Take the lock so a worker between its predicate check and wait() can't miss this
+    { std::lock_guard<std::mutex> lock(wakeMutex); }
+    wakeCondition.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    unsigned queueIndex = currentQueueIndex();
+    bool onMainThread = isMainThread();
+
+    while (!counter.isDone()) {
+        // Keep main-thread jobs flowing so workers waiting on them can't deadlock us
+        if (onMainThread && pumpMainThreadJobs(1) > 0) {
+            continue;
+        }
+        if (!tryRunOneJob(queueIndex, &counter)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelForChunks(size_t begin, size_t end, size_t grainSize, const RangeJob& body) {
+    if (begin >= end) {
+        return;
+    }
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    // Small ranges aren't worth the scheduling overhead
+    if (end - begin <= grainSize) {
+        body(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize) {
+        size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+        run([&body, chunkBegin, chunkEnd]() { body(chunkBegin, chunkEnd); }, &counter);
+    }
+    wait(counter);
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t)>& body) {
+    parallelForChunks(begin, end, grainSize, [&body](size_t chunkBegin, size_t chunkEnd) {
+        for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+            body(i);
+        }
+    });
+}
+
+void JobSystem::runOnMainThread(Job job, JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    mainThreadJobs.push_back(QueuedJob{std::move(job), counter});
+}
+
+size_t JobSystem::pumpMainThreadJobs(size_t maxJobs) {
+    size_t executed = 0;
+
+    while (executed < maxJobs) {
+        QueuedJob job;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            if (mainThreadJobs.empty()) {
+                break;
+            }
+            job = std::move(mainThreadJobs.front());
+            mainThreadJobs.pop_front();
+        }
+        execute(job);
+        ++executed;
+    }
+
+    return executed;
+}
+
+void JobSystem::workerLoop(unsigned queueIndex) {
+    tlsQueueIndex = queueIndex;
+    tlsOwner = this;
+    PROFILE_THREAD_NAME("Worker " + std::to_string(queueIndex));
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (tryRunOneJob(queueIndex)) {
+            continue;
+        }
+
+        // Nothing local or stealable: sleep until new work is submitted
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() {
+            return stopping.load(std::memory_order_acquire) ||
+                   pendingJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::tryRunOneJob(unsigned queueIndex, const JobCounter* only) {
+    QueuedJob job;
+    if (popLocal(queueIndex, job, only) || steal(queueIndex, job, only)) {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::popLocal(unsigned queueIndex, QueuedJob& out, const JobCounter* only) {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    // LIFO for the owner: the most recently pushed job is the hottest in cache
+    auto job = queue.jobs.rbegin();
+    while (job != queue.jobs.rend() && only && job->counter != only) {
+        ++job;
+    }
+    if (job == queue.jobs.rend()) {
+        return false;
+    }
+
+    out = std::move(*job);
+    queue.jobs.erase(std::next(job).base());
+    pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool JobSystem::steal(unsigned thiefIndex, QueuedJob& out, const JobCounter* only) {
+    const unsigned queueCount = static_cast<unsigned>(queues.size());
+    const unsigned start = nextRandom() % queueCount;
+
+    for (unsigned i = 0; i < queueCount; ++i) {
+        unsigned victim = (start + i) % queueCount;
+        if (victim == thiefIndex) {
+            continue;
+        }
+
+        WorkQueue& queue = *queues[victim];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            continue;
+        }
+
+        // FIFO for thieves: the oldest job tends to be the largest piece of work
+        auto job = queue.jobs.begin();
+        while (job != queue.jobs.end() && only && job->counter != only) {
+            ++job;
+        }
+        if (job == queue.jobs.end()) {
+            continue;
+        }
+        out = std::move(*job);
+        queue.jobs.erase(job);
+        pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::execute(QueuedJob& job) {
+    try {
+        job.function();
+    } catch (const std::exception& e) {
+        LOG_ERROR(std::string("Unhandled exception in job: ") + e.what());
+    }
+
+    if (job.counter) {
+        job.counter->value.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+// ===== Benchmark =====
+
+namespace {
+    /**
+     * Baseline for the benchmark: every worker pulls from one shared
+     * mutex-protected queue
+     */
+    class MutexJobQueue {
+    public:
+        explicit MutexJobQueue(unsigned workerCount) : remaining(0), stopping(false) {
+            for (unsigned i = 0; i < workerCount; ++i) {
+                workers.emplace_back([this]() { workerLoop(); });
+            }
+        }
+
+        ~MutexJobQueue() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            condition.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void run(std::function<void()> job) {
+            remaining.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobs.push(std::move(job));
+            }
+            condition.notify_one();
+        }
+
+        void waitAll() {
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> jobs;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<int> remaining;
+        bool stopping;
+
+        void workerLoop() {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                    if (stopping && jobs.empty()) {
+                        return;
+                    }
+                    job = std::move(jobs.front());
+                    jobs.pop();
+                }
+                job();
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    };
+
+    // A few hundred nanoseconds of arithmetic, roughly a small entity update
+    void benchmarkWork(std::atomic<unsigned long long>& sink, size_t seed) {
+        unsigned long long value = seed;
+        for (int i = 0; i < 64; ++i) {
+            value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        sink.fetch_add(value & 1, std::memory_order_relaxed);
+    }
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+void JobSystem::runBenchmark(unsigned workerCount, size_t jobCount) {
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    LOG_INFO("Job system benchmark: " + std::to_string(jobCount) + " jobs, " +
+             std::to_string(workerCount) + " workers");
+
+    std::atomic<unsigned long long> sink(0);
+    double mutexMs = 0.0;
+    double stealingMs = 0.0;
+    double nestedMs = 0.0;
+    double parallelForMs = 0.0;
+
+    // Naive shared queue, all jobs submitted from the main thread
+    {
+        MutexJobQueue queue(workerCount);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < jobCount; ++i) {
+            queue.run([&sink, i]() { benchmarkWork(sink, i); });
+        }
+        queue.waitAll();
+        mutexMs = millisecondsSince(start);
+    }
+
+    {
+        JobSystem jobs(workerCount);
+
+        // Same flat submission pattern
+        {
+            JobCounter counter;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < jobCount; ++i) {
+                jobs.run([&sink, i]() { benchmarkWork(sink, i); }, &counter);
+            }
+            jobs.wait(counter);
+            stealingMs = millisecondsSince(start);
+        }
+
+        // Parent jobs that spawn children into their own deques
+        {
+            const size_t parents = std::max<size_t>(1, workerCount * 8);
+            const size_t childrenPerParent = jobCount / parents;
+            JobCounter counter;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t p = 0; p < parents; ++p) {
+                jobs.run([&jobs, &sink, p, childrenPerParent]() {
+                    JobCounter children;
+                    for (size_t c = 0; c < childrenPerParent; ++c) {
+                        jobs.run([&sink, p, c]() { benchmarkWork(sink, p * 131 + c); }, &children);
+                    }
+                    jobs.wait(children);
+                }, &counter);
+            }
+            jobs.wait(counter);
+            nestedMs = millisecondsSince(start);
+        }
+
+        // Chunked parallel_for, the pattern world generation uses
+        {
+            auto start = std::chrono::steady_clock::now();
+            jobs.parallelFor(0, jobCount, 1024, [&sink](size_t i) { benchmarkWork(sink, i); });
+            parallelForMs = millisecondsSince(start);
+        }
+    }
+
+    auto format = [jobCount](const char* label, double ms) {
+        std::stringstream ss;
+        ss << std::left << std::setw(26) << label << std::right << std::fixed << std::setprecision(2)
+           << std::setw(10) << ms << " ms  "
+           << std::setw(12) << std::setprecision(0) << (jobCount / (ms / 1000.0)) << " jobs/s";
+        return ss.str();
+    };
+
+    LOG_INFO(format("Mutex queue:", mutexMs));
+    LOG_INFO(format("Work stealing (flat):", stealingMs));
+    LOG_INFO(format("Work stealing (nested):", nestedMs));
+    LOG_INFO(format("parallelFor (grain 1024):", parallelForMs));
+    LOG_INFO("Speedup vs mutex queue: flat " + std::to_string(mutexMs / stealingMs) +
+             "x, nested " + std::to_string(mutexMs / nestedMs) + "x");
+    LOG_DEBUG("Benchmark checksum: " + std::to_string(sink.load()));
+}
@@ -0,0 +1,253 @@
+#include "engine/Profiler.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+std::atomic<bool> Profiler::active(false);
+thread_local Profiler::ThreadBuffer* Profiler::localBuffer = nullptr;
+
+namespace {
+    
+    // Zone names are C string literals; escape the odd quote or backslash
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << '"';
+    }
+    
+    // Trace timestamps are microseconds; keep the nanoseconds as decimals
+    void writeMicroseconds(std::ostream& out, uint64_t nanoseconds) {
+        out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+    }
+    
+} // namespace
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : frameStart(0)
+    , droppedEvents(0)
+    , traceCapture(false)
+    , traceFullWarned(false)
+{
+    lastFrame.frame = 0;
+    lastFrame.durationNs = 0;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::setEnabled(bool enabled) {
+    if (enabled && !isActive()) {
+        // Start over: nothing recorded before this point is collected
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : threads) {
+            buffer->collected = buffer->written.load(std::memory_order_acquire);
+        }
+        frameStart = now();
+        droppedEvents = 0;
+        lastFrame.frame = 0;
+        lastFrame.durationNs = 0;
+        lastFrame.zones.clear();
+        totals.clear();
+    }
+    active.store(enabled, std::memory_order_relaxed);
+}
+
+Profiler::ThreadBuffer* Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    threads.push_back(std::make_unique<ThreadBuffer>());
+    ThreadBuffer* buffer = threads.back().get();
+    buffer->id = static_cast<uint32_t>(threads.size());
+    buffer->name = "Thread " + std::to_string(buffer->id);
+    buffer->written.store(0, std::memory_order_relaxed);
+    buffer->collected = 0;
+    localBuffer = buffer;
+    return buffer;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end) {
+    ThreadBuffer* buffer = localBuffer ? localBuffer : registerThread();
+    
+    // Threads that never record (the profiler stays off) never pay for a ring
+    if (!buffer->events) {
+        buffer->events.reset(new Event[RING_CAPACITY]);
+    }
+    
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % RING_CAPACITY] = Event{ name, start, end };
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer* buffer = localBuffer ? localBuffer : registerThread();
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer->name = name;
+}
+
+void Profiler::endFrame() {
+    if (!isActive()) {
+        return;
+    }
+    
+    const uint64_t frameEnd = now();
+    lastFrame.frame++;
+    lastFrame.durationNs = frameEnd - frameStart;
+    lastFrame.zones.clear();
+    frameStart = frameEnd;
+    
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : threads) {
+            // A ring that wrapped since the last frame lost its oldest events
+            const uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = buffer->collected;
+            if (written - first > RING_CAPACITY) {
+                droppedEvents += written - RING_CAPACITY - first;
+                first = written - RING_CAPACITY;
+            }
+            
+            // Copy before use: the thread keeps recording and may lap the
+            // ring while it is read. Copies of slots it reached meanwhile
+            // (or is writing now) may be torn, so drop those.
+            copied.clear();
+            for (uint64_t i = first; i < written; ++i) {
+                copied.push_back(buffer->events[i % RING_CAPACITY]);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t rewritten = buffer->written.load(std::memory_order_relaxed);
+            size_t overwritten = 0;
+            if (rewritten + 1 - first > RING_CAPACITY) {
+                overwritten = static_cast<size_t>(std::min<uint64_t>(rewritten + 1 - RING_CAPACITY - first, copied.size()));
+                droppedEvents += overwritten;
+            }
+            
+            for (size_t i = overwritten; i < copied.size(); ++i) {
+                const Event& event = copied[i];
+                const uint64_t duration = event.end - event.start;
+                
+                // Few distinct zones per frame: a linear search beats hashing
+                auto zone = std::find_if(lastFrame.zones.begin(), lastFrame.zones.end(),
+                                         [&](const ZoneStats& stats) { return stats.name == event.name; });
+                if (zone == lastFrame.zones.end()) {
+                    lastFrame.zones.push_back(ZoneStats{ event.name, 0, 0, 0 });
+                    zone = lastFrame.zones.end() - 1;
+                }
+                zone->calls++;
+                zone->totalNs += duration;
+                zone->maxNs = std::max(zone->maxNs, duration);
+                
+                if (traceCapture) {
+                    if (trace.size() < MAX_TRACE_EVENTS) {
+                        trace.push_back(TraceEvent{ event, buffer->id });
+                    } else if (!traceFullWarned) {
+                        LOG_WARNING("Profiler trace is full (" + std::to_string(MAX_TRACE_EVENTS) + " events); later zones are summarized only");
+                        traceFullWarned = true;
+                    }
+                }
+            }
+            buffer->collected = written;
+        }
+    }
+    
+    std::sort(lastFrame.zones.begin(), lastFrame.zones.end(), [](const ZoneStats& a, const ZoneStats& b) {
+        return a.totalNs > b.totalNs;
+    });
+    
+    for (const ZoneStats& zone : lastFrame.zones) {
+        auto total = std::find_if(totals.begin(), totals.end(),
+                                  [&](const ZoneTotals& entry) { return entry.name == zone.name; });
+        if (total == totals.end()) {
+            totals.push_back(ZoneTotals{ zone.name, 0, 0, 0 });
+            total = totals.end() - 1;
+        }
+        total->calls += zone.calls;
+        total->totalNs += zone.totalNs;
+        total->maxFrameNs = std::max(total->maxFrameNs, zone.totalNs);
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("Failed to write profiler trace: " + path);
+        return false;
+    }
+    
+    // Complete ("X") events nest by time; metadata names the threads
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : threads) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name.c_str());
+            out << "}}";
+            first = false;
+        }
+    }
+    
+    // Threads are collected one after another, so the earliest event is
+    // not necessarily the first
+    uint64_t origin = 0;
+    if (!trace.empty()) {
+        origin = std::min_element(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) {
+            return a.event.start < b.event.start;
+        })->event.start;
+    }
+    for (const TraceEvent& entry : trace) {
+        out << (first ? "" : ",\n") << "{\"name\":";
+        writeJsonString(out, entry.event.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << entry.thread << ",\"ts\":";
+        writeMicroseconds(out, entry.event.start - origin);
+        out << ",\"dur\":";
+        writeMicroseconds(out, entry.event.end - entry.event.start);
+        out << "}";
+        first = false;
+    }
+    out << "\n]}\n";
+    
+    if (!out) {
+        LOG_ERROR("Failed to write profiler trace: " + path);
+        return false;
+    }
+    LOG_INFO("Profiler trace written: " + path + " (" + std::to_string(trace.size()) + " events)");
+    return true;
+}
+
+void Profiler::logSummary() const {
+    if (lastFrame.frame == 0) {
+        return;
+    }
+    
+    std::vector<ZoneTotals> sorted = totals;
+    std::sort(sorted.begin(), sorted.end(), [](const ZoneTotals& a, const ZoneTotals& b) {
+        return a.totalNs > b.totalNs;
+    });
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "Profiler: " << lastFrame.frame << " frames, " << droppedEvents << " events dropped; per frame avg / max ms, calls";
+    for (const ZoneTotals& zone : sorted) {
+        ss << "\n  " << std::left << std::setw(32) << zone.name << std::right
+           << std::setw(10) << zone.totalNs / 1e6 / lastFrame.frame
+           << std::setw(10) << zone.maxFrameNs / 1e6
+           << std::setw(10) << std::setprecision(1) << static_cast<double>(zone.calls) / lastFrame.frame
+           << std::setprecision(3);
+    }
+    LOG_INFO(ss.str());
+}
@@ -1,6 +1,20 @@
 #include "engine/Time.h"
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // Reference point for getCurrentTime(); fixed on first use
+    const std::chrono::steady_clock::time_point& clockEpoch() {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return epoch;
+    }
+    
+    // Windows logged by logFrameStats(), in seconds
+    const float LOG_WINDOWS[] = { 1.0f, 10.0f, 60.0f };
+}
 
 Time::Time()
     : deltaTime(0.0f)
@@ -9,16 +23,33 @@ Time::Time()
     , fps(0.0f)
     , fpsTimer(0.0f)
     , frameCount(0)
+    , history(HISTORY_SIZE)
+    , historyNext(0)
+    , historyCount(0)
+    , current()
+    , firstUpdate(true)
+    , hitchThreshold(2000.0f / 60.0f)
 {
-    lastFrameTime = glfwGetTime();
+    lastFrameTime = getCurrentTime();
+    sortScratch.reserve(HISTORY_SIZE);
 }
 
 void Time::update() {
-    double currentTime = glfwGetTime();
+    double currentTime = getCurrentTime();
     deltaTime = static_cast<float>(currentTime - lastFrameTime);
     lastFrameTime = currentTime;
     totalTime += deltaTime;
     
+    // Close the frame that just ended
+    if (!firstUpdate) {
+        current.frameTime = deltaTime * 1000.0f;
+        history[historyNext] = current;
+        historyNext = (historyNext + 1) % HISTORY_SIZE;
+        historyCount = std::min(historyCount + 1, HISTORY_SIZE);
+    }
+    firstUpdate = false;
+    current = FrameRecord();
+    
     // Calculate FPS
     frameCount++;
     fpsTimer += deltaTime;
@@ -30,6 +61,100 @@ void Time::update() {
     }
 }
 
+void Time::recordPhase(Phase phase, float milliseconds) {
+    if (phase != Phase::Count) {
+        current.phaseTimes[static_cast<size_t>(phase)] += milliseconds;
+    }
+}
+
+Time::FrameStats Time::getFrameStats(float windowSeconds) const {
+    return computeStats(PHASE_COUNT, windowSeconds);
+}
+
+Time::FrameStats Time::getPhaseStats(Phase phase, float windowSeconds) const {
+    if (phase == Phase::Count) {
+        return FrameStats();
+    }
+    return computeStats(static_cast<size_t>(phase), windowSeconds);
+}
+
+Time::FrameStats Time::computeStats(size_t phaseIndex, float windowSeconds) const {
+    // Newest first until the frames add up to the window
+    sortScratch.clear();
+    const float windowMs = windowSeconds * 1000.0f;
+    float covered = 0.0f;
+    double total = 0.0;
+    for (size_t i = 0; i < historyCount && covered < windowMs; ++i) {
+        const FrameRecord& record = history[(historyNext + HISTORY_SIZE - 1 - i) % HISTORY_SIZE];
+        const float value = phaseIndex < PHASE_COUNT ? record.phaseTimes[phaseIndex] : record.frameTime;
+        covered += record.frameTime;
+        total += value;
+        sortScratch.push_back(value);
+    }
+    
+    FrameStats stats = FrameStats();
+    if (sortScratch.empty()) {
+        return stats;
+    }
+    
+    stats.frames = sortScratch.size();
+    stats.average = static_cast<float>(total / static_cast<double>(stats.frames));
+    stats.hitches = static_cast<int>(std::count_if(sortScratch.begin(), sortScratch.end(),
+                                                   [this](float value) { return value > hitchThreshold; }));
+    
+    // Nearest rank, like the headless tick report
+    std::sort(sortScratch.begin(), sortScratch.end());
+    auto percentile = [this](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(sortScratch.size() - 1) + 0.5);
+        return sortScratch[index];
+    };
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = sortScratch.back();
+    return stats;
+}
+
+void Time::logFrameStats() const {
+    if (historyCount == 0) {
+        LOG_INFO("Frame times: no frames recorded");
+        return;
+    }
+    
+    size_t previousFrames = 0;
+    for (float window : LOG_WINDOWS) {
+        FrameStats frame = getFrameStats(window);
+        if (frame.frames == previousFrames) {
+            break; // The history is shorter than this window: same frames again
+        }
+        previousFrames = frame.frames;
+        
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2)
+           << "Frame times over the last " << static_cast<int>(window) << " s (" << frame.frames << " frames): avg "
+           << frame.average << ", p50 " << frame.p50 << ", p95 " << frame.p95 << ", p99 " << frame.p99
+           << ", max " << frame.max << " ms, " << frame.hitches << " hitches over " << hitchThreshold << " ms";
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            Phase phase = static_cast<Phase>(i);
+            FrameStats stats = getPhaseStats(phase, window);
+            ss << "\n  " << std::left << std::setw(12) << getPhaseName(phase) << std::right
+               << "avg " << stats.average << ", p50 " << stats.p50 << ", p95 " << stats.p95
+               << ", p99 " << stats.p99 << ", max " << stats.max << " ms";
+        }
+        LOG_INFO(ss.str());
+    }
+}
+
+const char* Time::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Simulation: return "Simulation";
+        case Phase::Render: return "Render";
+        case Phase::Present: return "Present";
+        default: return "Unknown";
+    }
+}
+
 double Time::getCurrentTime() {
-    return glfwGetTime();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - clockEpoch();
+    return elapsed.count();
 }
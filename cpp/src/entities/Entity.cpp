@@ -1,7 +1,11 @@
 #include "entities/Entity.h"
 
+uint32_t Entity::nextId = 1;
+
 Entity::Entity(float x, float y)
-    : position(x, y)
+    : id(nextId++)
+    , position(x, y)
+    , previousPosition(x, y)
     , velocity(0.0f, 0.0f)
     , active(true)
 {
@@ -27,6 +31,12 @@ void Entity::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera*
 void Entity::setPosition(float x, float y) {
     position.x = x;
     position.y = y;
+    // A placement, not movement: don't interpolate from the old spot
+    previousPosition = position;
+}
+
+glm::vec2 Entity::getInterpolatedPosition(float alpha) const {
+    return previousPosition + (position - previousPosition) * alpha;
 }
 
 void Entity::setVelocity(float vx, float vy) {
@@ -118,15 +118,13 @@ bool Player::interact(float targetX, float targetY, World* world) {
         if (decoration.find("tree_") == 0) {
             // Gather wood
             addWood(1);
-            tile->setDecoration("");  // Remove the tree
-            tile->setResource(false);
+            world->removeResource(tileX, tileY);  // Remove the tree
             std::cout << "Gathered wood! Total: " << getWood() << std::endl;
             return true;
         } else if (decoration.find("rocks_") == 0) {
             // Gather stone
             addStone(1);
-            tile->setDecoration("");  // Remove the rocks
-            tile->setResource(false);
+            world->removeResource(tileX, tileY);  // Remove the rocks
             std::cout << "Gathered stone! Total: " << getStone() << std::endl;
             return true;
         }
@@ -135,6 +133,16 @@ bool Player::interact(float targetX, float targetY, World* world) {
     return false;
 }
 
+bool Player::gatherNearest(World* world) {
+    // Let the world's resource index find the closest resource in reach
+    glm::ivec2 resourceTile;
+    if (!world->findNearestResource(position, interactionRange, resourceTile)) {
+        return false;
+    }
+    
+    return interact(resourceTile.x + 0.5f, resourceTile.y + 0.5f, world);
+}
+
 void Player::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera) {
     // Get screen position from isometric coordinates
     glm::vec2 screenPos = isoRenderer->tileToScreen(position.x, position.y);
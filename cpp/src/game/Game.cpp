@@ -1,19 +1,34 @@
 #include "game/Game.h"
 #include "engine/Engine.h"
 #include "engine/Input.h"
+#include "engine/Profiler.h"
 #include "rendering/Renderer.h"
+#include "rendering/BatchRenderer.h"
 #include "rendering/Camera.h"
 #include "rendering/IsometricRenderer.h"
 #include "rendering/TextureManager.h"
 #include "world/World.h"
+#include "world/SpatialHash.h"
 #include "building/BuildingSystem.h"
-#include "entities/Entity.h"
+#include "entities/Player.h"
+#include "utils/IsometricUtils.h"
+#include "ui/UIRenderer.h"
+#include "rendering/DebugDraw.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 Game::Game(Engine* engine)
     : engine(engine)
+    , buildPanel(nullptr)
+    , buildLabel(nullptr)
+    , worldViewProjection(1.0f)
+    , textureBudget(0)
     , buildingMode(false)
     , selectedBuildingType(0)
+    , showFrameGraph(false)
 {
 }
 
@@ -23,46 +38,100 @@ Game::~Game() {
 bool Game::initialize() {
     std::cout << "Initializing game..." << std::endl;
     
-    // Create texture manager
-    textureManager = std::make_unique<TextureManager>();
-    std::cout << "Loading textures..." << std::endl;
-    
-    // Load ground tiles
-    if (!textureManager->loadGroundTiles()) {
-        std::cout << "Warning: Failed to load ground tiles, using colored tiles as fallback" << std::endl;
-    }
-    
-    // Load decorations
-    if (!textureManager->loadDecorations()) {
-        std::cout << "Warning: Failed to load decorations" << std::endl;
+    // Textures are only needed when something renders (headless runs may not)
+    if (engine->getRenderer()) {
+        // Create texture manager; files decode on the workers while the
+        // game starts with colored tiles, textures appear as they upload
+        textureManager = std::make_unique<TextureManager>();
+        textureManager->setJobSystem(engine->getJobSystem());
+        textureManager->setMemoryBudget(textureBudget);
+        std::cout << "Loading textures..." << std::endl;
+        
+        // Cooked textures upload straight from the pack, skipping the decode
+        if (!textureManager->openAssetPack(AssetPack::DEFAULT_PATH)) {
+            std::cout << "No asset pack at " << AssetPack::DEFAULT_PATH
+                      << " (run with --cook-assets to build one)" << std::endl;
+        }
+        
+        // Load ground tiles
+        if (!textureManager->loadGroundTiles()) {
+            std::cout << "Warning: Failed to load ground tiles, using colored tiles as fallback" << std::endl;
+        }
+        
+        // Load decorations
+        if (!textureManager->loadDecorations()) {
+            std::cout << "Warning: Failed to load decorations" << std::endl;
+        }
+        
+        // Headless frames must not depend on decode timing
+        if (engine->isHeadless()) {
+            textureManager->finishLoading();
+        }
+        std::cout << "Loaded " << textureManager->getTextureCount() << " textures ("
+                  << textureManager->getPackHits() << " from the asset pack), "
+                  << textureManager->getPendingCount() << " still decoding" << std::endl;
+        
+        // Sorted objects (decorations, buildings, entities) are batched
+        batchRenderer = std::make_unique<BatchRenderer>(engine->getRenderer()->getBackend());
+        if (!batchRenderer->initialize()) {
+            std::cerr << "Failed to initialize batch renderer" << std::endl;
+            return false;
+        }
+        
+        // UI in window pixels over the world
+        uiRenderer = std::make_unique<UIRenderer>();
+        if (!uiRenderer->initialize(engine->getRenderer(), engine->getWidth(), engine->getHeight())) {
+            std::cerr << "Failed to initialize UI renderer" << std::endl;
+            return false;
+        }
+        createHud();
     }
     
-    std::cout << "Loaded " << textureManager->getTextureCount() << " textures" << std::endl;
-    
-    // Create world with texture manager
+    // Create world with texture manager (null when nothing renders)
     world = std::make_unique<World>(30, 30, textureManager.get());
+    world->setJobSystem(engine->getJobSystem());
     world->generate();
     
     // Create building system
     buildingSystem = std::make_unique<BuildingSystem>(world.get());
     
-    // Create player entity (placeholder)
-    player = std::make_unique<Entity>(15.0f, 15.0f);
+    // Create player
+    player = std::make_unique<Player>(15.0f, 15.0f);
+    
+    // Track entity positions for proximity queries (one cell per chunk)
+    entityIndex = std::make_unique<SpatialHash>(static_cast<float>(World::CHUNK_SIZE));
+    entityIndex->insert(player->getId(), player->getPosition());
     
     std::cout << "Game initialized successfully" << std::endl;
+    if (engine->isHeadless()) {
+        return true;
+    }
+    
     std::cout << "\nControls:" << std::endl;
     std::cout << "  WASD / Arrow Keys - Move camera" << std::endl;
+    std::cout << "  Mouse Wheel / Q/E - Zoom out/in" << std::endl;
     std::cout << "  B - Toggle building mode" << std::endl;
     std::cout << "  1/2/3 - Select building type (House/Tower/Warehouse)" << std::endl;
     std::cout << "  Left Click - Place building" << std::endl;
+    std::cout << "  G - Gather the nearest resource" << std::endl;
+    std::cout << "  F3 - Toggle frame time graph" << std::endl;
+#if DEBUG_DRAW_ENABLED
+    std::cout << "  F5/F6/F7 - Toggle chunk/spatial hash/entity debug overlays" << std::endl;
+#endif
     std::cout << "  ESC - Exit" << std::endl;
     
     return true;
 }
 
 void Game::update(float deltaTime) {
-    // Handle input
-    handleInput(deltaTime);
+    PROFILE_SCOPE("Game::update");
+    
+    // Input is handled per frame by the engine, not per tick
+    
+    // Remember last tick's state for render interpolation
+    if (player) {
+        player->savePreviousState();
+    }
     
     // Update world
     world->update(deltaTime);
@@ -73,37 +142,177 @@ void Game::update(float deltaTime) {
     // Update player
     if (player) {
         player->update(deltaTime, world.get());
+        
+        // Cheap when the player stays inside its cell
+        entityIndex->update(player->getId(), player->getPosition());
     }
 }
 
-void Game::render() {
+void Game::render(float alpha) {
+    PROFILE_SCOPE("Game::render");
     Renderer* renderer = engine->getRenderer();
     Camera* camera = engine->getCamera();
+    worldViewProjection = renderer->getProjectionMatrix() * renderer->getViewMatrix();
     
     // Create isometric renderer
     IsometricRenderer isoRenderer(renderer, camera);
     isoRenderer.setTileSize(64, 32);
     
-    // Render world
-    world->render(renderer, &isoRenderer, camera);
+    // Textures still streaming in: upload finished ones, and rebuild chunks
+    // that were built with fallbacks
+    if (textureManager && textureManager->isLoading() && textureManager->processUploads() > 0) {
+        world->markAllDirty();
+    }
+    
+    // Reload evicted textures drawn last frame, evict over the budget
+    if (textureManager) {
+        textureManager->beginFrame();
+    }
+    
+    // Render world (ground now, decorations into the draw list)
+    drawList.clear();
+    {
+        PROFILE_SCOPE("World::render");
+        world->render(renderer, &isoRenderer, camera, drawList);
+    }
     
     // Render buildings
-    buildingSystem->render(renderer, &isoRenderer, camera);
+    buildingSystem->render(renderer, &isoRenderer, camera, drawList);
     
     // Render player
     if (player && player->isActive()) {
-        // Draw simple colored quad for player
-        glm::vec2 playerScreenPos = isoRenderer.gridToScreen(
-            static_cast<int>(player->getPosition().x),
-            static_cast<int>(player->getPosition().y)
+        // Draw simple colored quad for player, sorted at the tile it stands on
+        glm::vec2 playerPos = player->getInterpolatedPosition(alpha);
+        glm::vec2 playerScreenPos = isoRenderer.tileToScreen(playerPos.x, playerPos.y);
+        glm::vec3 light = world->getLightMap().getColor(
+            static_cast<int>(std::floor(playerPos.x + 0.5f)),
+            static_cast<int>(std::floor(playerPos.y + 0.5f))
         );
         
-        renderer->drawColoredQuad(
+        drawList.add(
+            DrawList::Layer::Objects,
+            IsometricUtils::getRenderOrder(playerPos.x + 0.5f, playerPos.y + 0.5f),
             playerScreenPos + glm::vec2(20, -30),
             glm::vec2(24, 30),
-            glm::vec4(1.0f, 0.8f, 0.0f, 1.0f)
+            nullptr,
+            glm::vec4(glm::vec3(1.0f, 0.8f, 0.0f) * light, 1.0f)
         );
     }
+
+#if DEBUG_DRAW_ENABLED
+    // Debug overlays, recorded only while their category is on; a grid
+    // point's screen position is the top vertex of its tile's diamond
+    const glm::vec2 tileTop(isoRenderer.getTileWidth() * 0.5f, 0.0f);
+    if (DEBUG_DRAW_ON(SpatialHash)) {
+        entityIndex->forEachCell([&](const glm::vec2& cellMin, const glm::vec2& cellMax, size_t count) {
+            glm::vec2 center = isoRenderer.tileToScreen((cellMin.x + cellMax.x) * 0.5f, (cellMin.y + cellMax.y) * 0.5f) + tileTop;
+            DEBUG_DRAW_TILES(SpatialHash, glm::ivec2(cellMin), glm::ivec2(cellMax) - glm::ivec2(1), glm::vec4(1.0f, 0.4f, 0.8f, 0.9f));
+            DEBUG_DRAW_TEXT(SpatialHash, center, std::to_string(count), glm::vec3(1.0f, 0.4f, 0.8f));
+        });
+    }
+    if (DEBUG_DRAW_ON(Entities) && player && player->isActive()) {
+        glm::vec2 position = player->getInterpolatedPosition(alpha);
+        glm::vec2 center = isoRenderer.tileToScreen(position.x + 0.5f, position.y + 0.5f) + tileTop;
+        DEBUG_DRAW_CIRCLE(Entities, center, 16.0f, glm::vec4(0.2f, 1.0f, 1.0f, 0.9f));
+        DEBUG_DRAW_TEXT(Entities, center + glm::vec2(20.0f, 0.0f), "player", glm::vec3(0.2f, 1.0f, 1.0f));
+    }
+#endif
+    
+    // Back to front, batched by texture where depths tie
+    batchRenderer->setViewMatrix(renderer->getViewMatrix());
+    batchRenderer->setProjectionMatrix(renderer->getProjectionMatrix());
+    PROFILE_SCOPE("DrawList::submit");
+    batchRenderer->begin();
+    drawList.submit(*batchRenderer);
+    batchRenderer->end();
+}
+
+void Game::renderUI() {
+    if (!uiRenderer) {
+        return;
+    }
+    
+    PROFILE_SCOPE("Game::renderUI");
+    uiRenderer->beginFrame();
+    uiRenderer->render(*hud);
+    if (showFrameGraph) {
+        renderFrameGraph();
+    }
+#if DEBUG_DRAW_ENABLED
+    DebugDraw::getInstance().flush(*uiRenderer, worldViewProjection);
+#endif
+    uiRenderer->endFrame();
+}
+
+void Game::createHud() {
+    hud = std::make_unique<UICanvas>(static_cast<float>(engine->getWidth()), static_cast<float>(engine->getHeight()));
+    
+    // Building mode banner, top-left
+    buildPanel = hud->addChild(std::make_unique<UIPanel>(10.0f, 10.0f, 220.0f, 32.0f));
+    buildPanel->setColor(glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+    buildLabel = buildPanel->addChild(std::make_unique<UILabel>(20.0f, 20.0f, ""));
+    buildLabel->setColor(glm::vec3(1.0f, 0.85f, 0.4f));
+    updateHud();
+}
+
+void Game::updateHud() {
+    if (!hud) {
+        return;
+    }
+    
+    // Setters only dirty the HUD when a value actually changes
+    static const char* const BUILDING_NAMES[] = { "HOUSE", "TOWER", "WAREHOUSE" };
+    buildPanel->setVisible(buildingMode);
+    buildLabel->setText(std::string("BUILD: ") + BUILDING_NAMES[selectedBuildingType]);
+}
+
+void Game::renderFrameGraph() {
+    // Frame time graph, bottom-left: one bar per frame of the dynamic
+    // resolution history (green within the target, red over), the target
+    // as a line, and the current resolution scale as a bar on the right
+    const DynamicResolution& dynamicResolution = engine->getDynamicResolution();
+    const glm::vec2 screen(uiRenderer->getWidth(), uiRenderer->getHeight());
+    
+    const float barWidth = 2.0f;
+    const float graphHeight = 100.0f;
+    const float graphWidth = barWidth * DynamicResolution::HISTORY_SIZE;
+    const glm::vec2 origin(10.0f, screen.y - 10.0f - graphHeight);
+    const float target = dynamicResolution.getTargetFrameTime();
+    const float pixelsPerMs = graphHeight / (target * 2.0f); // Graph tops out at twice the target
+    
+    uiRenderer->drawRect(origin.x, origin.y, graphWidth + 12.0f, graphHeight, glm::vec4(0.0f, 0.0f, 0.0f, 0.5f));
+    
+    dynamicResolution.getFrameTimeHistory(frameGraphScratch);
+    for (size_t i = 0; i < frameGraphScratch.size(); ++i) {
+        float frameTime = frameGraphScratch[i];
+        float height = std::min(frameTime * pixelsPerMs, graphHeight);
+        glm::vec4 color = frameTime <= target ? glm::vec4(0.2f, 0.9f, 0.3f, 0.9f) : glm::vec4(0.95f, 0.25f, 0.2f, 0.9f);
+        uiRenderer->drawRect(origin.x + i * barWidth, origin.y + graphHeight - height, barWidth, height, color);
+    }
+    
+    uiRenderer->drawRect(origin.x, origin.y + graphHeight - target * pixelsPerMs, graphWidth, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.8f));
+    
+    float scaleHeight = (dynamicResolution.isEnabled() ? dynamicResolution.getScale() : 1.0f) * graphHeight;
+    uiRenderer->drawRect(origin.x + graphWidth + 4.0f, origin.y + graphHeight - scaleHeight, 6.0f, scaleHeight, glm::vec4(0.3f, 0.6f, 1.0f, 0.9f));
+    
+    // Percentiles over the last 10 seconds above the graph
+    const Time::FrameStats stats = engine->getTime()->getFrameStats(10.0f);
+    std::stringstream percentiles;
+    percentiles << std::fixed << std::setprecision(1) << "p50 " << stats.p50 << "  p95 " << stats.p95
+                << "  p99 " << stats.p99 << "  max " << stats.max << " ms  " << stats.hitches << " hitches";
+    uiRenderer->drawText(percentiles.str(), origin.x, origin.y - 18.0f, 1.0f, glm::vec3(0.9f));
+    
+    // While profiling, the costliest zones of the last frame to the right
+    if (Profiler::isActive()) {
+        const Profiler::FrameSummary& frame = Profiler::getInstance().getLastFrame();
+        const size_t lines = std::min<size_t>(frame.zones.size(), 6);
+        for (size_t i = 0; i < lines; ++i) {
+            const Profiler::ZoneStats& zone = frame.zones[i];
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(2) << zone.totalNs / 1e6 << " " << zone.name;
+            uiRenderer->drawText(ss.str(), origin.x + graphWidth + 24.0f, origin.y + i * 16.0f, 1.0f, glm::vec3(0.9f));
+        }
+    }
 }
 
 void Game::handleInput(float deltaTime) {
@@ -123,25 +332,70 @@ void Game::handleInput(float deltaTime) {
         std::cout << "Building mode: " << (buildingMode ? "ON" : "OFF") << std::endl;
     }
     
+    // Toggle frame time graph
+    if (input->isKeyPressed(GLFW_KEY_F3)) {
+        showFrameGraph = !showFrameGraph;
+    }
+    
+    // Log frame time percentiles
+    if (input->isKeyPressed(GLFW_KEY_F4)) {
+        engine->getTime()->logFrameStats();
+    }
+
+#if DEBUG_DRAW_ENABLED
+    // Toggle debug overlays
+    const struct { int key; DebugDraw::Category category; } overlayKeys[] = {
+        { GLFW_KEY_F5, DebugDraw::Category::Chunks },
+        { GLFW_KEY_F6, DebugDraw::Category::SpatialHash },
+        { GLFW_KEY_F7, DebugDraw::Category::Entities },
+    };
+    for (const auto& overlay : overlayKeys) {
+        if (input->isKeyPressed(overlay.key)) {
+            DebugDraw& debugDraw = DebugDraw::getInstance();
+            debugDraw.toggle(overlay.category);
+            std::cout << "Debug overlay " << DebugDraw::getCategoryName(overlay.category) << ": "
+                      << (debugDraw.isEnabled(overlay.category) ? "ON" : "OFF") << std::endl;
+        }
+    }
+#endif
+    
+    // Gather the closest tree or rock within reach of the player
+    if (input->isKeyPressed(GLFW_KEY_G) && player && !player->gatherNearest(world.get())) {
+        std::cout << "Nothing to gather in range" << std::endl;
+    }
+    
     // Building mode controls
     if (buildingMode) {
         updateBuildingMode();
     }
+    
+    updateHud();
 }
 
 void Game::shutdown() {
     std::cout << "Shutting down game..." << std::endl;
     
+    hud.reset();
+    uiRenderer.reset();
+    batchRenderer.reset();
+    entityIndex.reset();
     player.reset();
     buildingSystem.reset();
     world.reset();
+    
+    // Before the engine drops the GL context and joins the decode workers
+    if (textureManager) {
+        textureManager->logMemoryReport();
+    }
+    textureManager.reset();
 }
 
 void Game::updateCamera(float deltaTime) {
     Input* input = engine->getInput();
     Camera* camera = engine->getCamera();
     
-    float cameraSpeed = camera->getSpeed() * deltaTime;
+    // Same on-screen speed at every zoom
+    float cameraSpeed = camera->getSpeed() * deltaTime / camera->getZoom();
     
     // WASD or Arrow keys for camera movement
     if (input->isKeyDown(GLFW_KEY_W) || input->isKeyDown(GLFW_KEY_UP)) {
@@ -156,6 +410,22 @@ void Game::updateCamera(float deltaTime) {
     if (input->isKeyDown(GLFW_KEY_D) || input->isKeyDown(GLFW_KEY_RIGHT)) {
         camera->move(cameraSpeed, 0);
     }
+    
+    // Mouse wheel zooms around the cursor (1.25x per notch), Q/E around the
+    // screen center (2x per second)
+    float screenWidth = static_cast<float>(engine->getWidth());
+    float screenHeight = static_cast<float>(engine->getHeight());
+    float scroll = input->getScrollDelta();
+    if (scroll != 0.0f) {
+        camera->zoomAt(std::pow(1.25f, scroll), input->getMousePosition(), screenWidth, screenHeight);
+    }
+    glm::vec2 center(screenWidth / 2.0f, screenHeight / 2.0f);
+    if (input->isKeyDown(GLFW_KEY_Q)) {
+        camera->zoomAt(std::pow(0.5f, deltaTime), center, screenWidth, screenHeight);
+    }
+    if (input->isKeyDown(GLFW_KEY_E)) {
+        camera->zoomAt(std::pow(2.0f, deltaTime), center, screenWidth, screenHeight);
+    }
 }
 
 void Game::updateBuildingMode() {
@@ -1,14 +1,91 @@
 #include "engine/Engine.h"
 #include "game/Game.h"
+#include "engine/JobSystem.h"
+#include "engine/Profiler.h"
+#include "rendering/BatchRenderer.h"
+#include "rendering/DrawList.h"
+#include "rendering/AssetPack.h"
+#include "rendering/TextureManager.h"
 #include "utils/Logger.h"
 #include <iostream>
 #include <memory>
 #include <exception>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
-int main() {
+int main(int argc, char** argv) {
     // Initialize logger first
     Logger::getInstance().initialize("logs/engine.log");
     
+    // Command line options
+    //   --bench-jobs     run the job system microbenchmark and exit
+    //   --bench-drawlist run the draw list sort benchmark and exit
+    //   --bench-sprites  compare instanced and vertex sprite batching and exit
+    //   --cook-assets    precook the startup textures into the asset pack and exit
+    //   --headless       simulate without a window or GL context
+    //   --ticks N        headless: stop after N ticks
+    //   --seconds T      headless: stop after T seconds of wall time
+    //   --record-render  headless: render each tick into a recording backend
+    //   --software-render headless: rasterize each tick on the CPU
+    //   --screenshot P   headless software rendering: save the last frame to P
+    //   --texture-budget MB  keep at most MB of textures resident (LRU eviction)
+    //   --target-frame-ms MS  scale the render resolution to keep render time (GPU time
+    //                    when measured) near MS
+    //   --profile P      time profiler zones, log a summary and write a Chrome trace to P
+    bool headless = false;
+    Engine::HeadlessRendering headlessRendering = Engine::HeadlessRendering::None;
+    std::string screenshotPath;
+    unsigned long long maxTicks = 0;
+    double maxSeconds = 0.0;
+    size_t textureBudget = 0;
+    float targetFrameTime = 0.0f;
+    std::string profilePath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-jobs") == 0) {
+            JobSystem::runBenchmark();
+            Logger::getInstance().shutdown();
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-drawlist") == 0) {
+            DrawList::runBenchmark();
+            Logger::getInstance().shutdown();
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-sprites") == 0) {
+            BatchRenderer::runBenchmark();
+            Logger::getInstance().shutdown();
+            return 0;
+        } else if (std::strcmp(argv[i], "--cook-assets") == 0) {
+            std::vector<std::string> paths;
+            for (const TextureManager::TextureSource& source : TextureManager::getStartupSources()) {
+                paths.push_back(source.path);
+            }
+            bool cooked = AssetPack::cook(paths, AssetPack::DEFAULT_PATH);
+            Logger::getInstance().shutdown();
+            return cooked ? 0 : 1;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--record-render") == 0) {
+            headlessRendering = Engine::HeadlessRendering::Recording;
+        } else if (std::strcmp(argv[i], "--software-render") == 0) {
+            headlessRendering = Engine::HeadlessRendering::Software;
+        } else if (std::strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc) {
+            screenshotPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            maxSeconds = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            textureBudget = static_cast<size_t>(std::strtod(argv[++i], nullptr) * 1024.0 * 1024.0);
+        } else if (std::strcmp(argv[i], "--target-frame-ms") == 0 && i + 1 < argc) {
+            targetFrameTime = std::strtof(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+        }
+    }
+    
     LOG_INFO("=================================");
     LOG_INFO("  The Daily Grind - Game Engine");
     LOG_INFO("  C++ OpenGL Implementation");
@@ -20,10 +97,23 @@ int main() {
     std::cout << "==================================" << std::endl;
     std::cout << std::endl;
     
+    // Before anything loads, so startup shows in the first frame's zones
+    if (!profilePath.empty()) {
+        Profiler::getInstance().setEnabled(true);
+        Profiler::getInstance().setTraceCapture(true);
+    }
+    
     try {
         // Create engine
         LOG_INFO("Creating engine...");
         std::unique_ptr<Engine> engine = std::make_unique<Engine>(1280, 720, "The Daily Grind");
+        engine->setHeadless(headless);
+        engine->setHeadlessRendering(headlessRendering);
+        engine->setScreenshotPath(screenshotPath);
+        if (targetFrameTime > 0.0f) {
+            engine->getDynamicResolution().setTargetFrameTime(targetFrameTime);
+            engine->getDynamicResolution().setEnabled(true);
+        }
         
         // Initialize engine
         LOG_INFO("Initializing engine...");
@@ -37,6 +127,7 @@ int main() {
         // Create game
         LOG_INFO("Creating game...");
         std::unique_ptr<Game> game = std::make_unique<Game>(engine.get());
+        game->setTextureBudget(textureBudget);
         
         // Initialize game
         LOG_INFO("Initializing game...");
@@ -51,8 +142,17 @@ int main() {
         engine->setGame(game.get());
         
         // Run game
-        LOG_INFO("Starting game loop...");
-        engine->run();
+        if (headless) {
+            engine->runHeadless(maxTicks, maxSeconds);
+        } else {
+            LOG_INFO("Starting game loop...");
+            engine->run();
+        }
+        
+        if (!profilePath.empty()) {
+            Profiler::getInstance().logSummary();
+            Profiler::getInstance().writeChromeTrace(profilePath);
+        }
         
         // Shutdown
         LOG_INFO("Shutting down game...");
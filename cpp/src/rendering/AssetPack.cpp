@@ -0,0 +1,391 @@
+#include "rendering/AssetPack.h"
+#include "rendering/Texture.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    
+    constexpr char MAGIC[4] = { 'D', 'G', 'A', 'P' };
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr size_t DATA_ALIGNMENT = 16;
+    
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t entryCount;
+        uint64_t pathsOffset;
+        uint64_t pathsSize;
+    };
+    
+    size_t alignUp(size_t value) {
+        return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+    }
+    
+    uint64_t fnv1a(const std::vector<char>& bytes) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char byte : bytes) {
+            hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ull;
+        }
+        return hash;
+    }
+    
+    int64_t fileTime(const std::filesystem::path& path, std::error_code& error) {
+        return static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    }
+    
+    // Decode a source image into a full RGBA8 mip chain
+    bool encode(const std::string& path, AssetPack::Entry& entry, std::vector<uint8_t>& pixels) {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* data = Texture::decodeImage(path.c_str(), width, height, channels);
+        if (!data) {
+            LOG_WARNING("Cannot cook " + path + ": " + Texture::decodeError());
+            return false;
+        }
+        
+        entry.width = static_cast<uint32_t>(width);
+        entry.height = static_cast<uint32_t>(height);
+        pixels.resize(AssetPack::mipChainSize(entry.width, entry.height, &entry.levels));
+        
+        // Level 0: expand to RGBA8 the same way CPU-only textures do
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+            const unsigned char* src = data + i * channels;
+            uint8_t* dst = pixels.data() + i * 4;
+            dst[0] = src[0];
+            dst[1] = channels >= 3 ? src[1] : src[0];
+            dst[2] = channels >= 3 ? src[2] : src[0];
+            dst[3] = channels == 4 ? src[3] : (channels == 2 ? src[1] : 255);
+        }
+        Texture::freeImage(data);
+        
+        uint8_t* level = pixels.data();
+        uint32_t levelWidth = entry.width;
+        uint32_t levelHeight = entry.height;
+        for (uint32_t i = 1; i < entry.levels; ++i) {
+            uint8_t* next = level + static_cast<size_t>(levelWidth) * levelHeight * 4;
+            Texture::downsample(level, static_cast<int>(levelWidth), static_cast<int>(levelHeight), next);
+            level = next;
+            levelWidth = std::max(levelWidth / 2, 1u);
+            levelHeight = std::max(levelHeight / 2, 1u);
+        }
+        return true;
+    }
+    
+} // namespace
+
+AssetPack::AssetPack()
+    : mapped(nullptr)
+    , mappedSize(0)
+    , fileHandle(nullptr)
+    , mappingHandle(nullptr)
+    , entries(nullptr)
+    , entryCount(0)
+    , paths(nullptr)
+{
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    mapped = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mapped) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mappedSize = static_cast<size_t>(size.QuadPart);
+    fileHandle = file;
+    mappingHandle = mapping;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapped = static_cast<const uint8_t*>(address);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    
+    // Validate everything once, so lookups can trust the offsets
+    Header header;
+    bool valid = mappedSize >= sizeof(Header);
+    if (valid) {
+        std::memcpy(&header, mapped, sizeof(Header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == FORMAT_VERSION &&
+                header.entryCount <= (mappedSize - sizeof(Header)) / sizeof(Entry) &&
+                header.pathsOffset <= mappedSize && header.pathsSize <= mappedSize - header.pathsOffset;
+    }
+    if (valid) {
+        entries = reinterpret_cast<const Entry*>(mapped + sizeof(Header));
+        entryCount = static_cast<size_t>(header.entryCount);
+        paths = reinterpret_cast<const char*>(mapped + header.pathsOffset);
+        for (size_t i = 0; i < entryCount && valid; ++i) {
+            const Entry& entry = entries[i];
+            uint32_t levels = 0;
+            valid = static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= header.pathsSize &&
+                    entry.dataOffset <= mappedSize && entry.dataSize <= mappedSize - entry.dataOffset &&
+                    entry.dataOffset % DATA_ALIGNMENT == 0 &&
+                    entry.dataSize == mipChainSize(entry.width, entry.height, &levels) && entry.levels == levels;
+            if (valid) {
+                entryIndex[getPath(entry)] = i;
+            }
+        }
+    }
+    
+    if (!valid) {
+        LOG_WARNING("Ignoring invalid asset pack " + path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapped);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+        munmap(const_cast<uint8_t*>(mapped), mappedSize);
+#endif
+    }
+    mapped = nullptr;
+    mappedSize = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    entries = nullptr;
+    entryCount = 0;
+    paths = nullptr;
+    entryIndex.clear();
+}
+
+const AssetPack::Entry* AssetPack::find(const std::string& sourcePath) const {
+    auto it = entryIndex.find(sourcePath);
+    if (it == entryIndex.end()) {
+        return nullptr;
+    }
+    const Entry& entry = entries[it->second];
+    
+    // A pack shipped without its sources is always current
+    std::error_code error;
+    const std::filesystem::path source(sourcePath);
+    uint64_t size = std::filesystem::file_size(source, error);
+    if (error) {
+        return &entry;
+    }
+    int64_t time = fileTime(source, error);
+    if (error || size != entry.sourceSize || time != entry.sourceTime) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+const uint8_t* AssetPack::getLevel(const Entry& entry, uint32_t level) const {
+    const uint8_t* data = mapped + entry.dataOffset;
+    uint32_t width = entry.width;
+    uint32_t height = entry.height;
+    for (uint32_t i = 0; i < level && i + 1 < entry.levels; ++i) {
+        data += static_cast<size_t>(width) * height * 4;
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    return data;
+}
+
+size_t AssetPack::mipChainSize(uint32_t width, uint32_t height, uint32_t* levels) {
+    size_t size = 0;
+    uint32_t count = 0;
+    if (width > 0 && height > 0) {
+        while (true) {
+            size += static_cast<size_t>(width) * height * 4;
+            ++count;
+            if (width == 1 && height == 1) {
+                break;
+            }
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+    }
+    if (levels) {
+        *levels = count;
+    }
+    return size;
+}
+
+std::string AssetPack::getPath(const Entry& entry) const {
+    return std::string(paths + entry.pathOffset, entry.pathLength);
+}
+
+bool AssetPack::cook(const std::vector<std::string>& sourcePaths, const std::string& outputPath) {
+    auto start = std::chrono::steady_clock::now();
+    
+    // Entries of the previous pack are reused when the source bytes match
+    AssetPack previous;
+    previous.open(outputPath);
+    
+    struct Cooked {
+        std::string path;
+        Entry entry;
+        std::vector<uint8_t> pixels;
+    };
+    std::vector<Cooked> cooked;
+    std::unordered_set<std::string> seen;
+    int reused = 0;
+    int encoded = 0;
+    
+    for (const std::string& path : sourcePaths) {
+        if (!seen.insert(path).second) {
+            continue;
+        }
+        
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            LOG_WARNING("Cannot cook " + path + ": file not found");
+            continue;
+        }
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        
+        Cooked item;
+        item.path = path;
+        std::memset(&item.entry, 0, sizeof(Entry));
+        item.entry.sourceHash = fnv1a(bytes);
+        item.entry.sourceSize = bytes.size();
+        std::error_code error;
+        item.entry.sourceTime = fileTime(path, error);
+        
+        auto it = previous.entryIndex.find(path);
+        if (it != previous.entryIndex.end() && previous.entries[it->second].sourceHash == item.entry.sourceHash) {
+            const Entry& old = previous.entries[it->second];
+            item.entry.width = old.width;
+            item.entry.height = old.height;
+            item.entry.levels = old.levels;
+            const uint8_t* data = previous.mapped + old.dataOffset;
+            item.pixels.assign(data, data + old.dataSize);
+            reused++;
+        } else if (encode(path, item.entry, item.pixels)) {
+            encoded++;
+        } else {
+            continue;
+        }
+        cooked.push_back(std::move(item));
+    }
+    previous.close();
+    
+    // Lay out: header, entries, paths, then each mip chain aligned
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.entryCount = cooked.size();
+    header.pathsOffset = sizeof(Header) + cooked.size() * sizeof(Entry);
+    std::string pathBlob;
+    for (Cooked& item : cooked) {
+        item.entry.pathOffset = static_cast<uint32_t>(pathBlob.size());
+        item.entry.pathLength = static_cast<uint32_t>(item.path.size());
+        pathBlob += item.path;
+    }
+    header.pathsSize = pathBlob.size();
+    
+    size_t offset = alignUp(header.pathsOffset + header.pathsSize);
+    for (Cooked& item : cooked) {
+        item.entry.dataOffset = offset;
+        item.entry.dataSize = item.pixels.size();
+        offset = alignUp(offset + item.pixels.size());
+    }
+    
+    std::error_code error;
+    std::filesystem::path output(outputPath);
+    if (output.has_parent_path()) {
+        std::filesystem::create_directories(output.parent_path(), error);
+    }
+    
+    // Write beside the target and rename, so a failed cook keeps the old pack
+    const std::string temporaryPath = outputPath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("Cannot write asset pack " + temporaryPath);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const Cooked& item : cooked) {
+            file.write(reinterpret_cast<const char*>(&item.entry), sizeof(Entry));
+        }
+        file.write(pathBlob.data(), pathBlob.size());
+        
+        const char padding[DATA_ALIGNMENT] = {};
+        size_t written = header.pathsOffset + header.pathsSize;
+        for (const Cooked& item : cooked) {
+            file.write(padding, item.entry.dataOffset - written);
+            file.write(reinterpret_cast<const char*>(item.pixels.data()), item.pixels.size());
+            written = item.entry.dataOffset + item.pixels.size();
+        }
+        if (!file) {
+            LOG_ERROR("Failed writing asset pack " + temporaryPath);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(temporaryPath, outputPath, error);
+    if (error) {
+        LOG_ERROR("Cannot replace asset pack " + outputPath + ": " + error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << "Cooked " << cooked.size() << " textures into " << outputPath << " ("
+       << (offset / (1024.0 * 1024.0)) << " MB, " << encoded << " encoded, " << reused
+       << " unchanged) in " << elapsed << " ms";
+    LOG_INFO(ss.str());
+    return true;
+}
@@ -1,68 +1,32 @@
 #include "rendering/BatchRenderer.h"
+#include "rendering/RecordingBackend.h"
+#include "utils/Logger.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <sstream>
 
-// Batch renderer vertex shader
-const char* batchVertexShader = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec4 aColor;
-layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in float aTexIndex;
-
-out vec4 vColor;
-out vec2 vTexCoord;
-out float vTexIndex;
-
-uniform mat4 view;
-uniform mat4 projection;
-
-void main() {
-    gl_Position = projection * view * vec4(aPos, 1.0);
-    vColor = aColor;
-    vTexCoord = aTexCoord;
-    vTexIndex = aTexIndex;
-}
-)";
-
-// Batch renderer fragment shader
-const char* batchFragmentShader = R"(
-#version 330 core
-out vec4 FragColor;
-
-in vec4 vColor;
-in vec2 vTexCoord;
-in float vTexIndex;
-
-uniform sampler2D textures[32];
-
-void main() {
-    int index = int(vTexIndex);
-    vec4 texColor = texture(textures[index], vTexCoord);
-    FragColor = texColor * vColor;
-}
-)";
-
-BatchRenderer::BatchRenderer()
-    : VAO(0)
-    , VBO(0)
-    , EBO(0)
+BatchRenderer::BatchRenderer(RenderBackend* backend)
+    : backend(backend)
     , maxQuads(0)
     , currentQuadCount(0)
+    , instancing(false)
+    , uploadedRectCount(0)
+    , batchNumber(1)
     , viewMatrix(1.0f)
     , projectionMatrix(1.0f)
     , drawCallCount(0)
     , quadCount(0)
+    , instancedQuadCount(0)
 {
+    std::fill(std::begin(spriteCache), std::end(spriteCache), SpriteKey{});
 }
 
 BatchRenderer::~BatchRenderer() {
-    if (VAO != 0) {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
-    }
 }
 
 bool BatchRenderer::initialize(size_t maxQuadCount) {
@@ -71,68 +35,73 @@ bool BatchRenderer::initialize(size_t maxQuadCount) {
     // Reserve space for vertices (4 vertices per quad)
     vertices.reserve(maxQuadCount * 4);
     
-    // Reserve space for textures (max 32 texture slots)
-    textures.reserve(32);
+    // Reserve space for textures (one per backend texture slot)
+    textures.reserve(RenderBackend::MAX_TEXTURE_SLOTS);
     
-    // Create batch shader
-    if (!createBatchShader()) {
-        std::cerr << "Failed to create batch shader" << std::endl;
+    if (!backend) {
+        std::cerr << "Batch renderer requires a render backend" << std::endl;
         return false;
     }
     
-    // Setup buffers
-    setupBuffers();
+    setInstancingEnabled(true);
+    if (instancing) {
+        instances.reserve(maxQuadCount);
+    }
     
-    std::cout << "Batch renderer initialized (max " << maxQuads << " quads)" << std::endl;
+    std::cout << "Batch renderer initialized (max " << maxQuads << " quads, "
+              << (instancing ? "instanced" : "vertex") << " sprites)" << std::endl;
     return true;
 }
 
 void BatchRenderer::begin() {
     vertices.clear();
+    instances.clear();
     textures.clear();
+    batchNumber++;
     currentQuadCount = 0;
 }
 
+void BatchRenderer::setInstancingEnabled(bool enabled) {
+    flush();
+    instancing = enabled && backend && backend->supportsInstancing();
+}
+
 void BatchRenderer::end() {
     flush();
 }
 
 void BatchRenderer::flush() {
-    if (vertices.empty()) {
+    if (currentQuadCount == 0) {
         return;
     }
     
-    // Upload vertex data
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
-    
     // Bind textures
     for (size_t i = 0; i < textures.size(); ++i) {
-        if (textures[i]) {
-            textures[i]->bind(static_cast<int>(i));
-        }
+        backend->bindTexture(static_cast<int>(i), textures[i]);
     }
     
-    // Set texture samplers
-    shader->use();
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
-    for (int i = 0; i < 32; ++i) {
-        shader->setInt(("textures[" + std::to_string(i) + "]").c_str(), i);
+    // Draw (a batch is either all instances or all vertices)
+    backend->setViewProjection(viewMatrix, projectionMatrix);
+    if (!instances.empty()) {
+        if (uploadedRectCount != spriteRects.size()) {
+            backend->setSpriteRects(spriteRects.data(), spriteRects.size());
+            uploadedRectCount = spriteRects.size();
+        }
+        backend->drawSprites(instances.data(), instances.size());
+        instancedQuadCount += instances.size();
+    } else {
+        backend->drawQuads(vertices.data(), currentQuadCount);
     }
     
-    // Draw
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(currentQuadCount * 6), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-    
     // Update statistics
     drawCallCount++;
     quadCount += currentQuadCount;
     
     // Clear batch
     vertices.clear();
+    instances.clear();
     textures.clear();
+    batchNumber++;
     currentQuadCount = 0;
 }
 
@@ -146,11 +115,24 @@ void BatchRenderer::drawQuad(
     const glm::vec2& texCoordMax,
     float depth)
 {
-    // Check if we need to flush
-    if (currentQuadCount >= maxQuads || textures.size() >= 32) {
+    // Check if we need to flush (full, or the other path has quads pending)
+    const bool instanced = instancing && rotation == 0.0f;
+    if (currentQuadCount >= maxQuads || (instanced ? !vertices.empty() : !instances.empty())) {
         flush();
     }
     
+    if (instanced) {
+        // A cache hit is handled here without calls; misses fill the entry
+        SpriteKey& sprite = spriteCache[spriteCacheIndex(texture, texCoordMin)];
+        if (sprite.texture != texture || sprite.batch != batchNumber || sprite.rect.size != size ||
+            sprite.rect.texCoordMin != texCoordMin || sprite.rect.texCoordMax != texCoordMax) {
+            cacheSprite(sprite, texture, SpriteRect{ size, texCoordMin, texCoordMax });
+        }
+        instances.push_back(SpriteInstance{ position, depth, packColor(color), sprite.rectIndex, sprite.texSlot });
+        currentQuadCount++;
+        return;
+    }
+    
     // Get texture index
     float texIndex = getTextureIndex(texture);
     
@@ -191,7 +173,7 @@ void BatchRenderer::drawQuad(
     };
     
     for (int i = 0; i < 4; ++i) {
-        Vertex vertex;
+        QuadVertex vertex;
         vertex.position = glm::vec3(quadVertices[i], depth);
         vertex.color = color;
         vertex.texCoord = texCoords[i];
@@ -213,80 +195,30 @@ void BatchRenderer::setProjectionMatrix(const glm::mat4& projection) {
 void BatchRenderer::resetStatistics() {
     drawCallCount = 0;
     quadCount = 0;
-}
-
-void BatchRenderer::setupBuffers() {
-    // Generate VAO, VBO, EBO
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-    
-    // Create VBO
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, maxQuads * 4 * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
-    
-    // Create EBO
-    std::vector<unsigned int> indices;
-    indices.reserve(maxQuads * 6);
-    for (size_t i = 0; i < maxQuads; ++i) {
-        unsigned int offset = static_cast<unsigned int>(i * 4);
-        indices.push_back(offset + 0);
-        indices.push_back(offset + 1);
-        indices.push_back(offset + 2);
-        indices.push_back(offset + 2);
-        indices.push_back(offset + 3);
-        indices.push_back(offset + 0);
-    }
-    
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-    
-    // Setup vertex attributes
-    // Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    
-    // Color
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-    
-    // TexCoord
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-    
-    // TexIndex
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texIndex));
-    
-    glBindVertexArray(0);
-}
-
-bool BatchRenderer::createBatchShader() {
-    shader = std::make_unique<Shader>();
-    
-    if (!shader->loadFromSource(batchVertexShader, batchFragmentShader)) {
-        std::cerr << "Failed to create batch shader" << std::endl;
-        return false;
-    }
-    
-    return true;
+    instancedQuadCount = 0;
 }
 
 float BatchRenderer::getTextureIndex(const Texture* texture) {
     if (!texture) {
-        return 0.0f;
+        return -1.0f; // Untextured: vertex color only
     }
     
-    // Check if texture is already in the batch
+    // Check if texture is already in the batch (textures in the batch are
+    // resident: eviction happens between frames)
     for (size_t i = 0; i < textures.size(); ++i) {
         if (textures[i] == texture) {
             return static_cast<float>(i);
         }
     }
     
+    if (!texture->isResident()) {
+        // Evicted: untextured until the reload this requests completes
+        texture->markUsed();
+        return -1.0f;
+    }
+    
     // Add new texture
-    if (textures.size() >= 32) {
+    if (textures.size() >= static_cast<size_t>(RenderBackend::MAX_TEXTURE_SLOTS)) {
         // Need to flush if we run out of texture slots
         flush();
     }
@@ -294,3 +226,142 @@ float BatchRenderer::getTextureIndex(const Texture* texture) {
     textures.push_back(texture);
     return static_cast<float>(textures.size() - 1);
 }
+
+size_t BatchRenderer::spriteCacheIndex(const Texture* texture, const glm::vec2& texCoordMin) {
+    // Texture + rect origin picks the entry: one multiply, where the full
+    // RectHash would cost as much as the rest of a hit. Atlas regions of
+    // one texture differ in origin, so they rarely share an entry.
+    uint32_t x;
+    uint32_t y;
+    std::memcpy(&x, &texCoordMin.x, sizeof(x));
+    std::memcpy(&y, &texCoordMin.y, sizeof(y));
+    uint64_t hash = (reinterpret_cast<uintptr_t>(texture) ^ x ^ (static_cast<uint64_t>(y) << 32)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) % SPRITE_CACHE_SIZE;
+}
+
+void BatchRenderer::cacheSprite(SpriteKey& sprite, const Texture* texture, const SpriteRect& rect) {
+    // Rect first: restarting a full table flushes, which resets texture slots
+    uint16_t rectIndex = getSpriteRect(rect);
+    float slot = getTextureIndex(texture);
+    // After both lookups: either may have flushed and advanced batchNumber
+    sprite = SpriteKey{ texture, rect, batchNumber, rectIndex,
+                        slot < 0.0f ? SpriteInstance::UNTEXTURED : static_cast<uint16_t>(slot) };
+}
+
+uint16_t BatchRenderer::getSpriteRect(const SpriteRect& rect) {
+    auto it = rectLookup.find(rect);
+    if (it == rectLookup.end()) {
+        // Table full: pending sprites still refer to it, so draw them first
+        if (spriteRects.size() >= MAX_SPRITE_RECTS) {
+            flush();
+            spriteRects.clear();
+            rectLookup.clear();
+            std::fill(std::begin(spriteCache), std::end(spriteCache), SpriteKey{});
+            uploadedRectCount = 0;
+        }
+        
+        it = rectLookup.emplace(rect, static_cast<uint16_t>(spriteRects.size())).first;
+        spriteRects.push_back(rect);
+    }
+    return it->second;
+}
+
+uint32_t BatchRenderer::packColor(const glm::vec4& color) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+}
+
+size_t BatchRenderer::RectHash::operator()(const SpriteRect& rect) const {
+    // One independent multiply per float (no serial chain, this runs per
+    // sprite), then fold the high bits down for the cache's low-bit index
+    uint32_t words[6];
+    std::memcpy(words, &rect, sizeof(words));
+    uint64_t hash = (words[0] * 0x9E3779B97F4A7C15ull) ^ (words[1] * 0xC2B2AE3D27D4EB4Full) ^
+                    (words[2] * 0x165667B19E3779F9ull) ^ (words[3] * 0xD6E8FEB86659FD93ull) ^
+                    (words[4] * 0xFF51AFD7ED558CCDull) ^ (words[5] * 0xC4CEB9FE1A85EC53ull);
+    hash ^= hash >> 32;
+    hash ^= hash >> 16;
+    return static_cast<size_t>(hash);
+}
+
+bool BatchRenderer::RectEqual::operator()(const SpriteRect& a, const SpriteRect& b) const {
+    return a.size == b.size && a.texCoordMin == b.texCoordMin && a.texCoordMax == b.texCoordMax;
+}
+
+void BatchRenderer::runBenchmark(size_t spriteCount, int iterations) {
+    LOG_INFO("Sprite batch benchmark: " + std::to_string(spriteCount) + " sprites, " +
+             std::to_string(iterations) + " iterations");
+    
+    // Counters only: measures building the batches, not copying them
+    RecordingBackend recorder;
+    recorder.initialize();
+    recorder.setCaptureCommands(false);
+    
+    // A frame of tiles and props: a few textures and sprite sizes. The
+    // textures must be resident (non-resident ones draw untextured), so
+    // give them small CPU-side pixels; nothing is uploaded anyway.
+    Texture textures[8];
+    const bool wasCpuOnly = Texture::isCpuOnly();
+    Texture::setCpuOnly(true);
+    std::vector<unsigned char> pixels(4 * 4 * 4);
+    for (int i = 0; i < 8; ++i) {
+        std::fill(pixels.begin(), pixels.end(), static_cast<unsigned char>(32 * i));
+        textures[i].loadFromMemory(pixels.data(), 4, 4, 4);
+    }
+    Texture::setCpuOnly(wasCpuOnly);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> positionDist(-4000.0f, 4000.0f);
+    std::uniform_int_distribution<int> variantDist(0, 7);
+    std::vector<glm::vec2> positions(spriteCount);
+    std::vector<int> variants(spriteCount);
+    for (size_t i = 0; i < spriteCount; ++i) {
+        positions[i] = glm::vec2(positionDist(rng), positionDist(rng));
+        variants[i] = variantDist(rng);
+    }
+    
+    // Random order is the worst case; the draw list's sort makes sprites
+    // with the same texture and size arrive in runs far more often
+    for (int order = 0; order < 2; ++order) {
+        if (order == 1) {
+            std::sort(variants.begin(), variants.end());
+        }
+        
+        double milliseconds[2] = { 0.0, 0.0 };
+        uint64_t bytes[2] = { 0, 0 };
+        for (int path = 0; path < 2; ++path) {
+            recorder.setInstancingSupported(path == 1);
+            BatchRenderer batch(&recorder);
+            batch.initialize();
+            
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                recorder.beginFrame();
+                auto start = std::chrono::steady_clock::now();
+                batch.begin();
+                for (size_t i = 0; i < spriteCount; ++i) {
+                    int variant = variants[i];
+                    batch.drawQuad(
+                        positions[i],
+                        glm::vec2(64.0f, 32.0f + 16.0f * (variant & 3)),
+                        &textures[variant],
+                        glm::vec4(1.0f, 1.0f, 1.0f, 0.5f + 0.0625f * variant)
+                    );
+                }
+                batch.end();
+                milliseconds[path] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                recorder.endFrame();
+            }
+            milliseconds[path] /= iterations;
+            bytes[path] = recorder.getFrameCounters().uploadBytes;
+        }
+        
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3) << (order == 0 ? "Random order" : "Texture runs")
+           << " - vertex path: " << milliseconds[0] << " ms/frame, " << (bytes[0] / 1024) << " KB/frame; "
+           << "instanced: " << milliseconds[1] << " ms/frame, " << (bytes[1] / 1024) << " KB/frame ("
+           << std::setprecision(1) << (milliseconds[0] / milliseconds[1]) << "x CPU, "
+           << (static_cast<double>(bytes[0]) / static_cast<double>(std::max<uint64_t>(bytes[1], 1))) << "x bytes)";
+        LOG_INFO(ss.str());
+    }
+}
@@ -1,7 +1,9 @@
 #include "rendering/Camera.h"
+#include <algorithm>
 
 Camera::Camera(float x, float y)
     : position(x, y)
+    , zoom(1.0f)
     , speed(300.0f)
 {
 }
@@ -21,6 +23,18 @@ void Camera::setPosition(float x, float y) {
     position.y = y;
 }
 
+void Camera::setZoom(float newZoom) {
+    zoom = std::clamp(newZoom, MIN_ZOOM, MAX_ZOOM);
+}
+
+void Camera::zoomAt(float factor, const glm::vec2& screenPos, float screenWidth, float screenHeight) {
+    glm::vec2 anchor = screenToWorld(screenPos, screenWidth, screenHeight);
+    setZoom(zoom * factor);
+    
+    // Shift so the anchor lands back under the same screen position
+    position += anchor - screenToWorld(screenPos, screenWidth, screenHeight);
+}
+
 glm::mat4 Camera::getViewMatrix() const {
     // Create a view matrix that translates the world by camera position
     // In 2D, we simply translate by negative camera position
@@ -29,9 +43,9 @@ glm::mat4 Camera::getViewMatrix() const {
 
 glm::mat4 Camera::getProjectionMatrix(float screenWidth, float screenHeight) const {
     // Orthographic projection for 2D
-    // Origin at center of screen
-    float halfWidth = screenWidth / 2.0f;
-    float halfHeight = screenHeight / 2.0f;
+    // Origin at center of screen; zooming out widens the visible area
+    float halfWidth = screenWidth / (2.0f * zoom);
+    float halfHeight = screenHeight / (2.0f * zoom);
     
     return glm::ortho(
         -halfWidth, halfWidth,    // left, right
@@ -42,14 +56,14 @@ glm::mat4 Camera::getProjectionMatrix(float screenWidth, float screenHeight) con
 
 glm::vec2 Camera::screenToWorld(const glm::vec2& screenPos, float screenWidth, float screenHeight) const {
     // Convert screen coordinates (0,0 = top-left) to world coordinates
-    float worldX = screenPos.x - screenWidth / 2.0f + position.x;
-    float worldY = -(screenPos.y - screenHeight / 2.0f) + position.y;
+    float worldX = (screenPos.x - screenWidth / 2.0f) / zoom + position.x;
+    float worldY = -(screenPos.y - screenHeight / 2.0f) / zoom + position.y;
     return glm::vec2(worldX, worldY);
 }
 
 glm::vec2 Camera::worldToScreen(const glm::vec2& worldPos, float screenWidth, float screenHeight) const {
     // Convert world coordinates to screen coordinates (0,0 = top-left)
-    float screenX = (worldPos.x - position.x) + screenWidth / 2.0f;
-    float screenY = -(worldPos.y - position.y) + screenHeight / 2.0f;
+    float screenX = (worldPos.x - position.x) * zoom + screenWidth / 2.0f;
+    float screenY = -(worldPos.y - position.y) * zoom + screenHeight / 2.0f;
     return glm::vec2(screenX, screenY);
 }
@@ -0,0 +1,121 @@
+#include "rendering/DebugDraw.h"
+#include "ui/UIRenderer.h"
+#include "utils/IsometricUtils.h"
+#include <algorithm>
+#include <cmath>
+
+DebugDraw& DebugDraw::getInstance() {
+    static DebugDraw instance;
+    return instance;
+}
+
+DebugDraw::DebugDraw()
+    : enabledMask(0)
+    , tileWidth(64)
+    , tileHeight(32)
+{
+}
+
+void DebugDraw::setEnabled(Category category, bool enabled) {
+    if (enabled) {
+        enabledMask |= bit(category);
+    } else {
+        enabledMask &= ~bit(category);
+    }
+}
+
+const char* DebugDraw::getCategoryName(Category category) {
+    switch (category) {
+        case Category::General: return "General";
+        case Category::Chunks: return "Chunks";
+        case Category::SpatialHash: return "Spatial hash";
+        case Category::Entities: return "Entities";
+        default: return "Unknown";
+    }
+}
+
+void DebugDraw::line(Category category, const glm::vec2& from, const glm::vec2& to, const glm::vec4& color) {
+    if (isEnabled(category)) {
+        lines.push_back(Line{from, to, color});
+    }
+}
+
+void DebugDraw::circle(Category category, const glm::vec2& center, float radius, const glm::vec4& color) {
+    if (!isEnabled(category)) {
+        return;
+    }
+    
+    constexpr float TWO_PI = 6.28318530717958647692f;
+    glm::vec2 previous = center + glm::vec2(radius, 0.0f);
+    for (int i = 1; i <= CIRCLE_SEGMENTS; ++i) {
+        float angle = TWO_PI * i / CIRCLE_SEGMENTS;
+        glm::vec2 next = center + radius * glm::vec2(std::cos(angle), std::sin(angle));
+        lines.push_back(Line{previous, next, color});
+        previous = next;
+    }
+}
+
+void DebugDraw::tileOutline(Category category, const glm::ivec2& min, const glm::ivec2& max, const glm::vec4& color) {
+    if (!isEnabled(category)) {
+        return;
+    }
+    
+    // Grid corner (x, y) is the top vertex of tile (x, y)'s diamond
+    auto corner = [this](int x, int y) {
+        return IsometricUtils::worldToScreen(x, y, tileWidth, tileHeight) + glm::vec2(tileWidth * 0.5f, 0.0f);
+    };
+    glm::vec2 top = corner(min.x, min.y);
+    glm::vec2 right = corner(max.x + 1, min.y);
+    glm::vec2 bottom = corner(max.x + 1, max.y + 1);
+    glm::vec2 left = corner(min.x, max.y + 1);
+    lines.push_back(Line{top, right, color});
+    lines.push_back(Line{right, bottom, color});
+    lines.push_back(Line{bottom, left, color});
+    lines.push_back(Line{left, top, color});
+}
+
+void DebugDraw::text(Category category, const glm::vec2& position, const std::string& string, const glm::vec3& color) {
+    if (isEnabled(category)) {
+        texts.push_back(Text{position, string, color, false});
+    }
+}
+
+void DebugDraw::screenText(Category category, const glm::vec2& position, const std::string& string, const glm::vec3& color) {
+    if (isEnabled(category)) {
+        texts.push_back(Text{position, string, color, true});
+    }
+}
+
+void DebugDraw::setTileSize(int width, int height) {
+    tileWidth = width;
+    tileHeight = height;
+}
+
+void DebugDraw::flush(UIRenderer& ui, const glm::mat4& worldViewProjection) {
+    const glm::vec2 screen(static_cast<float>(ui.getWidth()), static_cast<float>(ui.getHeight()));
+    auto project = [&](const glm::vec2& point) {
+        glm::vec4 clip = worldViewProjection * glm::vec4(point, 0.0f, 1.0f);
+        return glm::vec2((clip.x / clip.w + 1.0f) * 0.5f * screen.x, (1.0f - clip.y / clip.w) * 0.5f * screen.y);
+    };
+    
+    for (const Line& line : lines) {
+        glm::vec2 from = project(line.from);
+        glm::vec2 to = project(line.to);
+        
+        // Skip lines entirely off one side of the window
+        glm::vec2 low = glm::min(from, to);
+        glm::vec2 high = glm::max(from, to);
+        if (high.x < 0.0f || high.y < 0.0f || low.x > screen.x || low.y > screen.y) {
+            continue;
+        }
+        ui.drawLine(from, to, line.color, LINE_WIDTH);
+    }
+    
+    for (const Text& text : texts) {
+        glm::vec2 position = text.screenSpace ? text.position : project(text.position);
+        ui.drawText(text.text, position.x, position.y, 1.0f, text.color);
+    }
+    
+    lines.clear();
+    texts.clear();
+}
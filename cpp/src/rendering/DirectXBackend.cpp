@@ -163,6 +163,79 @@ void DirectXBackend::setBlendMode(int srcFactor, int dstFactor) {
 #endif
 }
 
+void DirectXBackend::setViewProjection(const glm::mat4& view, const glm::mat4& projection) {
+    (void)view; // Unused - no constant buffers yet
+    (void)projection; // Unused - no constant buffers yet
+}
+
+void DirectXBackend::bindTexture(int slot, const Texture* texture) {
+    (void)slot; // Unused - textures are OpenGL objects for now
+    (void)texture; // Unused - textures are OpenGL objects for now
+}
+
+void DirectXBackend::drawQuads(const QuadVertex* vertices, size_t quadCount) {
+    (void)vertices; // Unused - quad pipeline not implemented for DirectX yet
+    (void)quadCount; // Unused - quad pipeline not implemented for DirectX yet
+}
+
+RenderBackend::GeometryHandle DirectXBackend::createStaticGeometry(const QuadVertex* vertices, size_t quadCount) {
+    (void)vertices; // Unused - quad pipeline not implemented for DirectX yet
+    (void)quadCount; // Unused - quad pipeline not implemented for DirectX yet
+    return INVALID_GEOMETRY;
+}
+
+bool DirectXBackend::updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) {
+    (void)handle; // Unused - quad pipeline not implemented for DirectX yet
+    (void)vertices; // Unused - quad pipeline not implemented for DirectX yet
+    (void)quadCount; // Unused - quad pipeline not implemented for DirectX yet
+    return false;
+}
+
+void DirectXBackend::destroyStaticGeometry(GeometryHandle handle) {
+    (void)handle; // Unused - quad pipeline not implemented for DirectX yet
+}
+
+bool DirectXBackend::supportsInstancing() const {
+    return false;
+}
+
+void DirectXBackend::setSpriteRects(const SpriteRect* rects, size_t rectCount) {
+    (void)rects; // Unused - no instancing support
+    (void)rectCount;
+}
+
+void DirectXBackend::drawSprites(const SpriteInstance* instances, size_t instanceCount) {
+    (void)instances; // Unused - no instancing support
+    (void)instanceCount;
+}
+
+bool DirectXBackend::supportsRenderTargets() const {
+    return false;
+}
+
+RenderBackend::RenderTargetHandle DirectXBackend::createRenderTarget(int width, int height) {
+    (void)width; // Unused - textures are OpenGL objects for now
+    (void)height;
+    return INVALID_TARGET;
+}
+
+void DirectXBackend::destroyRenderTarget(RenderTargetHandle handle) {
+    (void)handle; // Unused - textures are OpenGL objects for now
+}
+
+void DirectXBackend::setRenderTarget(RenderTargetHandle handle) {
+    (void)handle; // Unused - textures are OpenGL objects for now
+}
+
+const Texture* DirectXBackend::getRenderTargetTexture(RenderTargetHandle handle) const {
+    (void)handle; // Unused - textures are OpenGL objects for now
+    return nullptr;
+}
+
+void DirectXBackend::drawStaticGeometry(GeometryHandle handle) {
+    (void)handle; // Unused - quad pipeline not implemented for DirectX yet
+}
+
 const char* DirectXBackend::getName() const {
     return "DirectX 11";
 }
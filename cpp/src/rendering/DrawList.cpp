@@ -0,0 +1,393 @@
+#include "rendering/DrawList.h"
+#include "rendering/BatchRenderer.h"
+#include "rendering/Texture.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace {
+    
+    // Key field layout (see DrawList.h)
+    constexpr int TEXTURE_SHIFT = 24;
+    constexpr int DEPTH_SHIFT = 40;
+    constexpr int LAYER_SHIFT = 60;
+    constexpr int DEPTH_BITS = 20;
+    constexpr int DEPTH_BIAS = 1 << (DEPTH_BITS - 1);
+    constexpr uint64_t DEPTH_MASK = (uint64_t(1) << DEPTH_BITS) - 1;
+    constexpr uint64_t TEXTURE_MASK = 0xFFFF;
+    
+    // Radix digits are at most 11 bits; 40 key bits need at most 4 passes
+    constexpr int MAX_DIGIT_BITS = 11;
+    constexpr int MAX_PASSES = 4;
+    constexpr int MAX_BUCKETS = 1 << MAX_DIGIT_BITS;
+    
+    int bitWidth(uint64_t value) {
+        int bits = 0;
+        while (value != 0) {
+            value >>= 1;
+            ++bits;
+        }
+        return bits;
+    }
+    
+    // One LSD radix pass: a stable scatter into the slots of offsets
+    // (advanced as it goes). decode(element, position, bits, index) gives
+    // the key bits from this pass's digit up and the sprite index;
+    // encode(bits above the digit, index) builds the output element.
+    template <typename Source, typename Destination, typename Decode, typename Encode>
+    void scatter(const Source* source, Destination* destination, size_t count, uint32_t* offsets,
+                 int digitBits, Decode decode, Encode encode) {
+        const uint64_t digitMask = (uint64_t(1) << digitBits) - 1;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t bits;
+            uint32_t index;
+            decode(source[i], i, bits, index);
+            destination[offsets[bits & digitMask]++] = encode(bits >> digitBits, index);
+        }
+    }
+    
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+} // namespace
+
+DrawList::DrawList()
+    : sorted(false)
+    , overflowWarned(false)
+{
+    clear();
+}
+
+void DrawList::clear() {
+    sprites.clear();
+    keys.clear();
+    sorted = false; // order still holds last frame's order
+    minDepth = static_cast<uint32_t>(DEPTH_MASK);
+    maxDepth = 0;
+    maxLayer = 0;
+    textureBits = 0;
+}
+
+void DrawList::reserve(size_t spriteCount) {
+    sprites.reserve(spriteCount);
+    keys.reserve(spriteCount);
+    order.reserve(spriteCount);
+    orderScratch.reserve(spriteCount);
+}
+
+uint64_t DrawList::makeSortKey(Layer layer, int depth, uint32_t textureKey) {
+    // Bias the signed depth into an unsigned field (clamped to its range)
+    int biasedDepth = std::min(std::max(depth + DEPTH_BIAS, 0), (1 << DEPTH_BITS) - 1);
+    return (static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+           (static_cast<uint64_t>(biasedDepth) << DEPTH_SHIFT) |
+           (static_cast<uint64_t>(textureKey & 0xFFFFu) << TEXTURE_SHIFT);
+}
+
+void DrawList::add(
+    Layer layer,
+    int depth,
+    const glm::vec2& position,
+    const glm::vec2& size,
+    const Texture* texture,
+    const glm::vec4& color,
+    const glm::vec2& texCoordMin,
+    const glm::vec2& texCoordMax)
+{
+    if (sprites.size() >= MAX_SPRITES) {
+        if (!overflowWarned) {
+            LOG_WARNING("Draw list full (" + std::to_string(MAX_SPRITES) + " sprites); dropping the rest");
+            overflowWarned = true;
+        }
+        return;
+    }
+    
+    uint64_t key = makeSortKey(layer, depth, texture ? texture->getID() : 0);
+    keys.push_back(key | sprites.size());
+    
+    uint32_t keyDepth = static_cast<uint32_t>((key >> DEPTH_SHIFT) & DEPTH_MASK);
+    minDepth = std::min(minDepth, keyDepth);
+    maxDepth = std::max(maxDepth, keyDepth);
+    maxLayer = std::max(maxLayer, static_cast<uint32_t>(layer));
+    textureBits |= static_cast<uint32_t>((key >> TEXTURE_SHIFT) & TEXTURE_MASK);
+    
+    Sprite sprite;
+    sprite.position = position;
+    sprite.size = size;
+    sprite.color = color;
+    sprite.texCoordMin = texCoordMin;
+    sprite.texCoordMax = texCoordMax;
+    sprite.texture = texture;
+    sprites.push_back(sprite);
+    
+    sorted = false;
+}
+
+void DrawList::sort() {
+    if (sorted) {
+        return;
+    }
+    
+    if (tryPreviousOrder()) {
+        sorted = true;
+        return;
+    }
+    
+    radixSort(bitWidth(maxLayer), bitWidth(maxDepth - minDepth), bitWidth(textureBits));
+    sorted = true;
+}
+
+bool DrawList::tryPreviousOrder() {
+    const size_t count = keys.size();
+    if (count < 2 || order.size() != count) {
+        return false;
+    }
+    
+    // Keys are unique, so sorted means strictly increasing
+    uint64_t previous = keys[order[0]];
+    for (size_t i = 1; i < count; ++i) {
+        uint64_t key = keys[order[i]];
+        if (key <= previous) {
+            return false;
+        }
+        previous = key;
+    }
+    return true;
+}
+
+void DrawList::submit(BatchRenderer& batchRenderer) {
+    sort();
+    
+    for (uint32_t index : order) {
+        const Sprite& sprite = sprites[index];
+        batchRenderer.drawQuad(
+            sprite.position,
+            sprite.size,
+            sprite.texture,
+            sprite.color,
+            0.0f,
+            sprite.texCoordMin,
+            sprite.texCoordMax
+        );
+    }
+}
+
+void DrawList::radixSort(int layerWidth, int depthWidth, int textureWidth) {
+    const size_t count = keys.size();
+    order.resize(count);
+    
+    // Split the key into equal digits of at most 11 bits
+    const int keyBits = layerWidth + depthWidth + textureWidth;
+    const int passes = std::max((keyBits + MAX_DIGIT_BITS - 1) / MAX_DIGIT_BITS, 1);
+    const int digitBits = (keyBits + passes - 1) / passes;
+    const uint64_t digitMask = (uint64_t(1) << digitBits) - 1;
+    const int buckets = 1 << digitBits;
+    
+    // Repack layer | depth - minDepth | texture into as few bits as this
+    // frame needs (the order is unchanged, the sort gets shorter)
+    const uint32_t depthBase = minDepth;
+    auto repack = [=](uint64_t key) {
+        uint64_t packed = key >> LAYER_SHIFT;
+        packed = (packed << depthWidth) | (((key >> DEPTH_SHIFT) & DEPTH_MASK) - depthBase);
+        return (packed << textureWidth) | ((key >> TEXTURE_SHIFT) & TEXTURE_MASK);
+    };
+    
+    // All digit histograms in one pass over the keys. Repacked keys that
+    // fit in 4 bytes are also stored (in order, free until the last pass)
+    // so the first pass reads half the bytes; otherwise it recomputes them.
+    static thread_local uint32_t histograms[MAX_PASSES][MAX_BUCKETS];
+    std::memset(histograms, 0, sizeof(histograms));
+    const bool packedFits = keyBits <= 32;
+    uint32_t* packedKeys = order.data();
+    if (packedFits) {
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t digits = repack(keys[i]);
+            packedKeys[i] = static_cast<uint32_t>(digits);
+            for (int pass = 0; pass < passes; ++pass) {
+                histograms[pass][digits & digitMask]++;
+                digits >>= digitBits;
+            }
+        }
+    } else {
+        for (uint64_t key : keys) {
+            uint64_t digits = repack(key);
+            for (int pass = 0; pass < passes; ++pass) {
+                histograms[pass][digits & digitMask]++;
+                digits >>= digitBits;
+            }
+        }
+    }
+    
+    // A digit every key shares doesn't reorder anything
+    const uint64_t firstKey = count > 0 ? repack(keys[0]) : 0;
+    auto sharedDigit = [&](int pass) {
+        return histograms[pass][(firstKey >> (pass * digitBits)) & digitMask] == count;
+    };
+    int lastPass = -1;
+    for (int pass = 0; pass < passes; ++pass) {
+        if (!sharedDigit(pass)) {
+            lastPass = pass;
+        }
+    }
+    if (lastPass < 0) {
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        return;
+    }
+    
+    // The first pass reads the repacked keys. Later passes move the bits not
+    // sorted yet with the index: 8 bytes (bits << 24 | index) until they
+    // fit in 4 (bits << indexBits | index), a sprite index by the last.
+    const int indexBits = std::max(bitWidth(count - 1), 1);
+    const uint32_t indexMask = static_cast<uint32_t>((uint64_t(1) << indexBits) - 1);
+    uint64_t* wideSource = nullptr;
+    uint32_t* narrowSource = nullptr;
+    int base = 0; // Key bit the moved elements' bits start at
+    orderScratch.resize(count);
+    
+    for (int pass = 0; pass <= lastPass; ++pass) {
+        if (sharedDigit(pass)) {
+            continue;
+        }
+        
+        // Exclusive prefix sum -> first output slot per bucket
+        uint32_t* histogram = histograms[pass];
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < buckets; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        
+        // Ping-pong buffers; a second 8-byte pass writes over the keys
+        const int shift = pass * digitBits;
+        const bool narrow = narrowSource || keyBits - shift - digitBits + indexBits <= 32;
+        if (!narrow) {
+            scratch.resize(count);
+        }
+        uint64_t* wideDestination = wideSource == scratch.data() ? keys.data() : scratch.data();
+        uint32_t* narrowDestination = narrowSource == orderScratch.data() ? order.data() : orderScratch.data();
+        auto runPass = [&](const auto* source, auto decode) {
+            if (pass == lastPass) {
+                scatter(source, narrowDestination, count, histogram, digitBits, decode,
+                        [](uint64_t, uint32_t index) { return index; });
+                narrowSource = narrowDestination;
+            } else if (narrow) {
+                scatter(source, narrowDestination, count, histogram, digitBits, decode,
+                        [=](uint64_t above, uint32_t index) { return static_cast<uint32_t>(above << indexBits) | index; });
+                narrowSource = narrowDestination;
+            } else {
+                scatter(source, wideDestination, count, histogram, digitBits, decode,
+                        [](uint64_t above, uint32_t index) { return (above << TEXTURE_SHIFT) | index; });
+                wideSource = wideDestination;
+            }
+        };
+        
+        const int skip = shift - base;
+        if (narrowSource) {
+            runPass(narrowSource, [=](uint32_t element, size_t, uint64_t& bits, uint32_t& index) {
+                bits = (element >> indexBits) >> skip;
+                index = element & indexMask;
+            });
+        } else if (wideSource) {
+            runPass(wideSource, [=](uint64_t element, size_t, uint64_t& bits, uint32_t& index) {
+                bits = (element >> TEXTURE_SHIFT) >> skip;
+                index = static_cast<uint32_t>(element & INDEX_MASK);
+            });
+        } else if (packedFits) {
+            runPass(packedKeys, [=](uint32_t key, size_t position, uint64_t& bits, uint32_t& index) {
+                bits = static_cast<uint64_t>(key) >> shift;
+                index = static_cast<uint32_t>(position);
+            });
+        } else {
+            runPass(keys.data(), [=](uint64_t key, size_t position, uint64_t& bits, uint32_t& index) {
+                bits = repack(key) >> shift;
+                index = static_cast<uint32_t>(position);
+            });
+        }
+        base = shift + digitBits;
+    }
+    
+    // The last pass wrote to either index buffer
+    if (narrowSource != order.data()) {
+        order.swap(orderScratch);
+    }
+}
+
+void DrawList::runBenchmark(size_t spriteCount, int iterations) {
+    spriteCount = std::min(spriteCount, MAX_SPRITES);
+    LOG_INFO("Draw list benchmark: " + std::to_string(spriteCount) + " sprites, " +
+             std::to_string(iterations) + " iterations");
+    
+    // A plausible frame: mostly objects over a 256x256 world, a few textures
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> depthDist(-256 * 2 * 16, 0);
+    std::uniform_int_distribution<int> layerDist(0, 9);
+    std::uniform_int_distribution<uint32_t> textureDist(1, 48);
+    
+    std::vector<uint64_t> original(spriteCount);
+    for (size_t i = 0; i < spriteCount; ++i) {
+        int roll = layerDist(rng);
+        Layer layer = roll == 0 ? Layer::Ground : (roll == 9 ? Layer::Overlay : Layer::Objects);
+        original[i] = makeSortKey(layer, depthDist(rng), textureDist(rng)) | i;
+    }
+    
+    // Reference order: keys are unique, so std::sort is stable here
+    std::vector<uint64_t> reference = original;
+    auto start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        reference = original;
+        std::sort(reference.begin(), reference.end());
+    }
+    double stdSortMs = millisecondsSince(start) / iterations;
+    
+    // The draw list path: repack + radix sort into the order (sprite
+    // payloads aren't touched). Even iterations are cold sorts; odd ones resubmit the same
+    // frame, which last frame's order sorts.
+    DrawList list;
+    list.reserve(spriteCount);
+    list.sprites.resize(spriteCount);
+    double radixMs = 0.0;
+    double unchangedMs = 0.0;
+    bool matches = true;
+    for (int iteration = 0; iteration < iterations * 2; ++iteration) {
+        if (iteration % 2 == 0) {
+            list.order.clear();
+        }
+        list.keys = original;
+        list.sorted = false;
+        list.minDepth = static_cast<uint32_t>(DEPTH_MASK);
+        list.maxDepth = 0;
+        list.maxLayer = 0;
+        list.textureBits = 0;
+        for (uint64_t key : original) {
+            uint32_t keyDepth = static_cast<uint32_t>((key >> DEPTH_SHIFT) & DEPTH_MASK);
+            list.minDepth = std::min(list.minDepth, keyDepth);
+            list.maxDepth = std::max(list.maxDepth, keyDepth);
+            list.maxLayer = std::max(list.maxLayer, static_cast<uint32_t>(key >> LAYER_SHIFT));
+            list.textureBits |= static_cast<uint32_t>((key >> TEXTURE_SHIFT) & TEXTURE_MASK);
+        }
+        
+        start = std::chrono::steady_clock::now();
+        list.sort();
+        (iteration % 2 == 0 ? radixMs : unchangedMs) += millisecondsSince(start);
+        
+        for (size_t i = 0; i < spriteCount && matches; ++i) {
+            matches = list.order[i] == (reference[i] & INDEX_MASK);
+        }
+    }
+    radixMs /= iterations;
+    unchangedMs /= iterations;
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "Draw list sort: " << radixMs << " ms/frame (" << unchangedMs << " unchanged), std::sort: " << stdSortMs
+       << " ms/frame (" << std::setprecision(1) << (stdSortMs / radixMs) << "x), order "
+       << (matches ? "identical" : "MISMATCH");
+    LOG_INFO(ss.str());
+}
@@ -0,0 +1,136 @@
+#include "rendering/DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution()
+    : enabled(false)
+    , targetFrameTime(1000.0f / 60.0f)
+    , minScale(0.5f)
+    , maxScale(1.0f)
+    , scale(1.0f)
+    , smoothedRenderTime(0.0f)
+    , framesSinceChange(0)
+    , scaleChanges(0)
+    , historyNext(0)
+{
+}
+
+void DynamicResolution::setEnabled(bool enable) {
+    if (enable && !enabled) {
+        scale = maxScale;
+        smoothedRenderTime = 0.0f;
+        framesSinceChange = 0;
+        scaleChanges = 0;
+        frameTimes.clear();
+        renderTimes.clear();
+        scales.clear();
+        historyNext = 0;
+    }
+    enabled = enable;
+}
+
+void DynamicResolution::setTargetFrameTime(float milliseconds) {
+    if (milliseconds > 0.0f) {
+        targetFrameTime = milliseconds;
+    }
+}
+
+void DynamicResolution::setScaleRange(float newMin, float newMax) {
+    maxScale = std::clamp(newMax, 0.1f, 1.0f);
+    minScale = std::clamp(newMin, 0.1f, maxScale);
+    scale = std::clamp(scale, minScale, maxScale);
+}
+
+bool DynamicResolution::update(float frameTime, float renderTime) {
+    if (!enabled) {
+        return false;
+    }
+    
+    // History (scale in effect for this frame)
+    if (frameTimes.size() < HISTORY_SIZE) {
+        frameTimes.push_back(frameTime);
+        renderTimes.push_back(renderTime);
+        scales.push_back(scale);
+    } else {
+        frameTimes[historyNext] = frameTime;
+        renderTimes[historyNext] = renderTime;
+        scales[historyNext] = scale;
+    }
+    historyNext = (historyNext + 1) % HISTORY_SIZE;
+    
+    smoothedRenderTime = smoothedRenderTime > 0.0f
+        ? smoothedRenderTime + SMOOTHING * (renderTime - smoothedRenderTime)
+        : renderTime;
+    
+    if (++framesSinceChange < ADJUST_INTERVAL || smoothedRenderTime <= 0.0f) {
+        return false;
+    }
+    
+    float newScale = scale;
+    if (smoothedRenderTime > targetFrameTime * OVER_BUDGET) {
+        newScale = scale * std::sqrt(targetFrameTime / smoothedRenderTime);
+    } else if (smoothedRenderTime < targetFrameTime * UNDER_BUDGET) {
+        newScale = scale + GROW_STEP;
+    }
+    newScale = std::clamp(newScale, minScale, maxScale);
+    if (std::fabs(newScale - scale) < 0.005f) {
+        return false;
+    }
+    
+    // The old measurements describe the old resolution; predict the new cost
+    smoothedRenderTime *= (newScale * newScale) / (scale * scale);
+    scale = newScale;
+    framesSinceChange = 0;
+    scaleChanges++;
+    return true;
+}
+
+glm::ivec2 DynamicResolution::getRenderSize(int width, int height) const {
+    float renderScale = enabled ? scale : 1.0f;
+    return glm::ivec2(
+        std::max(1, static_cast<int>(std::lround(width * renderScale))),
+        std::max(1, static_cast<int>(std::lround(height * renderScale)))
+    );
+}
+
+void DynamicResolution::copyHistory(const std::vector<float>& ring, std::vector<float>& out) const {
+    out.clear();
+    if (ring.size() < HISTORY_SIZE) {
+        out.assign(ring.begin(), ring.end());
+        return;
+    }
+    out.reserve(HISTORY_SIZE);
+    out.insert(out.end(), ring.begin() + historyNext, ring.end());
+    out.insert(out.end(), ring.begin(), ring.begin() + historyNext);
+}
+
+void DynamicResolution::getFrameTimeHistory(std::vector<float>& out) const {
+    copyHistory(frameTimes, out);
+}
+
+void DynamicResolution::getScaleHistory(std::vector<float>& out) const {
+    copyHistory(scales, out);
+}
+
+DynamicResolution::Stats DynamicResolution::getStats() const {
+    Stats stats = {};
+    stats.scale = scale;
+    stats.minScale = scale;
+    stats.targetFrameTime = targetFrameTime;
+    stats.scaleChanges = scaleChanges;
+    if (frameTimes.empty()) {
+        return stats;
+    }
+    
+    double frameTotal = 0.0;
+    double renderTotal = 0.0;
+    for (size_t i = 0; i < frameTimes.size(); ++i) {
+        frameTotal += frameTimes[i];
+        renderTotal += renderTimes[i];
+        stats.maxFrameTime = std::max(stats.maxFrameTime, frameTimes[i]);
+        stats.minScale = std::min(stats.minScale, scales[i]);
+    }
+    stats.averageFrameTime = static_cast<float>(frameTotal / frameTimes.size());
+    stats.averageRenderTime = static_cast<float>(renderTotal / renderTimes.size());
+    return stats;
+}
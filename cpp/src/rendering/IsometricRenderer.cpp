@@ -1,5 +1,7 @@
 #include "rendering/IsometricRenderer.h"
+#include "rendering/DrawList.h"
 #include "utils/IsometricUtils.h"
+#include <algorithm>
 
 IsometricRenderer::IsometricRenderer(Renderer* renderer, Camera* camera)
     : renderer(renderer)
@@ -90,6 +92,50 @@ void IsometricRenderer::drawIsometricCube(
     );
 }
 
+void IsometricRenderer::addIsometricCube(
+    DrawList& drawList,
+    int gridX, int gridY,
+    float height,
+    const glm::vec4& topColor,
+    const glm::vec4& leftColor,
+    const glm::vec4& rightColor)
+{
+    // Same faces as drawIsometricCube; equal keys keep this order
+    glm::vec2 basePos = gridToScreen(gridX, gridY);
+    int depth = IsometricUtils::getRenderOrder(gridX + 0.5f, gridY + 0.5f);
+    
+    // Too small for the faces to tell apart: the outline in their mean color
+    float pixelsPerUnit = renderer->getPixelsPerUnit();
+    if (pixelsPerUnit > 0.0f && tileWidth * pixelsPerUnit < LOW_DETAIL_TILE_PIXELS) {
+        drawList.add(
+            DrawList::Layer::Objects, depth,
+            basePos + glm::vec2(0, -height),
+            glm::vec2(tileWidth, std::max(height + tileHeight / 2.0f, static_cast<float>(tileHeight))),
+            nullptr, (topColor + leftColor + rightColor) / 3.0f
+        );
+        return;
+    }
+    
+    drawList.add(
+        DrawList::Layer::Objects, depth,
+        basePos + glm::vec2(0, -height),
+        glm::vec2(tileWidth / 2.0f, height + tileHeight / 2.0f),
+        nullptr, leftColor
+    );
+    drawList.add(
+        DrawList::Layer::Objects, depth,
+        basePos + glm::vec2(tileWidth / 2.0f, -height),
+        glm::vec2(tileWidth / 2.0f, height + tileHeight / 2.0f),
+        nullptr, rightColor
+    );
+    drawList.add(
+        DrawList::Layer::Objects, depth,
+        basePos + glm::vec2(0, -height),
+        glm::vec2(tileWidth, tileHeight),
+        nullptr, topColor
+    );
+}
+
 glm::vec2 IsometricRenderer::gridToScreen(int gridX, int gridY) const {
     return IsometricUtils::worldToScreen(gridX, gridY, tileWidth, tileHeight);
 }
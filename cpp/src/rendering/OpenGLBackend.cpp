@@ -1,10 +1,138 @@
 #include "rendering/OpenGLBackend.h"
+#include "rendering/Texture.h"
 #include "utils/Logger.h"
 #include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+// Linked programs are cached here between launches
+static const char* SHADER_CACHE_DIRECTORY = "cache/shaders";
+
+// Quad vertex shader (positions are already in world space)
+static const char* quadVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in float aTexIndex;
+
+out vec4 vColor;
+out vec2 vTexCoord;
+flat out int vTexIndex;
+
+layout (std140) uniform Matrices {
+    mat4 view;
+    mat4 projection;
+};
+
+void main() {
+    gl_Position = projection * view * vec4(aPos, 1.0);
+    vColor = aColor;
+    vTexCoord = aTexCoord;
+    vTexIndex = int(aTexIndex);
+}
+)";
+
+// Instanced sprite vertex shader: expands one SpriteInstance into a
+// four-vertex triangle strip using the sprite rect table
+static const char* spriteVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPosDepth;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in uvec2 aRectSlot;
+
+out vec4 vColor;
+out vec2 vTexCoord;
+flat out int vTexIndex;
+
+layout (std140) uniform Matrices {
+    mat4 view;
+    mat4 projection;
+};
+uniform samplerBuffer spriteRects; // size.xy, uvMin.xy | uvMax.xy, unused
+
+void main() {
+    // Strip order: (0,0) (1,0) (0,1) (1,1) - corner (0,0) is the position
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    int rect = int(aRectSlot.x) * 2;
+    vec4 sizeUvMin = texelFetch(spriteRects, rect);
+    vec2 uvMax = texelFetch(spriteRects, rect + 1).xy;
+    
+    gl_Position = projection * view * vec4(aPosDepth.xy + sizeUvMin.xy * corner, aPosDepth.z, 1.0);
+    vColor = aColor;
+    vTexCoord = mix(sizeUvMin.zw, uvMax, corner);
+    vTexIndex = aRectSlot.y == 65535u ? -1 : int(aRectSlot.y);
+}
+)";
+
+// Quad fragment shader (also used by the sprite pipeline). GLSL 3.30 only allows constant sampler array
+// indices, hence the switch instead of textures[vTexIndex].
+static const char* quadFragmentShader = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec4 vColor;
+in vec2 vTexCoord;
+flat in int vTexIndex;
+
+uniform sampler2D textures[16];
+
+vec4 sampleSlot(int slot, vec2 uv) {
+    switch (slot) {
+        case 0: return texture(textures[0], uv);
+        case 1: return texture(textures[1], uv);
+        case 2: return texture(textures[2], uv);
+        case 3: return texture(textures[3], uv);
+        case 4: return texture(textures[4], uv);
+        case 5: return texture(textures[5], uv);
+        case 6: return texture(textures[6], uv);
+        case 7: return texture(textures[7], uv);
+        case 8: return texture(textures[8], uv);
+        case 9: return texture(textures[9], uv);
+        case 10: return texture(textures[10], uv);
+        case 11: return texture(textures[11], uv);
+        case 12: return texture(textures[12], uv);
+        case 13: return texture(textures[13], uv);
+        case 14: return texture(textures[14], uv);
+        case 15: return texture(textures[15], uv);
+    }
+    return vec4(1.0);
+}
+
+void main() {
+    if (vTexIndex < 0) {
+        FragColor = vColor;
+    } else {
+        FragColor = sampleSlot(vTexIndex, vTexCoord) * vColor;
+    }
+}
+)";
 
 OpenGLBackend::OpenGLBackend()
     : initialized(false)
+    , quadShader(nullptr)
+    , VAO(0)
+    , EBO(0)
+    , fallbackTexture(0)
+    , nextGeometryHandle(1)
+    , spriteShader(nullptr)
+    , spriteVAO(0)
+    , rectBuffer(0)
+    , rectTexture(0)
+    , nextRenderTarget(1)
+    , currentRenderTarget(INVALID_TARGET)
+    , gpuTimerIssued(0)
+    , gpuTimerRead(0)
+    , gpuFrameTime(0.0f)
 {
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    std::memset(screenViewport, 0, sizeof(screenViewport));
+    std::memset(gpuTimerQueries, 0, sizeof(gpuTimerQueries));
 }
 
 OpenGLBackend::~OpenGLBackend() {
@@ -39,10 +167,47 @@ bool OpenGLBackend::initialize() {
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LEQUAL);
     
-    // Enable back-face culling for performance
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
+    // No face culling: 2D quads reach the backend with either winding
+    // depending on the projection's Y direction
+    glDisable(GL_CULL_FACE);
+    
+    if (!createStreams()) {
+        LOG_ERROR("Failed to create OpenGL stream buffers");
+        std::cerr << "Failed to create OpenGL stream buffers" << std::endl;
+        return false;
+    }
+    
+    const unsigned char white[4] = { 255, 255, 255, 255 };
+    glGenTextures(1, &fallbackTexture);
+    glBindTexture(GL_TEXTURE_2D, fallbackTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    if (shaderLibrary.enableBinaryCache(SHADER_CACHE_DIRECTORY)) {
+        LOG_INFO(std::string("Program binary cache: ") + SHADER_CACHE_DIRECTORY);
+    }
+    
+    if (!createQuadPipeline()) {
+        LOG_ERROR("Failed to create OpenGL quad pipeline");
+        std::cerr << "Failed to create OpenGL quad pipeline" << std::endl;
+        return false;
+    }
+    
+    // Optional: without it BatchRenderer keeps submitting quads
+    if (!createSpritePipeline()) {
+        LOG_WARNING("Instanced sprites unavailable; using quad batches");
+    }
+    
+    // Cold start: everything compiled; warm start: everything from the cache
+    const ShaderLibrary::LoadStats& shaderStats = shaderLibrary.getLoadStats();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "Shaders ready (" << (shaderStats.compiled == 0 ? "warm" : (shaderStats.fromCache == 0 ? "cold" : "partly warm"))
+       << " start): " << shaderStats.fromCache << " from cache in " << shaderStats.cacheMilliseconds << " ms, "
+       << shaderStats.compiled << " compiled in " << shaderStats.compileMilliseconds << " ms";
+    LOG_INFO(ss.str());
     
     initialized = true;
     LOG_INFO("OpenGL backend initialized successfully");
@@ -55,15 +220,64 @@ void OpenGLBackend::shutdown() {
     }
     
     LOG_INFO("Shutting down OpenGL backend");
+    setRenderTarget(INVALID_TARGET);
+    renderTargets.clear();
+    if (gpuTimerQueries[0] != 0) {
+        glDeleteQueries(GPU_TIMER_QUERIES, gpuTimerQueries);
+        std::memset(gpuTimerQueries, 0, sizeof(gpuTimerQueries));
+    }
+    destroySpritePipeline();
+    destroyQuadPipeline();
+    destroyStreams();
+    if (fallbackTexture != 0) {
+        glDeleteTextures(1, &fallbackTexture);
+        fallbackTexture = 0;
+    }
     initialized = false;
 }
 
 void OpenGLBackend::beginFrame() {
-    // Nothing special needed for OpenGL
+    // Textures may have been bound behind our back (uploads, UI); forget the cache
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    shaderLibrary.beginFrame();
+    
+    if (gpuTimerQueries[0] == 0 && glGenQueries) {
+        glGenQueries(GPU_TIMER_QUERIES, gpuTimerQueries);
+    }
+    if (gpuTimerQueries[0] != 0) {
+        // Collect finished frames oldest first; stop at the first pending one
+        while (gpuTimerRead < gpuTimerIssued) {
+            GLuint query = gpuTimerQueries[gpuTimerRead % GPU_TIMER_QUERIES];
+            GLint available = 0;
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                break;
+            }
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+            gpuFrameTime = static_cast<float>(nanoseconds / 1.0e6);
+            gpuTimerRead++;
+        }
+        
+        // The GPU is a whole ring behind: give up on the oldest result
+        if (gpuTimerIssued - gpuTimerRead >= static_cast<uint64_t>(GPU_TIMER_QUERIES)) {
+            gpuTimerRead++;
+        }
+        glBeginQuery(GL_TIME_ELAPSED, gpuTimerQueries[gpuTimerIssued % GPU_TIMER_QUERIES]);
+        gpuTimerIssued++;
+    }
 }
 
 void OpenGLBackend::endFrame() {
-    // Nothing special needed for OpenGL
+    // Fence this frame's stream regions; the next frame writes elsewhere
+    if (vertexStream) {
+        vertexStream->endFrame();
+    }
+    shaderLibrary.endFrame();
+    
+    if (gpuTimerQueries[0] != 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
 }
 
 void OpenGLBackend::clear(float r, float g, float b, float a) {
@@ -77,6 +291,13 @@ void OpenGLBackend::clearDepth() {
 
 void OpenGLBackend::setViewport(int x, int y, int width, int height) {
     glViewport(x, y, width, height);
+    if (currentRenderTarget != INVALID_TARGET) {
+        GLint* viewport = renderTargets[currentRenderTarget].viewport;
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = width;
+        viewport[3] = height;
+    }
 }
 
 void OpenGLBackend::enableDepthTest(bool enable) {
@@ -99,6 +320,415 @@ void OpenGLBackend::setBlendMode(int srcFactor, int dstFactor) {
     glBlendFunc(srcFactor, dstFactor);
 }
 
+void OpenGLBackend::setViewProjection(const glm::mat4& view, const glm::mat4& projection) {
+    shaderLibrary.setViewProjection(view, projection);
+}
+
+void OpenGLBackend::bindTexture(int slot, const Texture* texture) {
+    if (slot < 0 || slot >= MAX_TEXTURE_SLOTS) {
+        return;
+    }
+    
+    // Marking an evicted texture used is what brings it back
+    GLuint id = fallbackTexture;
+    if (texture) {
+        texture->markUsed();
+        if (texture->getID() != 0) {
+            id = texture->getID();
+        }
+    }
+    if (boundTextures[slot] == id) {
+        return;
+    }
+    
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, id);
+    boundTextures[slot] = id;
+}
+
+void OpenGLBackend::drawQuads(const QuadVertex* vertices, size_t quadCount) {
+    if (quadCount == 0) {
+        return;
+    }
+    
+    quadShader->use();
+    glBindVertexArray(VAO);
+    
+    // Larger submissions are split to fit the index buffer
+    for (size_t first = 0; first < quadCount; first += MAX_QUADS_PER_DRAW) {
+        size_t count = std::min(quadCount - first, MAX_QUADS_PER_DRAW);
+        size_t offset = vertexStream->write(vertices + first * 4, count * 4 * sizeof(QuadVertex), sizeof(QuadVertex));
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(count * 6), GL_UNSIGNED_INT, 0,
+                                 static_cast<GLint>(offset / sizeof(QuadVertex)));
+    }
+    
+    glBindVertexArray(0);
+}
+
+RenderBackend::GeometryHandle OpenGLBackend::createStaticGeometry(const QuadVertex* vertices, size_t quadCount) {
+    if (quadCount == 0 || quadCount > MAX_QUADS_PER_DRAW) {
+        LOG_ERROR("Static geometry must hold 1 to " + std::to_string(MAX_QUADS_PER_DRAW) + " quads");
+        return INVALID_GEOMETRY;
+    }
+    
+    StaticGeometry geometry;
+    geometry.quadCount = quadCount;
+    geometry.capacity = quadCount;
+    
+    glGenVertexArrays(1, &geometry.vao);
+    glBindVertexArray(geometry.vao);
+    
+    glGenBuffers(1, &geometry.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
+    glBufferData(GL_ARRAY_BUFFER, quadCount * 4 * sizeof(QuadVertex), vertices, GL_STATIC_DRAW);
+    
+    // The index pattern is the same for every quad buffer
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    setupQuadVertexAttributes();
+    
+    glBindVertexArray(0);
+    
+    GeometryHandle handle = nextGeometryHandle++;
+    staticGeometry[handle] = geometry;
+    return handle;
+}
+
+bool OpenGLBackend::updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end() || quadCount > MAX_QUADS_PER_DRAW) {
+        return false;
+    }
+    
+    StaticGeometry& geometry = it->second;
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
+    if (quadCount > geometry.capacity) {
+        glBufferData(GL_ARRAY_BUFFER, quadCount * 4 * sizeof(QuadVertex), vertices, GL_STATIC_DRAW);
+        geometry.capacity = quadCount;
+    } else if (quadCount > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, quadCount * 4 * sizeof(QuadVertex), vertices);
+    }
+    geometry.quadCount = quadCount;
+    return true;
+}
+
+void OpenGLBackend::destroyStaticGeometry(GeometryHandle handle) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end()) {
+        return;
+    }
+    
+    glDeleteVertexArrays(1, &it->second.vao);
+    glDeleteBuffers(1, &it->second.vbo);
+    staticGeometry.erase(it);
+}
+
+void OpenGLBackend::drawStaticGeometry(GeometryHandle handle) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end() || it->second.quadCount == 0) {
+        return;
+    }
+    
+    quadShader->use();
+    glBindVertexArray(it->second.vao);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(it->second.quadCount * 6), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+bool OpenGLBackend::supportsInstancing() const {
+    return spriteShader != nullptr;
+}
+
+void OpenGLBackend::setSpriteRects(const SpriteRect* rects, size_t rectCount) {
+    if (!spriteShader || rectCount == 0) {
+        return;
+    }
+    
+    rectTexels.resize(rectCount * 2);
+    for (size_t i = 0; i < rectCount; ++i) {
+        rectTexels[i * 2] = glm::vec4(rects[i].size.x, rects[i].size.y, rects[i].texCoordMin.x, rects[i].texCoordMin.y);
+        rectTexels[i * 2 + 1] = glm::vec4(rects[i].texCoordMax.x, rects[i].texCoordMax.y, 0.0f, 0.0f);
+    }
+    
+    // The table only changes when new rects appear; reallocate each time
+    glBindBuffer(GL_TEXTURE_BUFFER, rectBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, rectTexels.size() * sizeof(glm::vec4), rectTexels.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+bool OpenGLBackend::supportsRenderTargets() const {
+    return glBlendFuncSeparate != nullptr;
+}
+
+RenderBackend::RenderTargetHandle OpenGLBackend::createRenderTarget(int width, int height) {
+    if (!supportsRenderTargets() || width <= 0 || height <= 0) {
+        return INVALID_TARGET;
+    }
+    
+    auto framebuffer = std::make_unique<Framebuffer>();
+    bool created = framebuffer->create(width, height, false);
+    
+    // Creating the color texture rebound the active unit
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    if (!created) {
+        return INVALID_TARGET;
+    }
+    
+    // Creation unbinds every framebuffer: return to the one being drawn
+    if (currentRenderTarget != INVALID_TARGET) {
+        const RenderTarget& current = renderTargets[currentRenderTarget];
+        current.framebuffer->bind();
+        glViewport(current.viewport[0], current.viewport[1], current.viewport[2], current.viewport[3]);
+    }
+    
+    RenderTargetHandle handle = nextRenderTarget++;
+    RenderTarget& target = renderTargets[handle];
+    target.framebuffer = std::move(framebuffer);
+    target.viewport[0] = 0;
+    target.viewport[1] = 0;
+    target.viewport[2] = width;
+    target.viewport[3] = height;
+    return handle;
+}
+
+void OpenGLBackend::destroyRenderTarget(RenderTargetHandle handle) {
+    if (handle == currentRenderTarget) {
+        setRenderTarget(INVALID_TARGET);
+    }
+    renderTargets.erase(handle);
+}
+
+void OpenGLBackend::setRenderTarget(RenderTargetHandle handle) {
+    if (handle == currentRenderTarget) {
+        return;
+    }
+    auto it = renderTargets.find(handle);
+    if (handle != INVALID_TARGET && it == renderTargets.end()) {
+        return;
+    }
+    
+    if (currentRenderTarget == INVALID_TARGET) {
+        glGetIntegerv(GL_VIEWPORT, screenViewport);
+    }
+    
+    if (handle != INVALID_TARGET) {
+        // Color accumulates premultiplied, alpha as coverage
+        const GLint* viewport = it->second.viewport;
+        it->second.framebuffer->bind();
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(screenViewport[0], screenViewport[1], screenViewport[2], screenViewport[3]);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    currentRenderTarget = handle;
+}
+
+const Texture* OpenGLBackend::getRenderTargetTexture(RenderTargetHandle handle) const {
+    auto it = renderTargets.find(handle);
+    return it != renderTargets.end() ? it->second.framebuffer->getColorTexture() : nullptr;
+}
+
+void OpenGLBackend::drawSprites(const SpriteInstance* instances, size_t instanceCount) {
+    if (!spriteShader || instanceCount == 0) {
+        return;
+    }
+    
+    spriteShader->use();
+    glActiveTexture(GL_TEXTURE0 + SPRITE_RECT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, rectTexture);
+    glBindVertexArray(spriteVAO);
+    
+    // No base instance in GL 3.3: re-point the instance attributes instead
+    for (size_t first = 0; first < instanceCount; first += MAX_SPRITES_PER_DRAW) {
+        size_t count = std::min(instanceCount - first, MAX_SPRITES_PER_DRAW);
+        size_t offset = vertexStream->write(instances + first, count * sizeof(SpriteInstance), sizeof(SpriteInstance));
+        setupSpriteAttributes(offset);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+    }
+    
+    glBindVertexArray(0);
+}
+
+bool OpenGLBackend::createStreams() {
+    if (!glMapBufferRange || !glBindBufferRange) {
+        return false;
+    }
+    
+    // Persistent mapping needs glBufferStorage (GL 4.4); older contexts map
+    // unsynchronized ranges behind fences
+    int major = 0;
+    int minor = 0;
+    bool allowPersistent = std::sscanf(versionString.c_str(), "%d.%d", &major, &minor) == 2 &&
+                           (major > 4 || (major == 4 && minor >= 4));
+    
+    vertexStream = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, VERTEX_STREAM_REGION);
+    if (!vertexStream->initialize(allowPersistent) || !shaderLibrary.initializeFrameUniforms(allowPersistent)) {
+        destroyStreams();
+        return false;
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void OpenGLBackend::destroyStreams() {
+    if (vertexStream && vertexStream->getStats().writes > 0) {
+        const StreamBuffer::Stats& stats = vertexStream->getStats();
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1)
+           << "Vertex stream (" << StreamBuffer::modeName(vertexStream->getMode()) << "): "
+           << (stats.bytesStreamed / (1024.0 * 1024.0)) << " MB in " << stats.writes << " writes, "
+           << stats.stallsAvoided << " without waiting, " << stats.stalls << " stalls, "
+           << stats.orphans << " orphans";
+        LOG_INFO(ss.str());
+    }
+    
+    vertexStream.reset();
+    shaderLibrary.shutdownFrameUniforms();
+}
+
+void OpenGLBackend::setTextureSlots(const Shader& shader) {
+    static constexpr Shader::UniformId TEXTURES = Shader::uniformId("textures");
+    
+    // Samplers never change: slot i reads texture unit i
+    int units[MAX_TEXTURE_SLOTS];
+    for (int i = 0; i < MAX_TEXTURE_SLOTS; ++i) {
+        units[i] = i;
+    }
+    shader.use();
+    shader.setIntArray(TEXTURES, units, MAX_TEXTURE_SLOTS);
+}
+
+bool OpenGLBackend::createQuadPipeline() {
+    if (!shaderLibrary.loadFromSource("quad", quadVertexShader, quadFragmentShader)) {
+        return false;
+    }
+    quadShader = shaderLibrary.get("quad");
+    setTextureSlots(*quadShader);
+    
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexStream->getBuffer());
+    
+    // Shared index pattern: two triangles per quad
+    std::vector<unsigned int> indices;
+    indices.reserve(MAX_QUADS_PER_DRAW * 6);
+    for (size_t i = 0; i < MAX_QUADS_PER_DRAW; ++i) {
+        unsigned int offset = static_cast<unsigned int>(i * 4);
+        indices.push_back(offset + 0);
+        indices.push_back(offset + 1);
+        indices.push_back(offset + 2);
+        indices.push_back(offset + 2);
+        indices.push_back(offset + 3);
+        indices.push_back(offset + 0);
+    }
+    
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    
+    setupQuadVertexAttributes();
+    
+    glBindVertexArray(0);
+    return true;
+}
+
+void OpenGLBackend::setupQuadVertexAttributes() {
+    // Position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, position));
+    
+    // Color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, color));
+    
+    // TexCoord
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, texCoord));
+    
+    // TexIndex
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, texIndex));
+}
+
+void OpenGLBackend::destroyQuadPipeline() {
+    for (auto& entry : staticGeometry) {
+        glDeleteVertexArrays(1, &entry.second.vao);
+        glDeleteBuffers(1, &entry.second.vbo);
+    }
+    staticGeometry.clear();
+    
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &EBO);
+        VAO = EBO = 0;
+    }
+    shaderLibrary.remove("quad");
+    quadShader = nullptr;
+}
+
+bool OpenGLBackend::createSpritePipeline() {
+    if (!glDrawArraysInstanced || !glVertexAttribDivisor || !glVertexAttribIPointer || !glTexBuffer) {
+        return false;
+    }
+    
+    if (!shaderLibrary.loadFromSource("sprite", spriteVertexShader, quadFragmentShader)) {
+        return false;
+    }
+    spriteShader = shaderLibrary.get("sprite");
+    setTextureSlots(*spriteShader);
+    spriteShader->setInt("spriteRects", SPRITE_RECT_UNIT);
+    
+    glGenBuffers(1, &rectBuffer);
+    glGenTextures(1, &rectTexture);
+    glBindBuffer(GL_TEXTURE_BUFFER, rectBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, 2 * sizeof(glm::vec4), nullptr, GL_STATIC_DRAW);
+    glActiveTexture(GL_TEXTURE0 + SPRITE_RECT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, rectTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, rectBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    
+    glGenVertexArrays(1, &spriteVAO);
+    glBindVertexArray(spriteVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexStream->getBuffer());
+    
+    for (GLuint attribute = 0; attribute < 3; ++attribute) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    setupSpriteAttributes(0);
+    
+    glBindVertexArray(0);
+    LOG_INFO("Instanced sprite pipeline ready (" + std::to_string(sizeof(SpriteInstance)) + " bytes per sprite)");
+    return true;
+}
+
+void OpenGLBackend::setupSpriteAttributes(size_t offset) {
+    // Position + depth
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, position)));
+    
+    // Color (normalized RGBA8)
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, color)));
+    
+    // Rect index, texture slot
+    glVertexAttribIPointer(2, 2, GL_UNSIGNED_SHORT, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, rect)));
+}
+
+void OpenGLBackend::destroySpritePipeline() {
+    if (spriteVAO != 0) {
+        glDeleteVertexArrays(1, &spriteVAO);
+        spriteVAO = 0;
+    }
+    if (rectTexture != 0) {
+        glDeleteTextures(1, &rectTexture);
+        glDeleteBuffers(1, &rectBuffer);
+        rectTexture = rectBuffer = 0;
+    }
+    shaderLibrary.remove("sprite");
+    spriteShader = nullptr;
+}
+
 const char* OpenGLBackend::getName() const {
     return "OpenGL";
 }
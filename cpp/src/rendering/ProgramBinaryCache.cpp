@@ -0,0 +1,177 @@
+#include "rendering/ProgramBinaryCache.h"
+#include "rendering/Shader.h"
+#include "utils/Logger.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    
+    // File layout: Header, driver string, program binary
+    constexpr char MAGIC[4] = { 'D', 'G', 'P', 'B' };
+    constexpr uint32_t FORMAT_VERSION = 1;
+    
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        uint32_t binaryFormat;
+        uint32_t driverLength;
+        uint64_t binaryLength;
+    };
+    
+    uint64_t fnv1a(uint64_t hash, const char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+        }
+        return hash;
+    }
+    
+    std::string glString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+    
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& directory)
+    : directory(directory)
+    , enabled(false)
+{
+}
+
+bool ProgramBinaryCache::initialize() {
+    enabled = false;
+    if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri) {
+        return false;
+    }
+    
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0) {
+        LOG_INFO("Program binary cache disabled: the driver offers no binary formats");
+        return false;
+    }
+    
+    try {
+        std::filesystem::create_directories(directory);
+    } catch (const std::exception& e) {
+        LOG_WARNING(std::string("Program binary cache disabled: ") + e.what());
+        return false;
+    }
+    
+    driver = glString(GL_VENDOR) + " | " + glString(GL_RENDERER) + " | " + glString(GL_VERSION);
+    enabled = true;
+    return true;
+}
+
+uint64_t ProgramBinaryCache::makeKey(const char* vertexSource, const char* fragmentSource) const {
+    // Include the terminators so moving text between the stages changes the key
+    uint64_t hash = 14695981039346656037ull;
+    hash = fnv1a(hash, vertexSource, std::strlen(vertexSource) + 1);
+    hash = fnv1a(hash, fragmentSource, std::strlen(fragmentSource) + 1);
+    return fnv1a(hash, driver.data(), driver.size());
+}
+
+bool ProgramBinaryCache::load(uint64_t key, Shader& shader) const {
+    if (!enabled) {
+        return false;
+    }
+    
+    const std::string path = pathFor(key);
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    // A truncated or corrupt entry is deleted (and recompiled and stored
+    // again by the caller); its lengths must not size any allocation
+    auto discard = [&path](const char* reason) {
+        LOG_WARNING("Discarding program binary cache entry " + path + ": " + reason);
+        std::error_code removeError;
+        std::filesystem::remove(path, removeError);
+        return false;
+    };
+    
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return discard("bad header");
+    }
+    if (header.driverLength > fileSize - sizeof(header) ||
+        header.binaryLength != fileSize - sizeof(header) - header.driverLength ||
+        header.binaryLength == 0) {
+        return discard("lengths don't match the file size");
+    }
+    if (header.version != FORMAT_VERSION || header.key != key ||
+        header.driverLength != driver.size()) {
+        return false;
+    }
+    
+    // The key already covers the driver; comparing it guards against collisions
+    std::string fileDriver(header.driverLength, '\0');
+    std::vector<uint8_t> binary(static_cast<size_t>(header.binaryLength));
+    if (!file.read(&fileDriver[0], fileDriver.size()) || fileDriver != driver ||
+        !file.read(reinterpret_cast<char*>(binary.data()), binary.size())) {
+        return false;
+    }
+    
+    return shader.loadFromBinary(static_cast<GLenum>(header.binaryFormat), binary.data(), binary.size());
+}
+
+bool ProgramBinaryCache::store(uint64_t key, const Shader& shader) const {
+    if (!enabled) {
+        return false;
+    }
+    
+    GLenum format = 0;
+    std::vector<uint8_t> binary;
+    if (!shader.getBinary(format, binary)) {
+        return false;
+    }
+    
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.key = key;
+    header.binaryFormat = format;
+    header.driverLength = static_cast<uint32_t>(driver.size());
+    header.binaryLength = binary.size();
+    
+    // Write a temporary file and rename it, so a crash never leaves half an entry
+    const std::string path = pathFor(key);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(driver.data(), driver.size());
+        file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        if (!file) {
+            return false;
+        }
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+std::string ProgramBinaryCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / name).string();
+}
@@ -0,0 +1,531 @@
+#include "rendering/RecordingBackend.h"
+#include "rendering/Texture.h"
+#include "utils/Logger.h"
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    
+    // Four vertices of an instanced sprite, as the GL sprite shader builds them
+    void expandSprite(const SpriteInstance& sprite, const SpriteRect& rect, QuadVertex* out) {
+        const glm::vec4 color(
+            (sprite.color & 0xFF) / 255.0f,
+            ((sprite.color >> 8) & 0xFF) / 255.0f,
+            ((sprite.color >> 16) & 0xFF) / 255.0f,
+            (sprite.color >> 24) / 255.0f
+        );
+        const float texIndex = sprite.texSlot == SpriteInstance::UNTEXTURED ? -1.0f : static_cast<float>(sprite.texSlot);
+        
+        // Quad order: top-left, top-right, bottom-right, bottom-left
+        static const glm::vec2 corners[4] = {
+            glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 0.0f)
+        };
+        for (int i = 0; i < 4; ++i) {
+            const glm::vec2& corner = corners[i];
+            out[i].position = glm::vec3(sprite.position + rect.size * corner, sprite.depth);
+            out[i].color = color;
+            out[i].texCoord = rect.texCoordMin + (rect.texCoordMax - rect.texCoordMin) * corner;
+            out[i].texIndex = texIndex;
+        }
+    }
+    
+} // namespace
+
+RecordingBackend::RecordingBackend()
+    : initialized(false)
+    , keepHistory(false)
+    , captureCommands(true)
+    , instancing(true)
+    , nextGeometryHandle(1)
+{
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+}
+
+RecordingBackend::~RecordingBackend() {
+    shutdown();
+}
+
+bool RecordingBackend::initialize() {
+    if (initialized) {
+        LOG_WARNING("Recording backend already initialized");
+        return true;
+    }
+    
+    LOG_INFO("Initializing recording backend (no GPU)");
+    initialized = true;
+    return true;
+}
+
+void RecordingBackend::shutdown() {
+    if (!initialized) {
+        return;
+    }
+    
+    LOG_INFO("Shutting down recording backend");
+    reset();
+    staticGeometry.clear();
+    activeRects.clear();
+    initialRects.clear();
+    initialized = false;
+}
+
+void RecordingBackend::reset() {
+    commands.clear();
+    vertices.clear();
+    spriteInstances.clear();
+    spriteRects.clear();
+    initialRects = activeRects;
+    matrices.clear();
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    currentFrame = Counters();
+    lastFrame = Counters();
+    total = Counters();
+}
+
+RecordingBackend::Command& RecordingBackend::record(CommandType type) {
+    count(&Counters::commands);
+    
+    // With capture off the returned command is scratch space
+    static thread_local Command scratch;
+    Command& command = captureCommands ? commands.emplace_back() : scratch;
+    std::memset(&command, 0, sizeof(Command));
+    command.type = type;
+    return command;
+}
+
+void RecordingBackend::count(uint64_t Counters::*field, uint64_t amount) {
+    currentFrame.*field += amount;
+    total.*field += amount;
+}
+
+void RecordingBackend::beginFrame() {
+    if (!keepHistory) {
+        commands.clear();
+        vertices.clear();
+        spriteInstances.clear();
+        spriteRects.clear();
+        matrices.clear();
+        initialRects = activeRects;
+    }
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    currentFrame = Counters();
+    
+    record(CommandType::BeginFrame);
+}
+
+void RecordingBackend::endFrame() {
+    record(CommandType::EndFrame);
+    count(&Counters::frames);
+    lastFrame = currentFrame;
+}
+
+void RecordingBackend::clear(float r, float g, float b, float a) {
+    Command& command = record(CommandType::Clear);
+    command.values[0] = r;
+    command.values[1] = g;
+    command.values[2] = b;
+    command.values[3] = a;
+    count(&Counters::clears);
+}
+
+void RecordingBackend::clearDepth() {
+    record(CommandType::ClearDepth);
+    count(&Counters::clears);
+}
+
+void RecordingBackend::setViewport(int x, int y, int width, int height) {
+    Command& command = record(CommandType::SetViewport);
+    command.ints[0] = x;
+    command.ints[1] = y;
+    command.ints[2] = width;
+    command.ints[3] = height;
+    count(&Counters::stateChanges);
+}
+
+void RecordingBackend::enableDepthTest(bool enable) {
+    record(CommandType::EnableDepthTest).ints[0] = enable ? 1 : 0;
+    count(&Counters::stateChanges);
+}
+
+void RecordingBackend::enableBlending(bool enable) {
+    record(CommandType::EnableBlending).ints[0] = enable ? 1 : 0;
+    count(&Counters::stateChanges);
+}
+
+void RecordingBackend::setBlendMode(int srcFactor, int dstFactor) {
+    Command& command = record(CommandType::SetBlendMode);
+    command.ints[0] = srcFactor;
+    command.ints[1] = dstFactor;
+    count(&Counters::stateChanges);
+}
+
+void RecordingBackend::setViewProjection(const glm::mat4& view, const glm::mat4& projection) {
+    Command& command = record(CommandType::SetViewProjection);
+    if (captureCommands) {
+        command.index = static_cast<uint32_t>(matrices.size() / 2);
+        matrices.push_back(view);
+        matrices.push_back(projection);
+    }
+    count(&Counters::stateChanges);
+}
+
+void RecordingBackend::bindTexture(int slot, const Texture* texture) {
+    if (slot < 0 || slot >= MAX_TEXTURE_SLOTS) {
+        return;
+    }
+    
+    Command& command = record(CommandType::BindTexture);
+    command.ints[0] = slot;
+    command.texture = texture;
+    if (texture) {
+        texture->markUsed();
+    }
+    
+    count(&Counters::textureBinds);
+    if (boundTextures[slot] == texture) {
+        count(&Counters::redundantTextureBinds);
+    }
+    boundTextures[slot] = texture;
+}
+
+void RecordingBackend::drawQuads(const QuadVertex* quadVertices, size_t quadCount) {
+    if (quadCount == 0) {
+        return;
+    }
+    
+    Command& command = record(CommandType::DrawQuads);
+    command.count = static_cast<uint32_t>(quadCount);
+    if (captureCommands) {
+        command.index = static_cast<uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), quadVertices, quadVertices + quadCount * 4);
+    }
+    
+    count(&Counters::drawCalls);
+    count(&Counters::quads, quadCount);
+    count(&Counters::uploadBytes, quadCount * 4 * sizeof(QuadVertex));
+}
+
+void RecordingBackend::setSpriteRects(const SpriteRect* rects, size_t rectCount) {
+    if (!instancing || rectCount == 0) {
+        return;
+    }
+    
+    activeRects.assign(rects, rects + rectCount);
+    
+    Command& command = record(CommandType::SetSpriteRects);
+    command.count = static_cast<uint32_t>(rectCount);
+    if (captureCommands) {
+        command.index = static_cast<uint32_t>(spriteRects.size());
+        spriteRects.insert(spriteRects.end(), rects, rects + rectCount);
+    }
+    
+    count(&Counters::uploadBytes, rectCount * sizeof(SpriteRect));
+}
+
+void RecordingBackend::drawSprites(const SpriteInstance* instances, size_t instanceCount) {
+    if (!instancing || instanceCount == 0) {
+        return;
+    }
+    
+    Command& command = record(CommandType::DrawSprites);
+    command.count = static_cast<uint32_t>(instanceCount);
+    if (captureCommands) {
+        command.index = static_cast<uint32_t>(spriteInstances.size());
+        spriteInstances.insert(spriteInstances.end(), instances, instances + instanceCount);
+    }
+    
+    count(&Counters::drawCalls);
+    count(&Counters::quads, instanceCount);
+    count(&Counters::instancedQuads, instanceCount);
+    count(&Counters::uploadBytes, instanceCount * sizeof(SpriteInstance));
+}
+
+bool RecordingBackend::supportsRenderTargets() const {
+    // Recordings capture what reaches the screen only
+    return false;
+}
+
+RenderBackend::RenderTargetHandle RecordingBackend::createRenderTarget(int width, int height) {
+    (void)width; // Unused - no render target support
+    (void)height;
+    return INVALID_TARGET;
+}
+
+void RecordingBackend::destroyRenderTarget(RenderTargetHandle handle) {
+    (void)handle; // Unused - no render target support
+}
+
+void RecordingBackend::setRenderTarget(RenderTargetHandle handle) {
+    (void)handle; // Unused - no render target support
+}
+
+const Texture* RecordingBackend::getRenderTargetTexture(RenderTargetHandle handle) const {
+    (void)handle; // Unused - no render target support
+    return nullptr;
+}
+
+RenderBackend::GeometryHandle RecordingBackend::createStaticGeometry(const QuadVertex* quadVertices, size_t quadCount) {
+    if (quadCount == 0) {
+        return INVALID_GEOMETRY;
+    }
+    
+    GeometryHandle handle = nextGeometryHandle++;
+    staticGeometry[handle].assign(quadVertices, quadVertices + quadCount * 4);
+    
+    Command& command = record(CommandType::CreateGeometry);
+    command.index = handle;
+    command.count = static_cast<uint32_t>(quadCount);
+    count(&Counters::geometryUploads);
+    return handle;
+}
+
+bool RecordingBackend::updateStaticGeometry(GeometryHandle handle, const QuadVertex* quadVertices, size_t quadCount) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end()) {
+        return false;
+    }
+    
+    it->second.assign(quadVertices, quadVertices + quadCount * 4);
+    
+    Command& command = record(CommandType::UpdateGeometry);
+    command.index = handle;
+    command.count = static_cast<uint32_t>(quadCount);
+    count(&Counters::geometryUploads);
+    return true;
+}
+
+void RecordingBackend::destroyStaticGeometry(GeometryHandle handle) {
+    if (staticGeometry.erase(handle) > 0) {
+        record(CommandType::DestroyGeometry).index = handle;
+    }
+}
+
+void RecordingBackend::drawStaticGeometry(GeometryHandle handle) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end() || it->second.empty()) {
+        return;
+    }
+    
+    size_t quadCount = it->second.size() / 4;
+    Command& command = record(CommandType::DrawGeometry);
+    command.index = handle;
+    command.count = static_cast<uint32_t>(quadCount);
+    
+    count(&Counters::drawCalls);
+    count(&Counters::quads, quadCount);
+}
+
+size_t RecordingBackend::getStaticGeometryQuadCount(GeometryHandle handle) const {
+    auto it = staticGeometry.find(handle);
+    return it != staticGeometry.end() ? it->second.size() / 4 : 0;
+}
+
+const char* RecordingBackend::getName() const {
+    return "Recording";
+}
+
+const char* RecordingBackend::getVersion() const {
+    return "1.0";
+}
+
+RenderBackendType RecordingBackend::getType() const {
+    return RenderBackendType::Recording;
+}
+
+void RecordingBackend::replay(RenderBackend& target) const {
+    // Recorded handle -> handle in the target backend
+    std::unordered_map<GeometryHandle, GeometryHandle> targetGeometry;
+    auto uploadGeometry = [&](GeometryHandle handle) {
+        auto source = staticGeometry.find(handle);
+        if (source == staticGeometry.end()) {
+            return; // Destroyed later in the capture; contents are gone
+        }
+        
+        const QuadVertex* data = source->second.data();
+        size_t quadCount = source->second.size() / 4;
+        auto it = targetGeometry.find(handle);
+        if (it == targetGeometry.end()) {
+            targetGeometry[handle] = target.createStaticGeometry(data, quadCount);
+        } else {
+            target.updateStaticGeometry(it->second, data, quadCount);
+        }
+    };
+    
+    // Latest rect table, for expanding sprites when the target can't instance
+    const SpriteRect* rectTable = initialRects.data();
+    size_t rectTableSize = initialRects.size();
+    std::vector<QuadVertex> expanded;
+    if (rectTableSize > 0 && target.supportsInstancing()) {
+        target.setSpriteRects(rectTable, rectTableSize);
+    }
+    
+    for (const Command& command : commands) {
+        switch (command.type) {
+            case CommandType::BeginFrame:
+                target.beginFrame();
+                break;
+            case CommandType::EndFrame:
+                target.endFrame();
+                break;
+            case CommandType::Clear:
+                target.clear(command.values[0], command.values[1], command.values[2], command.values[3]);
+                break;
+            case CommandType::ClearDepth:
+                target.clearDepth();
+                break;
+            case CommandType::SetViewport:
+                target.setViewport(command.ints[0], command.ints[1], command.ints[2], command.ints[3]);
+                break;
+            case CommandType::EnableDepthTest:
+                target.enableDepthTest(command.ints[0] != 0);
+                break;
+            case CommandType::EnableBlending:
+                target.enableBlending(command.ints[0] != 0);
+                break;
+            case CommandType::SetBlendMode:
+                target.setBlendMode(command.ints[0], command.ints[1]);
+                break;
+            case CommandType::SetViewProjection:
+                target.setViewProjection(getViewMatrix(command.index), getProjectionMatrix(command.index));
+                break;
+            case CommandType::BindTexture:
+                target.bindTexture(command.ints[0], command.texture);
+                break;
+            case CommandType::DrawQuads:
+                target.drawQuads(vertices.data() + command.index, command.count);
+                break;
+            case CommandType::CreateGeometry:
+            case CommandType::UpdateGeometry:
+                uploadGeometry(command.index);
+                break;
+            case CommandType::DestroyGeometry: {
+                auto it = targetGeometry.find(command.index);
+                if (it != targetGeometry.end()) {
+                    target.destroyStaticGeometry(it->second);
+                    targetGeometry.erase(it);
+                }
+                break;
+            }
+            case CommandType::DrawGeometry:
+                if (targetGeometry.find(command.index) == targetGeometry.end()) {
+                    uploadGeometry(command.index); // Created before the capture started
+                }
+                if (targetGeometry.find(command.index) != targetGeometry.end()) {
+                    target.drawStaticGeometry(targetGeometry[command.index]);
+                }
+                break;
+            case CommandType::SetSpriteRects:
+                rectTable = spriteRects.data() + command.index;
+                rectTableSize = command.count;
+                if (target.supportsInstancing()) {
+                    target.setSpriteRects(rectTable, rectTableSize);
+                }
+                break;
+            case CommandType::DrawSprites: {
+                const SpriteInstance* sprites = spriteInstances.data() + command.index;
+                if (target.supportsInstancing()) {
+                    target.drawSprites(sprites, command.count);
+                    break;
+                }
+                
+                expanded.clear();
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    if (sprites[i].rect >= rectTableSize) {
+                        continue; // Not in the table; the backend would read garbage
+                    }
+                    expanded.resize(expanded.size() + 4);
+                    expandSprite(sprites[i], rectTable[sprites[i].rect], &expanded[expanded.size() - 4]);
+                }
+                target.drawQuads(expanded.data(), expanded.size() / 4);
+                break;
+            }
+        }
+    }
+}
+
+const char* RecordingBackend::commandName(CommandType type) {
+    switch (type) {
+        case CommandType::BeginFrame: return "BeginFrame";
+        case CommandType::EndFrame: return "EndFrame";
+        case CommandType::Clear: return "Clear";
+        case CommandType::ClearDepth: return "ClearDepth";
+        case CommandType::SetViewport: return "SetViewport";
+        case CommandType::EnableDepthTest: return "EnableDepthTest";
+        case CommandType::EnableBlending: return "EnableBlending";
+        case CommandType::SetBlendMode: return "SetBlendMode";
+        case CommandType::SetViewProjection: return "SetViewProjection";
+        case CommandType::BindTexture: return "BindTexture";
+        case CommandType::DrawQuads: return "DrawQuads";
+        case CommandType::CreateGeometry: return "CreateGeometry";
+        case CommandType::UpdateGeometry: return "UpdateGeometry";
+        case CommandType::DestroyGeometry: return "DestroyGeometry";
+        case CommandType::DrawGeometry: return "DrawGeometry";
+        case CommandType::SetSpriteRects: return "SetSpriteRects";
+        case CommandType::DrawSprites: return "DrawSprites";
+    }
+    return "Unknown";
+}
+
+std::string RecordingBackend::describe(size_t maxCommands) const {
+    std::stringstream ss;
+    const Counters& c = lastFrame;
+    ss << "Frame: " << c.commands << " commands, " << c.drawCalls << " draw calls, "
+       << c.quads << " quads (" << std::fixed << std::setprecision(1) << c.quadsPerDrawCall()
+       << " per draw), " << c.textureBinds << " texture binds (" << c.redundantTextureBinds
+       << " redundant), " << c.stateChanges << " state changes, " << c.geometryUploads
+       << " geometry uploads, " << c.instancedQuads << " instanced quads, "
+       << std::setprecision(1) << (c.uploadBytes / 1024.0) << " KB uploaded\n";
+    
+    size_t shown = 0;
+    for (const Command& command : commands) {
+        if (shown++ >= maxCommands) {
+            ss << "  ... " << (commands.size() - maxCommands) << " more\n";
+            break;
+        }
+        
+        ss << "  " << commandName(command.type);
+        switch (command.type) {
+            case CommandType::Clear:
+                ss << " (" << command.values[0] << ", " << command.values[1] << ", "
+                   << command.values[2] << ", " << command.values[3] << ")";
+                break;
+            case CommandType::SetViewport:
+                ss << " " << command.ints[0] << "," << command.ints[1] << " "
+                   << command.ints[2] << "x" << command.ints[3];
+                break;
+            case CommandType::EnableDepthTest:
+            case CommandType::EnableBlending:
+                ss << (command.ints[0] ? " on" : " off");
+                break;
+            case CommandType::SetBlendMode:
+                ss << " " << command.ints[0] << " " << command.ints[1];
+                break;
+            case CommandType::BindTexture:
+                ss << " slot " << command.ints[0] << " -> " << command.texture;
+                break;
+            case CommandType::DrawQuads:
+                ss << " " << command.count << " quads";
+                break;
+            case CommandType::SetSpriteRects:
+                ss << " " << command.count << " rects";
+                break;
+            case CommandType::DrawSprites:
+                ss << " " << command.count << " sprites";
+                break;
+            case CommandType::CreateGeometry:
+            case CommandType::UpdateGeometry:
+            case CommandType::DrawGeometry:
+                ss << " #" << command.index << " " << command.count << " quads";
+                break;
+            case CommandType::DestroyGeometry:
+                ss << " #" << command.index;
+                break;
+            default:
+                break;
+        }
+        ss << "\n";
+    }
+    
+    return ss.str();
+}
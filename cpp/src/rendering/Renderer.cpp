@@ -3,93 +3,73 @@
 #include <iostream>
 #include <cmath>
 
-// Default vertex shader source
-static const char* defaultVertexShader = R"(
-#version 330 core
-layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec2 aTexCoord;
-
-out vec2 TexCoord;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main() {
-    gl_Position = projection * view * model * vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
-}
-)";
-
-// Default fragment shader source
-static const char* defaultFragmentShader = R"(
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoord;
-
-uniform sampler2D texture1;
-uniform vec4 color;
-uniform bool useTexture;
-
-void main() {
-    if (useTexture) {
-        FragColor = texture(texture1, TexCoord) * color;
-    } else {
-        FragColor = color;
-    }
-}
-)";
-
-Renderer::Renderer()
-    : VAO(0)
-    , VBO(0)
-    , EBO(0)
+Renderer::Renderer(RenderBackend* backend)
+    : backend(backend)
     , viewMatrix(1.0f)
     , projectionMatrix(1.0f)
+    , matricesDirty(true)
+    , viewportSize(0, 0)
 {
 }
 
 Renderer::~Renderer() {
-    if (VAO != 0) {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
-    }
 }
 
 bool Renderer::initialize() {
-    // Create default shader
-    if (!createDefaultShader()) {
+    if (!backend) {
+        std::cerr << "Renderer requires a render backend" << std::endl;
         return false;
     }
     
-    // Setup quad geometry
-    setupQuad();
-    
-    std::cout << "Renderer initialized" << std::endl;
+    std::cout << "Renderer initialized (" << backend->getName() << " backend)" << std::endl;
     return true;
 }
 
 void Renderer::beginFrame() {
-    // Nothing special needed here for now
+    backend->beginFrame();
+    matricesDirty = true;
 }
 
 void Renderer::endFrame() {
-    // Nothing special needed here for now
+    backend->endFrame();
 }
 
 void Renderer::clear(float r, float g, float b, float a) {
-    glClearColor(r, g, b, a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    backend->clear(r, g, b, a);
 }
 
 void Renderer::setViewMatrix(const glm::mat4& view) {
     viewMatrix = view;
+    matricesDirty = true;
 }
 
 void Renderer::setProjectionMatrix(const glm::mat4& projection) {
     projectionMatrix = projection;
+    matricesDirty = true;
+}
+
+void Renderer::getVisibleBounds(glm::vec2& outMin, glm::vec2& outMax) const {
+    // Unproject the NDC corners
+    glm::mat4 inverseViewProjection = glm::inverse(projectionMatrix * viewMatrix);
+    for (int corner = 0; corner < 4; ++corner) {
+        glm::vec4 ndc((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, 0.0f, 1.0f);
+        glm::vec4 worldPos = inverseViewProjection * ndc;
+        glm::vec2 point(worldPos.x / worldPos.w, worldPos.y / worldPos.w);
+        outMin = corner == 0 ? point : glm::min(outMin, point);
+        outMax = corner == 0 ? point : glm::max(outMax, point);
+    }
+}
+
+float Renderer::getPixelsPerUnit() const {
+    // NDC spans 2 units across the viewport
+    return std::abs((projectionMatrix * viewMatrix)[0][0]) * viewportSize.x * 0.5f;
+}
+
+void Renderer::flushMatrices() {
+    if (matricesDirty) {
+        backend->setViewProjection(viewMatrix, projectionMatrix);
+        matricesDirty = false;
+    }
 }
 
 void Renderer::drawQuad(
@@ -101,107 +81,108 @@ void Renderer::drawQuad(
     const glm::vec2& texCoordMin,
     const glm::vec2& texCoordMax)
 {
-    // Update texture coordinates in VBO
-    float vertices[] = {
-        // positions        // texture coords
-        0.0f,  size.y,      texCoordMin.x, texCoordMax.y,
-        size.x, size.y,     texCoordMax.x, texCoordMax.y,
-        size.x, 0.0f,       texCoordMax.x, texCoordMin.y,
-        0.0f,  0.0f,        texCoordMin.x, texCoordMin.y
-    };
+    flushMatrices();
     
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    float texIndex = -1.0f;
+    if (texture) {
+        backend->bindTexture(0, texture);
+        texIndex = 0.0f;
+    }
     
-    // Setup model matrix
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position, 0.0f));
+    QuadVertex vertices[4];
+    buildQuadVertices(vertices, position, size, color, texIndex, rotation, texCoordMin, texCoordMax);
     
-    if (rotation != 0.0f) {
-        model = glm::translate(model, glm::vec3(size.x / 2.0f, size.y / 2.0f, 0.0f));
-        model = glm::rotate(model, glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::translate(model, glm::vec3(-size.x / 2.0f, -size.y / 2.0f, 0.0f));
+    // Immediate mode: one quad per draw
+    backend->drawQuads(vertices, 1);
+}
+
+void Renderer::drawStaticGeometry(
+    RenderBackend::GeometryHandle geometry,
+    const Texture* const* textures,
+    int textureCount)
+{
+    if (geometry == RenderBackend::INVALID_GEOMETRY) {
+        return;
     }
     
-    // Use shader and set uniforms
-    shader->use();
-    shader->setMat4("model", model);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
-    shader->setVec4("color", color);
-    
-    if (texture) {
-        texture->bind(0);
-        shader->setInt("texture1", 0);
-        shader->setInt("useTexture", 1);
-    } else {
-        shader->setInt("useTexture", 0);
+    flushMatrices();
+    for (int i = 0; i < textureCount && i < RenderBackend::MAX_TEXTURE_SLOTS; ++i) {
+        backend->bindTexture(i, textures[i]);
+    }
+    backend->drawStaticGeometry(geometry);
+}
+
+void Renderer::drawQuads(
+    const QuadVertex* vertices,
+    size_t quadCount,
+    const Texture* const* textures,
+    int textureCount)
+{
+    if (quadCount == 0) {
+        return;
     }
     
-    // Draw quad
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    flushMatrices();
+    for (int i = 0; i < textureCount && i < RenderBackend::MAX_TEXTURE_SLOTS; ++i) {
+        backend->bindTexture(i, textures[i]);
+    }
+    backend->drawQuads(vertices, quadCount);
 }
 
-void Renderer::drawColoredQuad(
+void Renderer::buildQuadVertices(
+    QuadVertex* out,
     const glm::vec2& position,
     const glm::vec2& size,
     const glm::vec4& color,
-    float rotation)
+    float texIndex,
+    float rotation,
+    const glm::vec2& texCoordMin,
+    const glm::vec2& texCoordMax)
 {
-    drawQuad(position, size, nullptr, color, rotation);
-}
-
-void Renderer::setupQuad() {
-    // Quad vertices (position + texture coordinates)
-    float vertices[] = {
-        // positions   // texture coords
-        0.0f, 1.0f,    0.0f, 1.0f,
-        1.0f, 1.0f,    1.0f, 1.0f,
-        1.0f, 0.0f,    1.0f, 0.0f,
-        0.0f, 0.0f,    0.0f, 0.0f
-    };
-    
-    unsigned int indices[] = {
-        0, 1, 2,
-        2, 3, 0
+    // Corner offsets in quad order: top-left, top-right, bottom-right, bottom-left
+    glm::vec2 corners[4] = {
+        glm::vec2(0.0f, size.y),
+        glm::vec2(size.x, size.y),
+        glm::vec2(size.x, 0.0f),
+        glm::vec2(0.0f, 0.0f)
     };
     
-    // Generate and bind VAO
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-    
-    // Generate and bind VBO
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    
-    // Generate and bind EBO
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    
-    // Position attribute
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    if (rotation != 0.0f) {
+        // Rotate around the quad center
+        glm::vec2 halfSize = size * 0.5f;
+        float cosR = std::cos(glm::radians(rotation));
+        float sinR = std::sin(glm::radians(rotation));
+        for (glm::vec2& corner : corners) {
+            glm::vec2 offset = corner - halfSize;
+            corner = halfSize + glm::vec2(
+                offset.x * cosR - offset.y * sinR,
+                offset.x * sinR + offset.y * cosR
+            );
+        }
+    }
     
-    // Texture coordinate attribute
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    const glm::vec2 texCoords[4] = {
+        glm::vec2(texCoordMin.x, texCoordMax.y),
+        glm::vec2(texCoordMax.x, texCoordMax.y),
+        glm::vec2(texCoordMax.x, texCoordMin.y),
+        glm::vec2(texCoordMin.x, texCoordMin.y)
+    };
     
-    glBindVertexArray(0);
+    for (int i = 0; i < 4; ++i) {
+        out[i].position = glm::vec3(position + corners[i], 0.0f);
+        out[i].color = color;
+        out[i].texCoord = texCoords[i];
+        out[i].texIndex = texIndex;
+    }
 }
 
-bool Renderer::createDefaultShader() {
-    shader = std::make_unique<Shader>();
-    
-    if (!shader->loadFromSource(defaultVertexShader, defaultFragmentShader)) {
-        std::cerr << "Failed to create default shader" << std::endl;
-        return false;
-    }
-    
-    return true;
+void Renderer::drawColoredQuad(
+    const glm::vec2& position,
+    const glm::vec2& size,
+    const glm::vec4& color,
+    float rotation)
+{
+    drawQuad(position, size, nullptr, color, rotation);
 }
 
 void Renderer::drawRect(float x, float y, float width, float height, const glm::vec4& color) {
@@ -2,9 +2,11 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 #include <glm/gtc/type_ptr.hpp>
 
-Shader::Shader() : programID(0) {
+Shader::Shader() : programID(0), binaryRetrievable(false) {
 }
 
 Shader::~Shader() {
@@ -58,32 +60,96 @@ bool Shader::loadFromFiles(const char* vertexPath, const char* fragmentPath) {
     return loadFromSource(vertexCode.c_str(), fragmentCode.c_str());
 }
 
+bool Shader::loadFromBinary(GLenum format, const void* data, size_t length) {
+    if (!glProgramBinary || length == 0) {
+        return false;
+    }
+    
+    programID = glCreateProgram();
+    if (binaryRetrievable && glProgramParameteri) {
+        glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glProgramBinary(programID, format, data, static_cast<GLsizei>(length));
+    
+    GLint success;
+    glGetProgramiv(programID, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(programID);
+        programID = 0;
+        return false;
+    }
+    
+    reflect();
+    return true;
+}
+
+bool Shader::getBinary(GLenum& format, std::vector<uint8_t>& data) const {
+    if (programID == 0 || !glGetProgramBinary) {
+        return false;
+    }
+    
+    GLint length = 0;
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+    
+    data.resize(static_cast<size_t>(length));
+    GLsizei written = 0;
+    glGetProgramBinary(programID, length, &written, &format, data.data());
+    data.resize(static_cast<size_t>(written));
+    return written > 0;
+}
+
 void Shader::use() const {
     glUseProgram(programID);
 }
 
-void Shader::setInt(const char* name, int value) const {
-    glUniform1i(glGetUniformLocation(programID, name), value);
+void Shader::setInt(UniformId id, int value) const {
+    glUniform1i(getUniformLocation(id), value);
 }
 
-void Shader::setFloat(const char* name, float value) const {
-    glUniform1f(glGetUniformLocation(programID, name), value);
+void Shader::setIntArray(UniformId id, const int* values, int count) const {
+    glUniform1iv(getUniformLocation(id), count, values);
 }
 
-void Shader::setVec2(const char* name, const glm::vec2& value) const {
-    glUniform2f(glGetUniformLocation(programID, name), value.x, value.y);
+void Shader::setFloat(UniformId id, float value) const {
+    glUniform1f(getUniformLocation(id), value);
 }
 
-void Shader::setVec3(const char* name, const glm::vec3& value) const {
-    glUniform3f(glGetUniformLocation(programID, name), value.x, value.y, value.z);
+void Shader::setVec2(UniformId id, const glm::vec2& value) const {
+    glUniform2f(getUniformLocation(id), value.x, value.y);
 }
 
-void Shader::setVec4(const char* name, const glm::vec4& value) const {
-    glUniform4f(glGetUniformLocation(programID, name), value.x, value.y, value.z, value.w);
+void Shader::setVec3(UniformId id, const glm::vec3& value) const {
+    glUniform3f(getUniformLocation(id), value.x, value.y, value.z);
 }
 
-void Shader::setMat4(const char* name, const glm::mat4& value) const {
-    glUniformMatrix4fv(glGetUniformLocation(programID, name), 1, GL_FALSE, glm::value_ptr(value));
+void Shader::setVec4(UniformId id, const glm::vec4& value) const {
+    glUniform4f(getUniformLocation(id), value.x, value.y, value.z, value.w);
+}
+
+void Shader::setMat4(UniformId id, const glm::mat4& value) const {
+    glUniformMatrix4fv(getUniformLocation(id), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+GLint Shader::getUniformLocation(UniformId id) const {
+    auto it = uniformLocations.find(id);
+    return it != uniformLocations.end() ? it->second : -1;
+}
+
+GLuint Shader::getUniformBlockIndex(const char* name) const {
+    auto it = uniformBlocks.find(uniformId(name));
+    return it != uniformBlocks.end() ? it->second : GL_INVALID_INDEX;
+}
+
+bool Shader::bindUniformBlock(const char* name, GLuint binding) const {
+    GLuint blockIndex = getUniformBlockIndex(name);
+    if (blockIndex == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(programID, blockIndex, binding);
+    return true;
 }
 
 GLuint Shader::compileShader(GLenum type, const char* source) {
@@ -111,6 +177,9 @@ bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
     programID = glCreateProgram();
     glAttachShader(programID, vertexShader);
     glAttachShader(programID, fragmentShader);
+    if (binaryRetrievable && glProgramParameteri) {
+        glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(programID);
     
     // Check for errors
@@ -125,9 +194,81 @@ bool Shader::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
         return false;
     }
     
+    reflect();
     return true;
 }
 
+void Shader::reflect() {
+    uniformLocations.clear();
+    uniformBlocks.clear();
+    
+    // Hash -> name, only to catch collisions while building the tables
+    std::unordered_map<UniformId, std::string> names;
+    auto addUniform = [&](const std::string& name, GLint location) {
+        UniformId id = uniformId(name.c_str());
+        auto result = names.emplace(id, name);
+        if (!result.second && result.first->second != name) {
+            std::cerr << "Shader uniforms '" << result.first->second << "' and '" << name
+                      << "' have the same hash; '" << name << "' is unreachable" << std::endl;
+            return;
+        }
+        uniformLocations[id] = location;
+    };
+    
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::vector<GLchar> nameBuffer(static_cast<size_t>(std::max(maxNameLength, 1)));
+    
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                           &length, &size, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+        
+        // Members of uniform blocks have no location; the block is reflected below
+        GLint location = glGetUniformLocation(programID, name.c_str());
+        if (location == -1) {
+            continue;
+        }
+        
+        // Arrays report "name[0]": register the bare name and every element.
+        // Element locations aren't guaranteed to be contiguous, so ask for
+        // each one here rather than computing them later.
+        size_t bracket = name.find('[');
+        if (bracket == std::string::npos) {
+            addUniform(name, location);
+            continue;
+        }
+        std::string baseName = name.substr(0, bracket);
+        addUniform(baseName, location);
+        for (GLint element = 0; element < size; ++element) {
+            std::string elementName = baseName + "[" + std::to_string(element) + "]";
+            GLint elementLocation = element == 0 ? location : glGetUniformLocation(programID, elementName.c_str());
+            if (elementLocation != -1) {
+                addUniform(elementName, elementLocation);
+            }
+        }
+    }
+    
+    GLint blockCount = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    if (blockCount > 0 && glGetActiveUniformBlockName) {
+        GLint maxBlockNameLength = 0;
+        glGetProgramiv(programID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxBlockNameLength);
+        nameBuffer.resize(static_cast<size_t>(std::max(maxBlockNameLength, 1)));
+        for (GLint i = 0; i < blockCount; ++i) {
+            GLsizei length = 0;
+            glGetActiveUniformBlockName(programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                                        &length, nameBuffer.data());
+            uniformBlocks[uniformId(std::string(nameBuffer.data(), static_cast<size_t>(length)).c_str())] = static_cast<GLuint>(i);
+        }
+    }
+}
+
 void Shader::checkCompileErrors(GLuint shader, const char* type) {
     GLint success;
     GLchar infoLog[1024];
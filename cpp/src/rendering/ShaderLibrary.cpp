@@ -1,4 +1,5 @@
 #include "rendering/ShaderLibrary.h"
+#include <chrono>
 #include <iostream>
 
 // Built-in shader sources
@@ -12,8 +13,10 @@ layout (location = 1) in vec2 aTexCoord;
 out vec2 TexCoord;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform Matrices {
+    mat4 view;
+    mat4 projection;
+};
 
 void main() {
     gl_Position = projection * view * model * vec4(aPos, 0.0, 1.0);
@@ -50,8 +53,10 @@ out vec2 TexCoord;
 out vec2 FragPos;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform Matrices {
+    mat4 view;
+    mat4 projection;
+};
 
 void main() {
     vec4 worldPos = model * vec4(aPos, 0.0, 1.0);
@@ -138,11 +143,22 @@ void main() {
 }
 )";
 
-ShaderLibrary::ShaderLibrary() {
+ShaderLibrary::ShaderLibrary()
+    : uniformAlignment(256)
+    , currentView(1.0f)
+    , currentProjection(1.0f)
+    , matricesValid(false)
+{
 }
 
 ShaderLibrary::~ShaderLibrary() {
     clear();
+    shutdownFrameUniforms();
+}
+
+void ShaderLibrary::add(const std::string& name, std::unique_ptr<Shader> shader) {
+    shader->bindUniformBlock("Matrices", MATRICES_BINDING);
+    shaders[name] = std::move(shader);
 }
 
 bool ShaderLibrary::loadFromFiles(const std::string& name, const char* vertexPath, const char* fragmentPath) {
@@ -153,20 +169,44 @@ bool ShaderLibrary::loadFromFiles(const std::string& name, const char* vertexPat
         return false;
     }
     
-    shaders[name] = std::move(shader);
+    add(name, std::move(shader));
     std::cout << "Shader '" << name << "' loaded from files" << std::endl;
     return true;
 }
 
 bool ShaderLibrary::loadFromSource(const std::string& name, const char* vertexSource, const char* fragmentSource) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMilliseconds = [&start]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
     auto shader = std::make_unique<Shader>();
     
+    // Warm start: a binary this driver linked from the same sources
+    const bool cached = binaryCache && binaryCache->isEnabled();
+    const uint64_t key = cached ? binaryCache->makeKey(vertexSource, fragmentSource) : 0;
+    if (cached) {
+        if (binaryCache->load(key, *shader)) {
+            add(name, std::move(shader));
+            loadStats.fromCache++;
+            loadStats.cacheMilliseconds += elapsedMilliseconds();
+            std::cout << "Shader '" << name << "' loaded from binary cache" << std::endl;
+            return true;
+        }
+        shader->setBinaryRetrievable(true);
+    }
+    
     if (!shader->loadFromSource(vertexSource, fragmentSource)) {
         std::cerr << "Failed to load shader '" << name << "' from source" << std::endl;
         return false;
     }
     
-    shaders[name] = std::move(shader);
+    if (cached && !binaryCache->store(key, *shader)) {
+        std::cerr << "Failed to cache the binary of shader '" << name << "'" << std::endl;
+    }
+    
+    add(name, std::move(shader));
+    loadStats.compiled++;
+    loadStats.compileMilliseconds += elapsedMilliseconds();
     std::cout << "Shader '" << name << "' loaded from source" << std::endl;
     return true;
 }
@@ -226,3 +266,68 @@ bool ShaderLibrary::loadLightingShader() {
 bool ShaderLibrary::loadPostProcessingShaders() {
     return loadFromSource("postprocess", postProcessVertexShader, postProcessFragmentShader);
 }
+
+bool ShaderLibrary::enableBinaryCache(const std::string& directory) {
+    binaryCache = std::make_unique<ProgramBinaryCache>(directory);
+    if (!binaryCache->initialize()) {
+        binaryCache.reset();
+        return false;
+    }
+    return true;
+}
+
+bool ShaderLibrary::initializeFrameUniforms(bool allowPersistent) {
+    if (frameUniforms) {
+        return true;
+    }
+    
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformAlignment = alignment > 0 ? static_cast<size_t>(alignment) : 256;
+    
+    frameUniforms = std::make_unique<StreamBuffer>(GL_UNIFORM_BUFFER, FRAME_UNIFORM_REGION);
+    if (!frameUniforms->initialize(allowPersistent)) {
+        std::cerr << "Failed to create the per-frame uniform buffer" << std::endl;
+        frameUniforms.reset();
+        return false;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    matricesValid = false;
+    return true;
+}
+
+void ShaderLibrary::shutdownFrameUniforms() {
+    frameUniforms.reset();
+    matricesValid = false;
+}
+
+void ShaderLibrary::beginFrame() {
+    // The binding may have been changed behind our back; upload once per frame
+    matricesValid = false;
+}
+
+void ShaderLibrary::endFrame() {
+    if (frameUniforms) {
+        frameUniforms->endFrame();
+    }
+}
+
+void ShaderLibrary::setViewProjection(const glm::mat4& view, const glm::mat4& projection) {
+    if (!frameUniforms) {
+        return;
+    }
+    
+    // Renderers set the camera before every batch; most calls change nothing
+    if (matricesValid && view == currentView && projection == currentProjection) {
+        return;
+    }
+    
+    glm::mat4 matrices[2] = { view, projection };
+    size_t offset = frameUniforms->write(matrices, sizeof(matrices), uniformAlignment);
+    glBindBufferRange(GL_UNIFORM_BUFFER, MATRICES_BINDING, frameUniforms->getBuffer(),
+                      static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(sizeof(matrices)));
+    
+    currentView = view;
+    currentProjection = projection;
+    matricesValid = true;
+}
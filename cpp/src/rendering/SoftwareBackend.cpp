@@ -0,0 +1,717 @@
+#include "rendering/SoftwareBackend.h"
+#include "rendering/Texture.h"
+#include "engine/JobSystem.h"
+#include "utils/ImageWriter.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SOFTWARE_BACKEND_SSE2
+#endif
+
+// Pixels are packed as 0xAABBGGRR so that, on little-endian targets, the
+// framebuffer bytes are R, G, B, A in memory (what PNG expects)
+namespace {
+    
+    inline uint32_t div255(uint32_t value) {
+        value += 128;
+        return (value + (value >> 8)) >> 8;
+    }
+    
+    // dst = src * srcAlpha + dst * (1 - srcAlpha), on every channel (alpha included),
+    // matching glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA). With coverageAlpha
+    // the alpha channel uses src * 1 instead, like the blend render targets use.
+    inline uint32_t blendPixel(uint32_t src, uint32_t dst, bool coverageAlpha) {
+        uint32_t alpha = src >> 24;
+        if (alpha == 255) {
+            return src;
+        }
+        if (alpha == 0) {
+            return dst;
+        }
+        
+        uint32_t inverse = 255 - alpha;
+        uint32_t out = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t s = (src >> shift) & 0xFF;
+            uint32_t d = (dst >> shift) & 0xFF;
+            uint32_t weight = coverageAlpha && shift == 24 ? 255 : alpha;
+            out |= div255(s * weight + d * inverse) << shift;
+        }
+        return out;
+    }
+    
+    // Per-channel multiply of a texel by the vertex tint
+    inline uint32_t modulate(uint32_t texel, uint32_t tint) {
+        if (tint == 0xFFFFFFFFu) {
+            return texel;
+        }
+        
+        uint32_t out = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            out |= div255(((texel >> shift) & 0xFF) * ((tint >> shift) & 0xFF)) << shift;
+        }
+        return out;
+    }
+    
+    void blendSpan(uint32_t* dst, const uint32_t* src, int count, bool coverageAlpha) {
+        int i = 0;
+
+#ifdef SOFTWARE_BACKEND_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i allOnes = _mm_set1_epi32(-1);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i round = _mm_set1_epi16(128);
+        // OR'd into the source weights: alpha times 255 instead of its own alpha
+        const __m128i alphaWeight = coverageAlpha ? alphaMask : zero;
+        
+        for (; i + 4 <= count; i += 4) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i alphaBits = _mm_and_si128(s, alphaMask);
+            
+            // Whole group opaque: plain copy. Whole group transparent: nothing to do.
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphaBits, alphaMask)) == 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+                continue;
+            }
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphaBits, zero)) == 0xFFFF) {
+                continue;
+            }
+            
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            
+            // Broadcast each pixel's alpha into all four of its bytes
+            __m128i a = _mm_srli_epi32(s, 24);
+            a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+            a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+            __m128i inverse = _mm_xor_si128(a, allOnes); // 255 - a per byte
+            a = _mm_or_si128(a, alphaWeight);
+            
+            __m128i sLo = _mm_unpacklo_epi8(s, zero);
+            __m128i sHi = _mm_unpackhi_epi8(s, zero);
+            __m128i dLo = _mm_unpacklo_epi8(d, zero);
+            __m128i dHi = _mm_unpackhi_epi8(d, zero);
+            __m128i aLo = _mm_unpacklo_epi8(a, zero);
+            __m128i aHi = _mm_unpackhi_epi8(a, zero);
+            __m128i iLo = _mm_unpacklo_epi8(inverse, zero);
+            __m128i iHi = _mm_unpackhi_epi8(inverse, zero);
+            
+            // s * a + d * (255 - a) <= 255 * 255, so 16-bit lanes can't overflow
+            __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(sLo, aLo), _mm_mullo_epi16(dLo, iLo)), round);
+            __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(sHi, aHi), _mm_mullo_epi16(dHi, iHi)), round);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+#endif
+        
+        for (; i < count; ++i) {
+            dst[i] = blendPixel(src[i], dst[i], coverageAlpha);
+        }
+    }
+    
+    // Narrow [lo, hi) to the x values where value(x) = a + b * x lies in [0, 1)
+    inline void clipRange(float a, float b, float& lo, float& hi) {
+        if (std::fabs(b) < 1e-12f) {
+            if (a < 0.0f || a >= 1.0f) {
+                hi = lo; // Empty
+            }
+            return;
+        }
+        
+        float x0 = -a / b;
+        float x1 = (1.0f - a) / b;
+        if (b < 0.0f) {
+            std::swap(x0, x1);
+        }
+        lo = std::max(lo, x0);
+        hi = std::min(hi, x1);
+    }
+    
+    inline int wrap(int value, int size) {
+        value %= size;
+        return value < 0 ? value + size : value;
+    }
+    
+    // Texel coordinate start..start + step * (count - 1) in 16.16 fixed
+    // point; false unless the whole span stays inside [0, size)
+    constexpr int FIXED_MAX_SIZE = 1 << 14;
+    inline bool fixedSpan(float start, float step, int count, int size, int32_t& fixedStart, int32_t& fixedStep) {
+        float end = start + step * static_cast<float>(count - 1);
+        if (size > FIXED_MAX_SIZE || !(start >= 0.0f && start < size && end >= 0.0f && end < size)) {
+            return false;
+        }
+        
+        fixedStart = static_cast<int32_t>(start * 65536.0f);
+        fixedStep = static_cast<int32_t>(step * 65536.0f);
+        int64_t last = static_cast<int64_t>(fixedStart) + static_cast<int64_t>(fixedStep) * (count - 1);
+        return last >= 0 && last < (static_cast<int64_t>(size) << 16);
+    }
+    
+} // namespace
+
+SoftwareBackend::SoftwareBackend(int width, int height, JobSystem* jobSystem)
+    : width(0)
+    , height(0)
+    , jobSystem(jobSystem)
+    , viewportX(0)
+    , viewportY(0)
+    , viewportWidth(width)
+    , viewportHeight(height)
+    , viewProjection(1.0f)
+    , blendingEnabled(true)
+    , multiplyBlending(false)
+    , coverageAlpha(false)
+    , nextGeometryHandle(1)
+    , tilesX(0)
+    , tilesY(0)
+    , clearPending(false)
+    , clearColor(0)
+    , lastFrameQuadCount(0)
+    , missingPixelsWarned(false)
+    , nextRenderTarget(1)
+    , currentRenderTarget(INVALID_TARGET)
+{
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    std::memset(screenViewport, 0, sizeof(screenViewport));
+    resize(width, height);
+}
+
+SoftwareBackend::~SoftwareBackend() {
+    shutdown();
+}
+
+bool SoftwareBackend::initialize() {
+    if (width <= 0 || height <= 0) {
+        LOG_ERROR("Software backend needs a non-empty framebuffer");
+        return false;
+    }
+
+#ifdef SOFTWARE_BACKEND_SSE2
+    const char* blendPath = ", SSE2 blending";
+#else
+    const char* blendPath = ", scalar blending";
+#endif
+    
+    LOG_INFO("Software backend: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+             std::to_string(tilesX * tilesY) + " tiles" + blendPath +
+             (jobSystem ? ", " + std::to_string(jobSystem->getWorkerCount()) + " workers" : std::string(", single-threaded")));
+    return true;
+}
+
+void SoftwareBackend::shutdown() {
+    setRenderTarget(INVALID_TARGET);
+    renderTargets.clear();
+    staticGeometry.clear();
+    quads.clear();
+    for (auto& bin : tileBins) {
+        bin.clear();
+    }
+}
+
+void SoftwareBackend::resize(int newWidth, int newHeight) {
+    width = std::max(newWidth, 0);
+    height = std::max(newHeight, 0);
+    colorBuffer.assign(static_cast<size_t>(width) * height, 0);
+    
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    tileBins.assign(static_cast<size_t>(tilesX) * tilesY, std::vector<uint32_t>());
+    
+    viewportX = 0;
+    viewportY = 0;
+    viewportWidth = width;
+    viewportHeight = height;
+    quads.clear();
+}
+
+void SoftwareBackend::beginFrame() {
+    quads.clear();
+    for (auto& bin : tileBins) {
+        bin.clear();
+    }
+    std::memset(boundTextures, 0, sizeof(boundTextures));
+    lastFrameQuadCount = 0;
+}
+
+void SoftwareBackend::endFrame() {
+    flush();
+}
+
+void SoftwareBackend::clear(float r, float g, float b, float a) {
+    // Quads submitted before the clear must land first
+    if (!quads.empty()) {
+        flush();
+    }
+    clearPending = true;
+    clearColor = packColor(glm::vec4(r, g, b, a));
+}
+
+void SoftwareBackend::clearDepth() {
+    // No depth buffer: 2D quads draw in submission order
+}
+
+void SoftwareBackend::setViewport(int x, int y, int w, int h) {
+    viewportX = x;
+    viewportY = y;
+    viewportWidth = w;
+    viewportHeight = h;
+    if (currentRenderTarget != INVALID_TARGET) {
+        int* viewport = renderTargets[currentRenderTarget].viewport;
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = w;
+        viewport[3] = h;
+    }
+}
+
+void SoftwareBackend::enableDepthTest(bool enable) {
+    (void)enable; // Unused - no depth buffer
+}
+
+void SoftwareBackend::enableBlending(bool enable) {
+    if (enable != blendingEnabled && !quads.empty()) {
+        flush();
+    }
+    blendingEnabled = enable;
+}
+
+void SoftwareBackend::setBlendMode(int srcFactor, int dstFactor) {
+    // Multiply is the only mode besides SRC_ALPHA / ONE_MINUS_SRC_ALPHA
+    bool multiply = srcFactor == GL_DST_COLOR && dstFactor == GL_ZERO;
+    if (multiply != multiplyBlending && !quads.empty()) {
+        flush();
+    }
+    multiplyBlending = multiply;
+}
+
+void SoftwareBackend::setViewProjection(const glm::mat4& view, const glm::mat4& projection) {
+    viewProjection = projection * view;
+}
+
+void SoftwareBackend::bindTexture(int slot, const Texture* texture) {
+    if (slot >= 0 && slot < MAX_TEXTURE_SLOTS) {
+        boundTextures[slot] = texture;
+        if (texture) {
+            texture->markUsed();
+        }
+    }
+}
+
+void SoftwareBackend::drawQuads(const QuadVertex* vertices, size_t quadCount) {
+    auto toScreen = [this](const glm::vec3& position) {
+        glm::vec4 clip = viewProjection * glm::vec4(position, 1.0f);
+        float invW = clip.w != 0.0f ? 1.0f / clip.w : 1.0f;
+        float x = viewportX + (clip.x * invW * 0.5f + 0.5f) * viewportWidth;
+        float y = viewportY + (clip.y * invW * 0.5f + 0.5f) * viewportHeight;
+        // Screen rows are stored top first, render target rows bottom first
+        // (the orientation of the texture they are sampled through)
+        return glm::vec2(x, currentRenderTarget != INVALID_TARGET ? y : static_cast<float>(height) - y);
+    };
+    
+    for (size_t q = 0; q < quadCount; ++q) {
+        const QuadVertex* v = vertices + q * 4;
+        
+        // Quads are parallelograms: origin at the bottom-left vertex (3),
+        // s runs towards vertex 2 and t towards vertex 0
+        glm::vec2 origin = toScreen(v[3].position);
+        glm::vec2 sAxis = toScreen(v[2].position) - origin;
+        glm::vec2 tAxis = toScreen(v[0].position) - origin;
+        
+        float det = sAxis.x * tAxis.y - sAxis.y * tAxis.x;
+        if (std::fabs(det) < 1e-6f) {
+            continue; // Degenerate
+        }
+        
+        glm::vec2 corners[4] = { origin, origin + sAxis, origin + tAxis, origin + sAxis + tAxis };
+        float minXf = corners[0].x, maxXf = corners[0].x;
+        float minYf = corners[0].y, maxYf = corners[0].y;
+        for (int i = 1; i < 4; ++i) {
+            minXf = std::min(minXf, corners[i].x);
+            maxXf = std::max(maxXf, corners[i].x);
+            minYf = std::min(minYf, corners[i].y);
+            maxYf = std::max(maxYf, corners[i].y);
+        }
+        
+        ScreenQuad quad;
+        quad.minX = std::max(0, static_cast<int>(std::floor(minXf)));
+        quad.minY = std::max(0, static_cast<int>(std::floor(minYf)));
+        quad.maxX = std::min(width - 1, static_cast<int>(std::ceil(maxXf)));
+        quad.maxY = std::min(height - 1, static_cast<int>(std::ceil(maxYf)));
+        if (quad.minX > quad.maxX || quad.minY > quad.maxY) {
+            continue; // Off screen
+        }
+        
+        float invDet = 1.0f / det;
+        quad.originX = origin.x;
+        quad.originY = origin.y;
+        quad.dsdx = tAxis.y * invDet;
+        quad.dsdy = -tAxis.x * invDet;
+        quad.dtdx = -sAxis.y * invDet;
+        quad.dtdy = sAxis.x * invDet;
+        
+        quad.uvOriginX = v[3].texCoord.x;
+        quad.uvOriginY = v[3].texCoord.y;
+        quad.uvSX = v[2].texCoord.x - v[3].texCoord.x;
+        quad.uvSY = v[2].texCoord.y - v[3].texCoord.y;
+        quad.uvTX = v[0].texCoord.x - v[3].texCoord.x;
+        quad.uvTY = v[0].texCoord.y - v[3].texCoord.y;
+        
+        // Renderers emit one color per quad; vertex 0 carries it
+        quad.color = packColor(v[0].color);
+        quad.texture = nullptr;
+        quad.level = 0;
+        int slot = static_cast<int>(v[0].texIndex);
+        if (v[0].texIndex >= 0.0f && slot < MAX_TEXTURE_SLOTS && boundTextures[slot]) {
+            if (boundTextures[slot]->getPixels()) {
+                quad.texture = boundTextures[slot];
+                quad.level = selectLevel(quad);
+            } else if (!missingPixelsWarned) {
+                LOG_WARNING("Software backend: texture has no CPU pixels (load with Texture::setCpuOnly); drawing untextured");
+                missingPixelsWarned = true;
+            }
+        }
+        
+        uint32_t index = static_cast<uint32_t>(quads.size());
+        quads.push_back(quad);
+        
+        // Bin into every tile the bounds touch
+        int tileMinX = quad.minX / TILE_SIZE;
+        int tileMaxX = quad.maxX / TILE_SIZE;
+        int tileMinY = quad.minY / TILE_SIZE;
+        int tileMaxY = quad.maxY / TILE_SIZE;
+        for (int ty = tileMinY; ty <= tileMaxY; ++ty) {
+            for (int tx = tileMinX; tx <= tileMaxX; ++tx) {
+                tileBins[static_cast<size_t>(ty) * tilesX + tx].push_back(index);
+            }
+        }
+    }
+}
+
+RenderBackend::GeometryHandle SoftwareBackend::createStaticGeometry(const QuadVertex* vertices, size_t quadCount) {
+    if (quadCount == 0) {
+        return INVALID_GEOMETRY;
+    }
+    
+    GeometryHandle handle = nextGeometryHandle++;
+    staticGeometry[handle].assign(vertices, vertices + quadCount * 4);
+    return handle;
+}
+
+bool SoftwareBackend::updateStaticGeometry(GeometryHandle handle, const QuadVertex* vertices, size_t quadCount) {
+    auto it = staticGeometry.find(handle);
+    if (it == staticGeometry.end()) {
+        return false;
+    }
+    
+    it->second.assign(vertices, vertices + quadCount * 4);
+    return true;
+}
+
+void SoftwareBackend::destroyStaticGeometry(GeometryHandle handle) {
+    staticGeometry.erase(handle);
+}
+
+void SoftwareBackend::drawStaticGeometry(GeometryHandle handle) {
+    auto it = staticGeometry.find(handle);
+    if (it != staticGeometry.end()) {
+        drawQuads(it->second.data(), it->second.size() / 4);
+    }
+}
+
+bool SoftwareBackend::supportsInstancing() const {
+    // Binning works on quads; expanding instances here would gain nothing
+    return false;
+}
+
+void SoftwareBackend::setSpriteRects(const SpriteRect* rects, size_t rectCount) {
+    (void)rects; // Unused - no instancing support
+    (void)rectCount;
+}
+
+void SoftwareBackend::drawSprites(const SpriteInstance* instances, size_t instanceCount) {
+    (void)instances; // Unused - no instancing support
+    (void)instanceCount;
+}
+
+bool SoftwareBackend::supportsRenderTargets() const {
+    // Target color is sampled through a texture's CPU pixels
+    return Texture::isCpuOnly();
+}
+
+RenderBackend::RenderTargetHandle SoftwareBackend::createRenderTarget(int targetWidth, int targetHeight) {
+    if (!supportsRenderTargets() || targetWidth <= 0 || targetHeight <= 0) {
+        return INVALID_TARGET;
+    }
+    
+    std::vector<uint32_t> pixels(static_cast<size_t>(targetWidth) * targetHeight, 0);
+    auto texture = std::make_unique<Texture>();
+    if (!texture->loadFromMemory(reinterpret_cast<unsigned char*>(pixels.data()), targetWidth, targetHeight, 4)) {
+        return INVALID_TARGET;
+    }
+    
+    RenderTargetHandle handle = nextRenderTarget++;
+    RenderTarget& target = renderTargets[handle];
+    target.colorBuffer = std::move(pixels);
+    target.width = targetWidth;
+    target.height = targetHeight;
+    target.viewport[0] = 0;
+    target.viewport[1] = 0;
+    target.viewport[2] = targetWidth;
+    target.viewport[3] = targetHeight;
+    target.texture = std::move(texture);
+    return handle;
+}
+
+void SoftwareBackend::destroyRenderTarget(RenderTargetHandle handle) {
+    if (handle == currentRenderTarget) {
+        setRenderTarget(INVALID_TARGET);
+    }
+    renderTargets.erase(handle);
+}
+
+void SoftwareBackend::setRenderTarget(RenderTargetHandle handle) {
+    if (handle == currentRenderTarget) {
+        return;
+    }
+    auto it = renderTargets.find(handle);
+    if (handle != INVALID_TARGET && it == renderTargets.end()) {
+        return;
+    }
+    
+    // Quads submitted so far belong to the framebuffer being left
+    flush();
+    
+    if (currentRenderTarget == INVALID_TARGET) {
+        screenViewport[0] = viewportX;
+        screenViewport[1] = viewportY;
+        screenViewport[2] = viewportWidth;
+        screenViewport[3] = viewportHeight;
+    } else {
+        RenderTarget& current = renderTargets[currentRenderTarget];
+        current.texture->update(reinterpret_cast<const unsigned char*>(colorBuffer.data()));
+        swapColorBuffer(current);
+    }
+    
+    const int* viewport = screenViewport;
+    if (handle != INVALID_TARGET) {
+        swapColorBuffer(it->second);
+        viewport = it->second.viewport;
+    } else {
+        multiplyBlending = false;
+    }
+    viewportX = viewport[0];
+    viewportY = viewport[1];
+    viewportWidth = viewport[2];
+    viewportHeight = viewport[3];
+    coverageAlpha = handle != INVALID_TARGET;
+    currentRenderTarget = handle;
+}
+
+const Texture* SoftwareBackend::getRenderTargetTexture(RenderTargetHandle handle) const {
+    auto it = renderTargets.find(handle);
+    return it != renderTargets.end() ? it->second.texture.get() : nullptr;
+}
+
+void SoftwareBackend::swapColorBuffer(RenderTarget& target) {
+    colorBuffer.swap(target.colorBuffer);
+    std::swap(width, target.width);
+    std::swap(height, target.height);
+    
+    // The bins are empty (flushed); only their number follows the size
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    tileBins.resize(static_cast<size_t>(tilesX) * tilesY);
+}
+
+void SoftwareBackend::flush() {
+    if (!clearPending && quads.empty()) {
+        return;
+    }
+    
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+    if (jobSystem) {
+        jobSystem->parallelFor(0, tileCount, 4, [this](size_t tile) {
+            rasterizeTile(static_cast<int>(tile));
+        });
+    } else {
+        for (size_t tile = 0; tile < tileCount; ++tile) {
+            rasterizeTile(static_cast<int>(tile));
+        }
+    }
+    
+    lastFrameQuadCount += quads.size();
+    quads.clear();
+    for (auto& bin : tileBins) {
+        bin.clear();
+    }
+    clearPending = false;
+}
+
+void SoftwareBackend::rasterizeTile(int tileIndex) {
+    const int tileMinX = (tileIndex % tilesX) * TILE_SIZE;
+    const int tileMinY = (tileIndex / tilesX) * TILE_SIZE;
+    const int tileMaxX = std::min(tileMinX + TILE_SIZE, width) - 1;
+    const int tileMaxY = std::min(tileMinY + TILE_SIZE, height) - 1;
+    
+    if (clearPending) {
+        for (int y = tileMinY; y <= tileMaxY; ++y) {
+            uint32_t* row = colorBuffer.data() + static_cast<size_t>(y) * width;
+            std::fill(row + tileMinX, row + tileMaxX + 1, clearColor);
+        }
+    }
+    
+    for (uint32_t index : tileBins[tileIndex]) {
+        rasterizeQuad(quads[index], tileMinX, tileMinY, tileMaxX, tileMaxY);
+    }
+}
+
+int SoftwareBackend::selectLevel(const ScreenQuad& quad) {
+    const Texture* texture = quad.texture;
+    if (texture->getLevelCount() < 2) {
+        return 0;
+    }
+    
+    // Level 0 texels covered by one pixel step in x and in y; nearest
+    // level to the larger footprint, like GL_NEAREST_MIPMAP_* does
+    const float texWidth = static_cast<float>(texture->getWidth());
+    const float texHeight = static_cast<float>(texture->getHeight());
+    glm::vec2 stepX((quad.dsdx * quad.uvSX + quad.dtdx * quad.uvTX) * texWidth,
+                    (quad.dsdx * quad.uvSY + quad.dtdx * quad.uvTY) * texHeight);
+    glm::vec2 stepY((quad.dsdy * quad.uvSX + quad.dtdy * quad.uvTX) * texWidth,
+                    (quad.dsdy * quad.uvSY + quad.dtdy * quad.uvTY) * texHeight);
+    float footprint = std::max(glm::dot(stepX, stepX), glm::dot(stepY, stepY));
+    if (footprint <= 1.0f) {
+        return 0;
+    }
+    
+    // log2 of the footprint length, rounded to the nearest level
+    int level = static_cast<int>(std::floor(0.5f * std::log2(footprint) + 0.5f));
+    return std::min(level, texture->getLevelCount() - 1);
+}
+
+void SoftwareBackend::rasterizeQuad(const ScreenQuad& quad, int tileMinX, int tileMinY, int tileMaxX, int tileMaxY) {
+    const int x0 = std::max(quad.minX, tileMinX);
+    const int x1 = std::min(quad.maxX, tileMaxX);
+    const int y0 = std::max(quad.minY, tileMinY);
+    const int y1 = std::min(quad.maxY, tileMaxY);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    
+    const uint8_t* texels = quad.texture ? quad.texture->getPixels(quad.level) : nullptr;
+    const int texWidth = quad.texture ? std::max(1, quad.texture->getWidth() >> quad.level) : 0;
+    const int texHeight = quad.texture ? std::max(1, quad.texture->getHeight() >> quad.level) : 0;
+    
+    uint32_t span[TILE_SIZE];
+    
+    for (int y = y0; y <= y1; ++y) {
+        // s and t are affine in x along this row (sampled at pixel centers)
+        const float py = static_cast<float>(y) + 0.5f - quad.originY;
+        const float sRow = quad.dsdy * py - quad.dsdx * quad.originX;
+        const float tRow = quad.dtdy * py - quad.dtdx * quad.originX;
+        
+        float lo = static_cast<float>(x0) + 0.5f;
+        float hi = static_cast<float>(x1) + 1.5f;
+        clipRange(sRow, quad.dsdx, lo, hi);
+        clipRange(tRow, quad.dtdx, lo, hi);
+        if (lo >= hi) {
+            continue;
+        }
+        
+        // First and last pixel whose center lies in [lo, hi)
+        int spanStart = std::max(x0, static_cast<int>(std::ceil(lo - 0.5f)));
+        int spanEnd = std::min(x1, static_cast<int>(std::ceil(hi - 0.5f)) - 1);
+        if (spanStart > spanEnd) {
+            continue;
+        }
+        const int count = spanEnd - spanStart + 1;
+        
+        float px = static_cast<float>(spanStart) + 0.5f;
+        float s = sRow + quad.dsdx * px;
+        float t = tRow + quad.dtdx * px;
+        int32_t u = 0, v = 0, du = 0, dv = 0;
+        
+        // Texel coordinates are affine along the span: when it stays inside
+        // the texture, step them in fixed point with no floor or wrap
+        if (texels &&
+            fixedSpan((quad.uvOriginX + s * quad.uvSX + t * quad.uvTX) * texWidth,
+                      (quad.dsdx * quad.uvSX + quad.dtdx * quad.uvTX) * texWidth, count, texWidth, u, du) &&
+            fixedSpan((quad.uvOriginY + s * quad.uvSY + t * quad.uvTY) * texHeight,
+                      (quad.dsdx * quad.uvSY + quad.dtdx * quad.uvTY) * texHeight, count, texHeight, v, dv)) {
+            for (int i = 0; i < count; ++i) {
+                uint32_t texel;
+                std::memcpy(&texel, texels + (static_cast<size_t>(v >> 16) * texWidth + (u >> 16)) * 4, sizeof(texel));
+                span[i] = modulate(texel, quad.color);
+                u += du;
+                v += dv;
+            }
+        } else if (texels) {
+            for (int i = 0; i < count; ++i) {
+                float u = quad.uvOriginX + s * quad.uvSX + t * quad.uvTX;
+                float v = quad.uvOriginY + s * quad.uvSY + t * quad.uvTY;
+                int tx = static_cast<int>(std::floor(u * texWidth));
+                int ty = static_cast<int>(std::floor(v * texHeight));
+                if (static_cast<unsigned>(tx) >= static_cast<unsigned>(texWidth)) {
+                    tx = wrap(tx, texWidth);
+                }
+                if (static_cast<unsigned>(ty) >= static_cast<unsigned>(texHeight)) {
+                    ty = wrap(ty, texHeight);
+                }
+                
+                uint32_t texel;
+                std::memcpy(&texel, texels + (static_cast<size_t>(ty) * texWidth + tx) * 4, sizeof(texel));
+                span[i] = modulate(texel, quad.color);
+                
+                s += quad.dsdx;
+                t += quad.dtdx;
+            }
+        } else {
+            std::fill(span, span + count, quad.color);
+        }
+        
+        uint32_t* dst = colorBuffer.data() + static_cast<size_t>(y) * width + spanStart;
+        if (blendingEnabled && multiplyBlending) {
+            for (int i = 0; i < count; ++i) {
+                dst[i] = modulate(dst[i], span[i]);
+            }
+        } else if (blendingEnabled) {
+            blendSpan(dst, span, count, coverageAlpha);
+        } else {
+            std::memcpy(dst, span, count * sizeof(uint32_t));
+        }
+    }
+}
+
+bool SoftwareBackend::saveScreenshot(const std::string& path) const {
+    if (!ImageWriter::writePNG(path, width, height, getPixels())) {
+        LOG_ERROR("Failed to write screenshot: " + path);
+        return false;
+    }
+    
+    LOG_INFO("Screenshot written: " + path);
+    return true;
+}
+
+const char* SoftwareBackend::getName() const {
+    return "Software";
+}
+
+const char* SoftwareBackend::getVersion() const {
+    return "1.0";
+}
+
+RenderBackendType SoftwareBackend::getType() const {
+    return RenderBackendType::Software;
+}
+
+uint32_t SoftwareBackend::packColor(const glm::vec4& color) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+}
@@ -0,0 +1,197 @@
+#include "rendering/StreamBuffer.h"
+#include "utils/Logger.h"
+#include <cstring>
+#include <string>
+
+namespace {
+    
+    // Wait at most this long per glClientWaitSync call (nanoseconds)
+    constexpr GLuint64 FENCE_WAIT_STEP = 1000000;
+    
+    size_t alignUp(size_t value, size_t alignment) {
+        return alignment > 1 ? ((value + alignment - 1) / alignment) * alignment : value;
+    }
+    
+} // namespace
+
+StreamBuffer::StreamBuffer(GLenum target, size_t regionSize, int regionCount)
+    : target(target)
+    , regionSize(regionSize)
+    , regionCount(regionCount > 0 ? regionCount : 1)
+    , buffer(0)
+    , mode(Mode::Orphaning)
+    , mapped(nullptr)
+    , region(0)
+    , cursor(0)
+    , regionAcquired(false)
+{
+}
+
+StreamBuffer::~StreamBuffer() {
+    shutdown();
+}
+
+bool StreamBuffer::initialize(bool allowPersistent) {
+    if (buffer != 0) {
+        return true;
+    }
+    
+    if (!glMapBufferRange || !glUnmapBuffer) {
+        LOG_ERROR("Stream buffer needs glMapBufferRange");
+        return false;
+    }
+    
+    const bool hasFences = glFenceSync && glClientWaitSync && glDeleteSync;
+    const size_t totalSize = regionSize * regionCount;
+    
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    
+    mode = hasFences ? Mode::Unsynchronized : Mode::Orphaning;
+    if (hasFences && allowPersistent && glBufferStorage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, static_cast<GLsizeiptr>(totalSize), nullptr, flags);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(target, 0, static_cast<GLsizeiptr>(totalSize), flags));
+        if (mapped) {
+            mode = Mode::Persistent;
+        } else {
+            // Immutable storage can't be respecified: start over with a new buffer
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(target, buffer);
+        }
+    }
+    if (mode != Mode::Persistent) {
+        glBufferData(target, static_cast<GLsizeiptr>(totalSize), nullptr, GL_STREAM_DRAW);
+    }
+    
+    fences.assign(regionCount, nullptr);
+    region = 0;
+    cursor = 0;
+    regionAcquired = false;
+    
+    LOG_INFO(std::string("Stream buffer: ") + std::to_string(regionCount) + " x " +
+             std::to_string(regionSize / 1024) + " KB, " + modeName(mode));
+    return true;
+}
+
+void StreamBuffer::shutdown() {
+    if (buffer == 0) {
+        return;
+    }
+    
+    for (GLsync& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    
+    if (mapped) {
+        glBindBuffer(target, buffer);
+        glUnmapBuffer(target);
+        mapped = nullptr;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void StreamBuffer::endFrame() {
+    // An untouched region can simply be used again next frame
+    if (buffer != 0 && cursor > static_cast<size_t>(region) * regionSize) {
+        advanceRegion();
+    }
+}
+
+size_t StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+    if (size > regionSize) {
+        LOG_ERROR("Stream buffer write of " + std::to_string(size) + " bytes exceeds the region size");
+        return 0;
+    }
+    
+    size_t offset = alignUp(cursor, alignment);
+    if (offset + size > static_cast<size_t>(region + 1) * regionSize) {
+        advanceRegion();
+        offset = alignUp(cursor, alignment);
+    }
+    const bool waited = !regionAcquired && acquireRegion();
+    
+    glBindBuffer(target, buffer);
+    if (mapped) {
+        std::memcpy(mapped + offset, data, size);
+    } else {
+        // Nothing in flight uses this range: fenced region, or fresh storage
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        void* destination = glMapBufferRange(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), access);
+        if (!destination) {
+            glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        } else {
+            std::memcpy(destination, data, size);
+            glUnmapBuffer(target);
+        }
+    }
+    
+    cursor = offset + size;
+    stats.bytesStreamed += size;
+    stats.writes++;
+    if (!waited) {
+        stats.stallsAvoided++;
+    }
+    return offset;
+}
+
+void StreamBuffer::advanceRegion() {
+    // Everything drawn from this region so far is behind the fence
+    if (mode != Mode::Orphaning) {
+        if (fences[region]) {
+            glDeleteSync(fences[region]);
+        }
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    
+    region = (region + 1) % regionCount;
+    cursor = static_cast<size_t>(region) * regionSize;
+    regionAcquired = false;
+}
+
+bool StreamBuffer::acquireRegion() {
+    regionAcquired = true;
+    
+    if (mode == Mode::Orphaning) {
+        // Wrapping around: hand the old storage to the driver, write into new
+        if (region == 0 && stats.writes > 0) {
+            glBindBuffer(target, buffer);
+            glBufferData(target, static_cast<GLsizeiptr>(regionSize * regionCount), nullptr, GL_STREAM_DRAW);
+            stats.orphans++;
+        }
+        return false;
+    }
+    
+    GLsync fence = fences[region];
+    if (!fence) {
+        return false;
+    }
+    
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    const bool blocked = result == GL_TIMEOUT_EXPIRED;
+    if (blocked) {
+        // The GPU is a full ring behind: flush so the fence can signal, then wait
+        stats.stalls++;
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_STEP);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    
+    glDeleteSync(fence);
+    fences[region] = nullptr;
+    return blocked;
+}
+
+const char* StreamBuffer::modeName(Mode mode) {
+    switch (mode) {
+        case Mode::Persistent: return "persistent mapping";
+        case Mode::Unsynchronized: return "unsynchronized mapping";
+        case Mode::Orphaning: return "orphaning";
+    }
+    return "unknown";
+}
@@ -1,14 +1,21 @@
 #include "rendering/Texture.h"
+#include "engine/Profiler.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+bool Texture::cpuOnly = false;
+uint64_t Texture::currentFrame = 0;
+
 Texture::Texture()
     : textureID(0)
     , width(0)
     , height(0)
     , channels(0)
     , mipmapsEnabled(false)
+    , lastUsedFrame(0)
 {
 }
 
@@ -18,30 +25,62 @@ Texture::~Texture() {
     }
 }
 
+unsigned char* Texture::decodeImage(const char* path, int& width, int& height, int& channels) {
+    PROFILE_SCOPE("Texture::decodeImage");
+    // The per-thread flag leaves decodes on other threads alone
+    stbi_set_flip_vertically_on_load_thread(1);
+    return stbi_load(path, &width, &height, &channels, 0);
+}
+
+const char* Texture::decodeError() {
+    return stbi_failure_reason();
+}
+
+void Texture::freeImage(unsigned char* data) {
+    stbi_image_free(data);
+}
+
+void Texture::downsample(const unsigned char* source, int width, int height, unsigned char* destination) {
+    const int nextWidth = std::max(width / 2, 1);
+    const int nextHeight = std::max(height / 2, 1);
+    for (int y = 0; y < nextHeight; ++y) {
+        for (int x = 0; x < nextWidth; ++x) {
+            uint32_t color[3] = { 0, 0, 0 };
+            uint32_t alpha = 0;
+            for (int sample = 0; sample < 4; ++sample) {
+                int sx = std::min(x * 2 + (sample & 1), width - 1);
+                int sy = std::min(y * 2 + (sample >> 1), height - 1);
+                const unsigned char* texel = source + (static_cast<size_t>(sy) * width + sx) * 4;
+                for (int c = 0; c < 3; ++c) {
+                    color[c] += texel[c] * texel[3];
+                }
+                alpha += texel[3];
+            }
+            
+            unsigned char* out = destination + (static_cast<size_t>(y) * nextWidth + x) * 4;
+            for (int c = 0; c < 3; ++c) {
+                out[c] = static_cast<unsigned char>(alpha > 0 ? (color[c] + alpha / 2) / alpha : 0);
+            }
+            out[3] = static_cast<unsigned char>((alpha + 2) / 4);
+        }
+    }
+}
+
 bool Texture::loadFromFile(const char* path, bool generateMipmap) {
+    PROFILE_SCOPE("Texture::loadFromFile");
     // Load image data
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(path, &width, &height, &channels, 0);
+    unsigned char* data = decodeImage(path, width, height, channels);
     
     if (!data) {
         std::cerr << "Failed to load texture: " << path << std::endl;
-        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
+        std::cerr << "STB Error: " << decodeError() << std::endl;
         return false;
     }
     
-    bool success = loadFromMemory(data, width, height, channels);
-    
-    if (success && generateMipmap) {
-        glGenerateMipmap(GL_TEXTURE_2D);
-        mipmapsEnabled = true;
-        
-        // Use trilinear filtering for smooth scaling
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    }
+    bool success = loadFromImage(data, width, height, channels, generateMipmap);
     
     // Free image data
-    stbi_image_free(data);
+    freeImage(data);
     
     if (success) {
         std::cout << "Loaded texture: " << path 
@@ -57,6 +96,21 @@ bool Texture::loadFromMemory(unsigned char* data, int w, int h, int ch) {
     this->height = h;
     this->channels = ch;
     
+    if (cpuOnly) {
+        // Expand to RGBA8 so samplers only deal with one layout
+        pixels.resize(static_cast<size_t>(w) * h * 4);
+        for (int i = 0; i < w * h; ++i) {
+            const unsigned char* src = data + static_cast<size_t>(i) * ch;
+            unsigned char* dst = pixels.data() + static_cast<size_t>(i) * 4;
+            dst[0] = src[0];
+            dst[1] = ch >= 3 ? src[1] : src[0];
+            dst[2] = ch >= 3 ? src[2] : src[0];
+            dst[3] = ch == 4 ? src[3] : (ch == 2 ? src[1] : 255);
+        }
+        levelOffsets.assign(1, 0);
+        return true;
+    }
+    
     // Generate texture
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
@@ -85,16 +139,162 @@ bool Texture::loadFromMemory(unsigned char* data, int w, int h, int ch) {
     return true;
 }
 
+bool Texture::loadFromImage(unsigned char* data, int w, int h, int ch, bool generateMipmap) {
+    if (!loadFromMemory(data, w, h, ch)) {
+        return false;
+    }
+    
+    // Trilinear filtering for smooth scaling
+    if (generateMipmap) {
+        enableMipmapping(true);
+    }
+    return true;
+}
+
+bool Texture::createEmpty(int w, int h) {
+    if (cpuOnly) {
+        return false;
+    }
+    release();
+    
+    this->width = w;
+    this->height = h;
+    this->channels = 4;
+    
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+bool Texture::update(const unsigned char* data) {
+    if (channels != 4 || mipmapsEnabled) {
+        return false;
+    }
+    
+    if (!pixels.empty()) {
+        std::memcpy(pixels.data(), data, static_cast<size_t>(width) * height * 4);
+        return true;
+    }
+    if (textureID == 0) {
+        return false;
+    }
+    
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+bool Texture::loadFromMipChain(const std::vector<const unsigned char*>& levels, int w, int h) {
+    if (levels.empty()) {
+        return false;
+    }
+    if (cpuOnly) {
+        this->width = w;
+        this->height = h;
+        this->channels = 4;
+        pixels.clear();
+        levelOffsets.clear();
+        int levelWidth = w;
+        int levelHeight = h;
+        for (const unsigned char* level : levels) {
+            levelOffsets.push_back(pixels.size());
+            pixels.insert(pixels.end(), level, level + static_cast<size_t>(levelWidth) * levelHeight * 4);
+            levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+            levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+        }
+        return true;
+    }
+    
+    this->width = w;
+    this->height = h;
+    this->channels = 4;
+    
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    
+    int levelWidth = w;
+    int levelHeight = h;
+    for (size_t level = 0; level < levels.size(); ++level) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, levelWidth, levelHeight, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, levels[level]);
+        levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+    }
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size() - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    mipmapsEnabled = levels.size() > 1;
+    return true;
+}
+
+void Texture::release() {
+    if (textureID != 0) {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+    std::vector<unsigned char>().swap(pixels);
+    levelOffsets.clear();
+    mipmapsEnabled = false;
+}
+
+size_t Texture::getMemoryBytes() const {
+    if (!pixels.empty()) {
+        return pixels.size();
+    }
+    if (textureID == 0) {
+        return 0;
+    }
+    
+    // Drivers pad RGB texels to 4 bytes
+    const size_t texelBytes = channels == 1 ? 1 : 4;
+    size_t bytes = static_cast<size_t>(width) * height * texelBytes;
+    if (mipmapsEnabled) {
+        int levelWidth = width;
+        int levelHeight = height;
+        while (levelWidth > 1 || levelHeight > 1) {
+            levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+            levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+            bytes += static_cast<size_t>(levelWidth) * levelHeight * texelBytes;
+        }
+    }
+    return bytes;
+}
+
 void Texture::bind(unsigned int unit) const {
+    markUsed();
+    if (textureID == 0) {
+        return; // Not uploaded (CPU-only, released or failed load)
+    }
+    
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(GL_TEXTURE_2D, textureID);
 }
 
 void Texture::unbind() const {
+    if (textureID == 0) {
+        return;
+    }
+    
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Texture::setWrapMode(GLenum wrapS, GLenum wrapT) {
+    if (textureID == 0) {
+        return;
+    }
+    
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
@@ -102,6 +302,10 @@ void Texture::setWrapMode(GLenum wrapS, GLenum wrapT) {
 }
 
 void Texture::setFilterMode(GLenum minFilter, GLenum magFilter) {
+    if (textureID == 0) {
+        return;
+    }
+    
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
@@ -109,6 +313,25 @@ void Texture::setFilterMode(GLenum minFilter, GLenum magFilter) {
 }
 
 void Texture::enableMipmapping(bool enable) {
+    if (textureID == 0) {
+        // CPU-only: append the levels the software rasterizer picks from
+        if (enable && getLevelCount() == 1) {
+            int levelWidth = width;
+            int levelHeight = height;
+            while (levelWidth > 1 || levelHeight > 1) {
+                int nextWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+                int nextHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+                size_t offset = pixels.size();
+                pixels.resize(offset + static_cast<size_t>(nextWidth) * nextHeight * 4);
+                downsample(pixels.data() + levelOffsets.back(), levelWidth, levelHeight, pixels.data() + offset);
+                levelOffsets.push_back(offset);
+                levelWidth = nextWidth;
+                levelHeight = nextHeight;
+            }
+        }
+        return;
+    }
+    
     if (enable && !mipmapsEnabled) {
         glBindTexture(GL_TEXTURE_2D, textureID);
         glGenerateMipmap(GL_TEXTURE_2D);
@@ -124,6 +347,10 @@ void Texture::enableMipmapping(bool enable) {
 }
 
 void Texture::setQuality(Quality quality) {
+    if (textureID == 0) {
+        return;
+    }
+    
     glBindTexture(GL_TEXTURE_2D, textureID);
     
     switch (quality) {
@@ -132,19 +359,19 @@ void Texture::setQuality(Quality quality) {
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             break;
-            
+        
         case Quality::MEDIUM:
             // Balanced
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             break;
-            
+        
         case Quality::HIGH:
             // High quality, trilinear filtering
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             break;
-            
+        
         case Quality::ULTRA:
             // Maximum quality with anisotropic filtering (if available)
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -1,51 +1,231 @@
 #include "rendering/TextureManager.h"
+#include "utils/Logger.h"
+#include "engine/Profiler.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 
-TextureManager::TextureManager() {
+namespace {
+    
+    // Ground tile sets loaded at startup (first TILES_PER_TYPE variations each)
+    const std::vector<std::string> GROUND_TILE_TYPES = {
+        "grass_green",
+        "grass_dry",
+        "grass_medium",
+        "dirt",
+        "dirt_dark",
+        "sand",
+        "stone_path",
+        "forest_ground"
+    };
+    const int TILES_PER_TYPE = 10;
+    const std::string GROUND_TILE_DIRECTORY = "assets/individual/ground_tiles/";
+    
+} // namespace
+
+TextureManager::TextureManager()
+    : packHits(0)
+    , memoryBudget(0)
+    , evictions(0)
+    , reloads(0)
+    , overBudget(false)
+    , jobSystem(nullptr)
+    , pendingCount(0)
+    , burstTextures(0)
+    , burstDecodeMilliseconds(0.0)
+    , burstSlowestDecode(0.0)
+{
 }
 
 TextureManager::~TextureManager() {
     clear();
 }
 
+bool TextureManager::openAssetPack(const std::string& path) {
+    if (!pack.open(path)) {
+        return false;
+    }
+    LOG_INFO("Asset pack " + path + ": " + std::to_string(pack.getEntryCount()) + " textures");
+    return true;
+}
+
 bool TextureManager::loadTexture(const std::string& name, const std::string& path, bool generateMipmap) {
     // Check if already loaded
-    if (hasTexture(name)) {
+    if (hasTexture(name) || queuedNames.count(name) > 0) {
         std::cout << "Texture '" << name << "' already loaded" << std::endl;
         return true;
     }
     
-    auto texture = std::make_unique<Texture>();
-    if (texture->loadFromFile(path.c_str(), generateMipmap)) {
-        textures[name] = std::move(texture);
+    return startLoad(name, path, generateMipmap);
+}
+
+bool TextureManager::startLoad(const std::string& name, const std::string& path, bool generateMipmap) {
+    // Cooked: upload straight from the mapping, nothing to decode
+    if (const AssetPack::Entry* entry = pack.find(path)) {
+        std::vector<const unsigned char*> levels;
+        for (uint32_t level = 0; level < entry->levels && (generateMipmap || level == 0); ++level) {
+            levels.push_back(pack.getLevel(*entry, level));
+        }
+        bool loaded = uploadTexture(name, path, generateMipmap, [&](Texture& texture) {
+            return texture.loadFromMipChain(levels, static_cast<int>(entry->width), static_cast<int>(entry->height));
+        });
+        if (loaded) {
+            packHits++;
+            return true;
+        }
+    }
+    
+    if (jobSystem) {
+        queueDecode(name, path, generateMipmap);
         return true;
     }
     
-    return false;
+    return uploadTexture(name, path, generateMipmap, [&](Texture& texture) {
+        return texture.loadFromFile(path.c_str(), generateMipmap);
+    });
+}
+
+bool TextureManager::uploadTexture(const std::string& name, const std::string& path, bool generateMipmap,
+                                   const std::function<bool(Texture&)>& load)
+{
+    auto it = textures.find(name);
+    if (it == textures.end()) {
+        auto texture = std::make_unique<Texture>();
+        if (!load(*texture)) {
+            return false;
+        }
+        it = textures.emplace(name, std::move(texture)).first;
+        sources[name] = { name, path, generateMipmap };
+    } else {
+        // Evicted: fill the same object, so pointers held elsewhere stay valid
+        if (!load(*it->second)) {
+            std::cerr << "Failed to reload texture '" << name << "', it stays untextured" << std::endl;
+            sources.erase(name);
+            return false;
+        }
+        evictedBytes.erase(name);
+        reloads++;
+    }
+    
+    // Counts as drawn now, so it can't be evicted before its first frame
+    it->second->markUsed();
+    return true;
+}
+
+void TextureManager::beginFrame() {
+    // Bring back evicted textures that were drawn last frame
+    std::vector<std::string> wanted;
+    for (const auto& evicted : evictedBytes) {
+        const std::string& name = evicted.first;
+        if (textures[name]->getLastUsedFrame() >= Texture::getCurrentFrame() &&
+            queuedNames.count(name) == 0 && sources.count(name) > 0) {
+            wanted.push_back(name);
+        }
+    }
+    for (const std::string& name : wanted) {
+        const TextureSource source = sources[name];
+        startLoad(name, source.path, source.generateMipmap);
+    }
+    
+    Texture::advanceFrame();
+    enforceBudget();
+}
+
+void TextureManager::enforceBudget() {
+    if (memoryBudget == 0) {
+        return;
+    }
+    
+    size_t resident = 0;
+    std::vector<std::pair<uint64_t, const std::string*>> candidates;
+    const uint64_t frame = Texture::getCurrentFrame();
+    for (const auto& entry : textures) {
+        const Texture& texture = *entry.second;
+        if (!texture.isResident()) {
+            continue;
+        }
+        resident += texture.getMemoryBytes();
+        if (frame - texture.getLastUsedFrame() >= EVICTION_MIN_AGE) {
+            candidates.emplace_back(texture.getLastUsedFrame(), &entry.first);
+        }
+    }
+    if (resident <= memoryBudget) {
+        overBudget = false;
+        return;
+    }
+    
+    // Least recently drawn first
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& candidate : candidates) {
+        if (resident <= memoryBudget) {
+            break;
+        }
+        Texture& texture = *textures[*candidate.second];
+        size_t bytes = texture.getMemoryBytes();
+        texture.release();
+        evictedBytes[*candidate.second] = bytes;
+        resident -= bytes;
+        evictions++;
+    }
+    
+    if (resident > memoryBudget && !overBudget) {
+        overBudget = true;
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1) << "Textures used in the last " << EVICTION_MIN_AGE
+           << " frames take " << (resident / (1024.0 * 1024.0)) << " MB, over the "
+           << (memoryBudget / (1024.0 * 1024.0)) << " MB texture budget";
+        LOG_WARNING(ss.str());
+    }
+}
+
+TextureManager::MemoryReport TextureManager::getMemoryReport() const {
+    MemoryReport report = {};
+    report.budget = memoryBudget;
+    report.evictions = evictions;
+    report.reloads = reloads;
+    for (const auto& entry : textures) {
+        if (entry.second->isResident()) {
+            report.residentBytes += entry.second->getMemoryBytes();
+            report.residentCount++;
+        }
+    }
+    for (const auto& evicted : evictedBytes) {
+        report.evictedBytes += evicted.second;
+        report.evictedCount++;
+    }
+    return report;
+}
+
+void TextureManager::logMemoryReport() const {
+    MemoryReport report = getMemoryReport();
+    const double megabyte = 1024.0 * 1024.0;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << "Texture memory: " << (report.residentBytes / megabyte) << " MB resident in "
+       << report.residentCount << " textures, " << (report.evictedBytes / megabyte) << " MB evicted in "
+       << report.evictedCount << " (budget ";
+    if (report.budget > 0) {
+        ss << (report.budget / megabyte) << " MB";
+    } else {
+        ss << "unlimited";
+    }
+    ss << ", " << report.evictions << " evictions, " << report.reloads << " reloads)";
+    LOG_INFO(ss.str());
 }
 
 bool TextureManager::loadTileVariations(const std::string& baseName, const std::string& directory, int count) {
     int loaded = 0;
     
-    for (int i = 0; i < count; ++i) {
-        std::string textureName = formatTextureName(baseName, i);
-        
-        // Format: baseName_64x32-000.png (e.g., grass_green_64x32-000.png)
-        std::stringstream pathStream;
-        pathStream << directory << baseName << "_64x32-" 
-                   << std::setfill('0') << std::setw(3) << i << ".png";
-        
-        std::string path = pathStream.str();
-        
-        if (loadTexture(textureName, path, true)) {
+    for (const TextureSource& source : getTileVariationSources(baseName, directory, count)) {
+        if (loadTexture(source.name, source.path, source.generateMipmap)) {
             loaded++;
         }
     }
     
     if (loaded > 0) {
-        std::cout << "Loaded " << loaded << "/" << count << " variations of " << baseName << std::endl;
+        std::cout << (jobSystem ? "Queued " : "Loaded ") << loaded << "/" << count
+                  << " variations of " << baseName << std::endl;
     }
     
     return loaded > 0;
@@ -54,26 +234,11 @@ bool TextureManager::loadTileVariations(const std::string& baseName, const std::
 bool TextureManager::loadGroundTiles() {
     std::cout << "Loading ground tile textures..." << std::endl;
     
-    // List of tile types to load
-    const std::vector<std::string> tileTypes = {
-        "grass_green",
-        "grass_dry",
-        "grass_medium",
-        "dirt",
-        "dirt_dark",
-        "sand",
-        "stone_path",
-        "forest_ground"
-    };
-    
-    const int tilesPerType = 10; // Load first 10 variations of each tile type
-    const std::string baseDir = "assets/individual/ground_tiles/";
-    
     int totalLoaded = 0;
-    for (const auto& tileType : tileTypes) {
-        std::string directory = baseDir + tileType + "_64x32/";
-        if (loadTileVariations(tileType, directory, tilesPerType)) {
-            totalLoaded += tilesPerType;
+    for (const auto& tileType : GROUND_TILE_TYPES) {
+        std::string directory = GROUND_TILE_DIRECTORY + tileType + "_64x32/";
+        if (loadTileVariations(tileType, directory, TILES_PER_TYPE)) {
+            totalLoaded += TILES_PER_TYPE;
         }
     }
     
@@ -85,8 +250,34 @@ bool TextureManager::loadDecorations() {
     std::cout << "Loading decoration textures..." << std::endl;
     
     int loaded = 0;
+    for (const TextureSource& source : getDecorationSources()) {
+        if (loadTexture(source.name, source.path, source.generateMipmap)) {
+            loaded++;
+        }
+    }
     
-    // Load tree variations (20 types)
+    std::cout << "Decorations loaded: " << loaded << " total textures" << std::endl;
+    return loaded > 0;
+}
+
+std::vector<TextureManager::TextureSource> TextureManager::getTileVariationSources(
+    const std::string& baseName, const std::string& directory, int count)
+{
+    std::vector<TextureSource> sources;
+    for (int i = 0; i < count; ++i) {
+        // Format: baseName_64x32-000.png (e.g., grass_green_64x32-000.png)
+        std::stringstream pathStream;
+        pathStream << directory << baseName << "_64x32-" 
+                   << std::setfill('0') << std::setw(3) << i << ".png";
+        sources.push_back({ formatTextureName(baseName, i), pathStream.str(), true });
+    }
+    return sources;
+}
+
+std::vector<TextureManager::TextureSource> TextureManager::getDecorationSources() {
+    std::vector<TextureSource> sources;
+    
+    // Tree variations (20 types)
     const int treeCount = 20;
     const std::string treeDir = "assets/individual/trees/trees_64x32_shaded/";
     
@@ -94,45 +285,31 @@ bool TextureManager::loadDecorations() {
         std::stringstream pathStream;
         pathStream << treeDir << "trees_64x32_shaded-" 
                    << std::setfill('0') << std::setw(3) << i << ".png";
-        
-        std::string textureName = formatTextureName("tree", i);
-        if (loadTexture(textureName, pathStream.str(), true)) {
-            loaded++;
-        }
+        sources.push_back({ formatTextureName("tree", i), pathStream.str(), true });
     }
     
-    // Load bushes (from main assets directory)
-    std::vector<std::pair<std::string, std::string>> bushes = {
-        {"bush_1", "assets/hjm-bushes_01-alpha.png"},
-        {"bush_2", "assets/hjm-bushes_02-alpha.png"},
-        {"bush_3", "assets/hjm-bushes_03-alpha.png"}
-    };
+    // Bushes, rocks and the pond (from main assets directory)
+    sources.push_back({ "bush_1", "assets/hjm-bushes_01-alpha.png", true });
+    sources.push_back({ "bush_2", "assets/hjm-bushes_02-alpha.png", true });
+    sources.push_back({ "bush_3", "assets/hjm-bushes_03-alpha.png", true });
+    sources.push_back({ "rocks_1", "assets/hjm-assorted_rocks_1.png", true });
+    sources.push_back({ "rocks_2", "assets/hjm-assorted_rocks_2.png", true });
+    sources.push_back({ "pond", "assets/hjm-pond_1.png", true });
     
-    for (const auto& bush : bushes) {
-        if (loadTexture(bush.first, bush.second, true)) {
-            loaded++;
-        }
-    }
-    
-    // Load rocks
-    std::vector<std::pair<std::string, std::string>> rocks = {
-        {"rocks_1", "assets/hjm-assorted_rocks_1.png"},
-        {"rocks_2", "assets/hjm-assorted_rocks_2.png"}
-    };
-    
-    for (const auto& rock : rocks) {
-        if (loadTexture(rock.first, rock.second, true)) {
-            loaded++;
-        }
-    }
-    
-    // Load pond decoration
-    if (loadTexture("pond", "assets/hjm-pond_1.png", true)) {
-        loaded++;
+    return sources;
+}
+
+std::vector<TextureManager::TextureSource> TextureManager::getStartupSources() {
+    std::vector<TextureSource> sources;
+    for (const auto& tileType : GROUND_TILE_TYPES) {
+        std::string directory = GROUND_TILE_DIRECTORY + tileType + "_64x32/";
+        std::vector<TextureSource> variations = getTileVariationSources(tileType, directory, TILES_PER_TYPE);
+        sources.insert(sources.end(), variations.begin(), variations.end());
     }
     
-    std::cout << "Decorations loaded: " << loaded << " total textures" << std::endl;
-    return loaded > 0;
+    std::vector<TextureSource> decorations = getDecorationSources();
+    sources.insert(sources.end(), decorations.begin(), decorations.end());
+    return sources;
 }
 
 Texture* TextureManager::getTexture(const std::string& name) {
@@ -160,11 +337,123 @@ bool TextureManager::hasTexture(const std::string& name) const {
     return textures.find(name) != textures.end();
 }
 
+void TextureManager::queueDecode(const std::string& name, const std::string& path, bool generateMipmap) {
+    if (pendingCount == 0) {
+        burstStart = std::chrono::steady_clock::now();
+        burstTextures = 0;
+        burstDecodeMilliseconds = 0.0;
+        burstSlowestDecode = 0.0;
+    }
+    queuedNames.insert(name);
+    pendingCount++;
+    burstTextures++;
+    
+    jobSystem->run([this, name, path, generateMipmap]() {
+        auto start = std::chrono::steady_clock::now();
+        
+        DecodedImage image;
+        image.name = name;
+        image.path = path;
+        image.width = 0;
+        image.height = 0;
+        image.channels = 0;
+        image.generateMipmap = generateMipmap;
+        image.data = Texture::decodeImage(path.c_str(), image.width, image.height, image.channels);
+        if (!image.data) {
+            image.error = Texture::decodeError();
+        }
+        image.decodeMilliseconds = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back(std::move(image));
+    }, &decodeCounter);
+}
+
+size_t TextureManager::processUploads(size_t maxUploads) {
+    if (pendingCount == 0) {
+        return 0;
+    }
+    PROFILE_SCOPE("TextureManager::processUploads");
+    
+    std::vector<DecodedImage> ready;
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        size_t count = std::min(maxUploads, decoded.size());
+        ready.assign(std::make_move_iterator(decoded.begin()), std::make_move_iterator(decoded.begin() + count));
+        decoded.erase(decoded.begin(), decoded.begin() + count);
+    }
+    
+    size_t uploaded = 0;
+    for (DecodedImage& image : ready) {
+        queuedNames.erase(image.name);
+        pendingCount--;
+        burstDecodeMilliseconds += image.decodeMilliseconds;
+        burstSlowestDecode = std::max(burstSlowestDecode, image.decodeMilliseconds);
+        
+        if (!image.data) {
+            std::cerr << "Failed to load texture: " << image.path << std::endl;
+            std::cerr << "STB Error: " << image.error << std::endl;
+            sources.erase(image.name); // Don't retry a failed reload every frame
+            continue;
+        }
+        
+        // Reloads refill existing objects; only new textures are news to callers
+        const bool reload = hasTexture(image.name);
+        bool loaded = uploadTexture(image.name, image.path, image.generateMipmap, [&](Texture& texture) {
+            return texture.loadFromImage(image.data, image.width, image.height, image.channels, image.generateMipmap);
+        });
+        if (loaded && !reload) {
+            uploaded++;
+        }
+        Texture::freeImage(image.data);
+    }
+    
+    if (!ready.empty() && pendingCount == 0) {
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - burstStart).count();
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1)
+           << "Textures: " << burstTextures << " decoded on " << jobSystem->getWorkerCount()
+           << " workers, all uploaded " << elapsed << " ms after the first request (decode total "
+           << burstDecodeMilliseconds << " ms, slowest " << burstSlowestDecode << " ms)";
+        LOG_INFO(ss.str());
+    }
+    return uploaded;
+}
+
+void TextureManager::finishLoading() {
+    if (pendingCount == 0) {
+        return;
+    }
+    jobSystem->wait(decodeCounter);
+    processUploads();
+}
+
+void TextureManager::discardPendingLoads() {
+    if (pendingCount == 0) {
+        return;
+    }
+    
+    // Workers still hold a pointer to this manager
+    jobSystem->wait(decodeCounter);
+    for (DecodedImage& image : decoded) {
+        if (image.data) {
+            Texture::freeImage(image.data);
+        }
+    }
+    decoded.clear();
+    queuedNames.clear();
+    pendingCount = 0;
+}
+
 void TextureManager::clear() {
+    discardPendingLoads();
     textures.clear();
+    sources.clear();
+    evictedBytes.clear();
 }
 
-std::string TextureManager::formatTextureName(const std::string& baseName, int index) const {
+std::string TextureManager::formatTextureName(const std::string& baseName, int index) {
     std::stringstream ss;
     ss << baseName << "_" << index;
     return ss.str();
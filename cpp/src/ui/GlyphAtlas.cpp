@@ -0,0 +1,215 @@
+#include "ui/GlyphAtlas.h"
+#include "rendering/Renderer.h"
+#include "rendering/Texture.h"
+#include "utils/Logger.h"
+#include <cstring>
+
+// ASCII 32-126, one byte per row (top row first), bit 4 = leftmost column
+static const unsigned char FONT_5X7[95][GlyphAtlas::GLYPH_HEIGHT] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // '!'
+    { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // '#'
+    { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // '$'
+    { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+    { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // '&'
+    { 0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '\''
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+    { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // '*'
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // '+'
+    { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ','
+    { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '-'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // '.'
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+    { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // '0'
+    { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // '1'
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // '2'
+    { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // '3'
+    { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // '4'
+    { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // '5'
+    { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // '6'
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // '8'
+    { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // '9'
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ';'
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+    { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // '='
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+    { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // '@'
+    { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'A'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // 'B'
+    { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // 'C'
+    { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // 'D'
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // 'E'
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // 'F'
+    { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // 'G'
+    { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'H'
+    { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'I'
+    { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'J'
+    { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // 'L'
+    { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+    { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+    { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'O'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // 'P'
+    { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // 'Q'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // 'R'
+    { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // 'S'
+    { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'U'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'V'
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // 'W'
+    { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // 'X'
+    { 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04 }, // 'Y'
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // 'Z'
+    { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E }, // '['
+    { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // '\\'
+    { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E }, // ']'
+    { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F }, // '_'
+    { 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F }, // 'a'
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E }, // 'b'
+    { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E }, // 'c'
+    { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F }, // 'd'
+    { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E }, // 'e'
+    { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 }, // 'f'
+    { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'g'
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'h'
+    { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E }, // 'i'
+    { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C }, // 'j'
+    { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 }, // 'k'
+    { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'l'
+    { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 }, // 'm'
+    { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'n'
+    { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E }, // 'o'
+    { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 }, // 'p'
+    { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 }, // 'q'
+    { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 }, // 'r'
+    { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E }, // 's'
+    { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 }, // 't'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D }, // 'u'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'v'
+    { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A }, // 'w'
+    { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 }, // 'x'
+    { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'y'
+    { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F }, // 'z'
+    { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // '{'
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // '|'
+    { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // '}'
+    { 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 }, // '~'
+};
+
+static const char FIRST_GLYPH = ' ';
+static const char LAST_GLYPH = '~';
+
+// ===== GlyphAtlas Implementation =====
+
+GlyphAtlas::GlyphAtlas() {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    shutdown();
+}
+
+bool GlyphAtlas::initialize() {
+    // White glyphs in the alpha channel (tinted by the vertex color),
+    // bottom row first like every texture upload
+    std::vector<unsigned char> pixels(ATLAS_WIDTH * ATLAS_HEIGHT * 4, 0);
+    for (int glyph = 0; glyph <= LAST_GLYPH - FIRST_GLYPH; ++glyph) {
+        int cellX = (glyph % COLUMNS) * CELL_SIZE;
+        int cellY = (glyph / COLUMNS) * CELL_SIZE;
+        for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+            for (int column = 0; column < GLYPH_WIDTH; ++column) {
+                if (!(FONT_5X7[glyph][row] & (0x10 >> column))) {
+                    continue;
+                }
+                int y = ATLAS_HEIGHT - 1 - (cellY + row);
+                unsigned char* texel = &pixels[(y * ATLAS_WIDTH + cellX + column) * 4];
+                std::memset(texel, 255, 4);
+            }
+        }
+    }
+    
+    texture = std::make_unique<Texture>();
+    if (!texture->loadFromImage(pixels.data(), ATLAS_WIDTH, ATLAS_HEIGHT, 4, false)) {
+        LOG_ERROR("Failed to create the glyph atlas");
+        texture.reset();
+        return false;
+    }
+    texture->setFilterMode(GL_NEAREST, GL_NEAREST);
+    return true;
+}
+
+void GlyphAtlas::shutdown() {
+    texture.reset();
+}
+
+void GlyphAtlas::getGlyphRegion(char c, glm::vec2& texCoordMin, glm::vec2& texCoordMax) const {
+    if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+        c = '?';
+    }
+    int glyph = c - FIRST_GLYPH;
+    float cellX = static_cast<float>((glyph % COLUMNS) * CELL_SIZE);
+    float cellY = static_cast<float>((glyph / COLUMNS) * CELL_SIZE);
+    
+    // Texture v runs bottom up
+    texCoordMin = glm::vec2(cellX / ATLAS_WIDTH, 1.0f - cellY / ATLAS_HEIGHT);
+    texCoordMax = glm::vec2((cellX + GLYPH_WIDTH) / ATLAS_WIDTH, 1.0f - (cellY + GLYPH_HEIGHT) / ATLAS_HEIGHT);
+}
+
+glm::vec2 GlyphAtlas::measureText(const std::string& text, float scale) {
+    return glm::vec2(ADVANCE * scale * text.size(), GLYPH_HEIGHT * PIXEL_SIZE * scale);
+}
+
+// ===== TextLayoutCache Implementation =====
+
+TextLayoutCache::TextLayoutCache(const GlyphAtlas* atlas)
+    : atlas(atlas)
+    , hits(0)
+    , misses(0)
+{
+}
+
+const std::vector<QuadVertex>& TextLayoutCache::getLayout(
+    const std::string& text,
+    float scale,
+    const glm::vec3& color,
+    int texSlot)
+{
+    // Key: the text followed by the raw style values
+    const float style[5] = { scale, color.x, color.y, color.z, static_cast<float>(texSlot) };
+    keyScratch.assign(text);
+    keyScratch.append(reinterpret_cast<const char*>(style), sizeof(style));
+    
+    auto it = layouts.find(keyScratch);
+    if (it != layouts.end()) {
+        hits++;
+        return it->second;
+    }
+    
+    misses++;
+    if (layouts.size() >= MAX_ENTRIES) {
+        layouts.clear();
+    }
+    
+    std::vector<QuadVertex>& quads = layouts[keyScratch];
+    const glm::vec2 glyphSize(GlyphAtlas::GLYPH_WIDTH * GlyphAtlas::PIXEL_SIZE * scale,
+                              GlyphAtlas::GLYPH_HEIGHT * GlyphAtlas::PIXEL_SIZE * scale);
+    const glm::vec4 tint(color, 1.0f);
+    float x = 0.0f;
+    for (char c : text) {
+        if (c != ' ') {
+            glm::vec2 texCoordMin, texCoordMax;
+            atlas->getGlyphRegion(c, texCoordMin, texCoordMax);
+            quads.resize(quads.size() + 4);
+            Renderer::buildQuadVertices(&quads[quads.size() - 4], glm::vec2(x, 0.0f), glyphSize, tint,
+                                        static_cast<float>(texSlot), 0.0f, texCoordMin, texCoordMax);
+        }
+        x += GlyphAtlas::ADVANCE * scale;
+    }
+    return quads;
+}
@@ -6,6 +6,8 @@
 MainMenu::MainMenu(Engine* engine, GameStateManager* stateManager)
     : engine(engine)
     , stateManager(stateManager)
+    , backgroundPanel(nullptr)
+    , titleLabel(nullptr)
     , mouseX(0)
     , mouseY(0)
 {
@@ -26,22 +28,25 @@ bool MainMenu::initialize() {
 
 void MainMenu::shutdown() {
     menuButtons.clear();
-    backgroundPanel.reset();
-    titleLabel.reset();
+    backgroundPanel = nullptr;
+    titleLabel = nullptr;
+    canvas.reset();
 }
 
 void MainMenu::createUI() {
     int screenWidth = engine->getWidth();
     int screenHeight = engine->getHeight();
     
+    canvas = std::make_unique<UICanvas>(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+    
     // Create semi-transparent background panel
-    backgroundPanel = std::make_unique<UIPanel>(0.0f, 0.0f, static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+    backgroundPanel = canvas->addChild(std::make_unique<UIPanel>(0.0f, 0.0f, static_cast<float>(screenWidth), static_cast<float>(screenHeight)));
     backgroundPanel->setColor(glm::vec4(0.05f, 0.05f, 0.1f, 0.95f));
     
     // Create title label
     float titleX = static_cast<float>(screenWidth / 2 - 200);
     float titleY = 100.0f;
-    titleLabel = std::make_unique<UILabel>(titleX, titleY, "THE DAILY GRIND");
+    titleLabel = canvas->addChild(std::make_unique<UILabel>(titleX, titleY, "THE DAILY GRIND"));
     titleLabel->setScale(2.0f);
     titleLabel->setColor(glm::vec3(1.0f, 0.9f, 0.7f));
     
@@ -60,18 +65,18 @@ void MainMenu::createUI() {
 }
 
 void MainMenu::createMenuButton(const std::string& text, float x, float y, std::function<void()> callback) {
-    auto button = std::make_unique<UIButton>(x, y, 300.0f, 50.0f, text);
+    UIButton* button = canvas->addChild(std::make_unique<UIButton>(x, y, 300.0f, 50.0f, text));
     button->setColor(glm::vec3(0.2f, 0.3f, 0.4f));
     button->setHoverColor(glm::vec3(0.3f, 0.5f, 0.6f));
     button->setTextColor(glm::vec3(1.0f, 1.0f, 1.0f));
     button->onClick(callback);
-    menuButtons.push_back(std::move(button));
+    menuButtons.push_back(button);
 }
 
 void MainMenu::update(float deltaTime) {
     (void)deltaTime; // Unused for now
-    // Update button hover states
-    for (auto& button : menuButtons) {
+    // Update button hover states (only a change dirties the menu)
+    for (UIButton* button : menuButtons) {
         bool wasHovered = button->isHovered();
         bool isHovered = button->contains(mouseX, mouseY);
         button->setHovered(isHovered);
@@ -84,48 +89,11 @@ void MainMenu::update(float deltaTime) {
 }
 
 void MainMenu::render(UIRenderer* uiRenderer) {
-    if (!uiRenderer) return;
+    if (!uiRenderer || !canvas) return;
     
+    // One draw call; the geometry is rebuilt only after a hover change
     uiRenderer->beginFrame();
-    
-    // Render background
-    if (backgroundPanel) {
-        auto color = backgroundPanel->getColor();
-        auto pos = backgroundPanel->getPosition();
-        auto size = backgroundPanel->getSize();
-        uiRenderer->drawRect(pos.x, pos.y, size.x, size.y, color);
-    }
-    
-    // Render title
-    if (titleLabel) {
-        auto pos = titleLabel->getPosition();
-        auto color = titleLabel->getColor();
-        uiRenderer->drawText(titleLabel->getText(), pos.x, pos.y, 2.0f, color);
-    }
-    
-    // Render buttons
-    for (const auto& button : menuButtons) {
-        if (!button->isVisible()) continue;
-        
-        auto pos = button->getPosition();
-        auto size = button->getSize();
-        
-        // Draw button background
-        glm::vec3 bgColor = button->isHovered() ? 
-            glm::vec3(0.3f, 0.5f, 0.6f) : glm::vec3(0.2f, 0.3f, 0.4f);
-        uiRenderer->drawRect(pos.x, pos.y, size.x, size.y, glm::vec4(bgColor, 1.0f));
-        
-        // Draw button border
-        glm::vec4 borderColor = button->isHovered() ? 
-            glm::vec4(0.6f, 0.8f, 0.9f, 1.0f) : glm::vec4(0.4f, 0.5f, 0.6f, 1.0f);
-        uiRenderer->drawRectOutline(pos.x, pos.y, size.x, size.y, borderColor, 2.0f);
-        
-        // Draw button text (centered)
-        float textX = pos.x + 20;
-        float textY = pos.y + 15;
-        uiRenderer->drawText(button->getText(), textX, textY, 1.0f, glm::vec3(1.0f));
-    }
-    
+    uiRenderer->render(*canvas);
     uiRenderer->endFrame();
 }
 
@@ -140,7 +108,7 @@ void MainMenu::handleMouseMove(float x, float y) {
 
 void MainMenu::handleMouseClick(float x, float y) {
     // Check if any button was clicked
-    for (auto& button : menuButtons) {
+    for (UIButton* button : menuButtons) {
         if (button->isVisible() && button->isEnabled() && button->contains(x, y)) {
             LOG_INFO("Button clicked: " + button->getText());
             button->handleClick();
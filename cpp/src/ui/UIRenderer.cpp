@@ -1,8 +1,57 @@
 #include "ui/UIRenderer.h"
-#include "rendering/Shader.h"
+#include "rendering/Renderer.h"
 #include "utils/Logger.h"
 #include <glm/gtc/matrix_transform.hpp>
 
+// ===== UIGeometry Implementation =====
+
+void UIGeometry::addRect(float x, float y, float width, float height, const glm::vec4& color) {
+    vertices.resize(vertices.size() + 4);
+    Renderer::buildQuadVertices(&vertices[vertices.size() - 4], glm::vec2(x, y), glm::vec2(width, height), color, -1.0f);
+}
+
+void UIGeometry::addRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness) {
+    addRect(x, y, width, thickness, color); // Top
+    addRect(x, y + height - thickness, width, thickness, color); // Bottom
+    addRect(x, y + thickness, thickness, height - 2.0f * thickness, color); // Left
+    addRect(x + width - thickness, y + thickness, thickness, height - 2.0f * thickness, color); // Right
+}
+
+void UIGeometry::addLine(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float thickness) {
+    glm::vec2 direction = to - from;
+    float length = glm::length(direction);
+    if (length < 0.001f) {
+        return;
+    }
+    
+    // A quad along the line, thickness wide
+    glm::vec2 offset = glm::vec2(-direction.y, direction.x) * (thickness * 0.5f / length);
+    const glm::vec2 corners[4] = { from + offset, to + offset, to - offset, from - offset };
+    for (const glm::vec2& corner : corners) {
+        QuadVertex vertex;
+        vertex.position = glm::vec3(corner, 0.0f);
+        vertex.color = color;
+        vertex.texCoord = glm::vec2(0.0f);
+        vertex.texIndex = -1.0f;
+        vertices.push_back(vertex);
+    }
+}
+
+void UIGeometry::addText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
+    if (!textLayouts || text.empty()) {
+        return;
+    }
+    
+    // Shaped once per string and style, then only copied
+    const std::vector<QuadVertex>& layout = textLayouts->getLayout(text, scale, color, FONT_SLOT);
+    size_t first = vertices.size();
+    vertices.insert(vertices.end(), layout.begin(), layout.end());
+    for (size_t i = first; i < vertices.size(); ++i) {
+        vertices[i].position.x += x;
+        vertices[i].position.y += y;
+    }
+}
+
 // ===== UIElement Implementation =====
 
 bool UIElement::contains(float x, float y) const {
@@ -10,6 +59,56 @@ bool UIElement::contains(float x, float y) const {
            y >= position.y && y <= position.y + size.y;
 }
 
+void UIElement::setPosition(float x, float y) {
+    if (position != glm::vec2(x, y)) {
+        position = glm::vec2(x, y);
+        markDirty();
+    }
+}
+
+void UIElement::setSize(float w, float h) {
+    if (size != glm::vec2(w, h)) {
+        size = glm::vec2(w, h);
+        markDirty();
+    }
+}
+
+void UIElement::setVisible(bool v) {
+    if (visible != v) {
+        visible = v;
+        markDirty();
+    }
+}
+
+void UIElement::markDirty() {
+    // Up to the root: hidden subtrees aren't rebuilt, so their flags may be stale
+    for (UIElement* element = this; element; element = element->parent) {
+        element->dirty = true;
+    }
+}
+
+// ===== UICanvas Implementation =====
+
+UICanvas::UICanvas(float width, float height)
+    : UIElement(0.0f, 0.0f, width, height)
+    , backend(nullptr)
+    , geometry(RenderBackend::INVALID_GEOMETRY)
+{
+}
+
+UICanvas::~UICanvas() {
+    releaseGeometry();
+}
+
+void UICanvas::releaseGeometry() {
+    if (backend && geometry != RenderBackend::INVALID_GEOMETRY) {
+        backend->destroyStaticGeometry(geometry);
+    }
+    geometry = RenderBackend::INVALID_GEOMETRY;
+    backend = nullptr;
+    markDirty();
+}
+
 // ===== UIButton Implementation =====
 
 UIButton::UIButton(float x, float y, float width, float height, const std::string& text)
@@ -22,8 +121,14 @@ UIButton::UIButton(float x, float y, float width, float height, const std::strin
 {
 }
 
-void UIButton::render() {
-    // Rendered by UIRenderer
+void UIButton::build(UIGeometry& geometry) const {
+    // Background, border (lighter than the background) and centered text
+    glm::vec3 background = hovered ? hoverColor : color;
+    geometry.addRect(position.x, position.y, size.x, size.y, glm::vec4(background, 1.0f));
+    geometry.addRectOutline(position.x, position.y, size.x, size.y, glm::vec4(glm::min(background * 2.0f, glm::vec3(1.0f)), 1.0f));
+    
+    glm::vec2 textSize = UIGeometry::measureText(text, 1.0f);
+    geometry.addText(text, position.x + (size.x - textSize.x) * 0.5f, position.y + (size.y - textSize.y) * 0.5f, 1.0f, textColor);
 }
 
 void UIButton::handleClick() {
@@ -32,6 +137,35 @@ void UIButton::handleClick() {
     }
 }
 
+void UIButton::setText(const std::string& txt) {
+    if (text != txt) {
+        text = txt;
+        markDirty();
+    }
+}
+
+void UIButton::setHovered(bool h) {
+    if (hovered != h) {
+        hovered = h;
+        markDirty();
+    }
+}
+
+void UIButton::setColor(const glm::vec3& c) {
+    color = c;
+    markDirty();
+}
+
+void UIButton::setHoverColor(const glm::vec3& c) {
+    hoverColor = c;
+    markDirty();
+}
+
+void UIButton::setTextColor(const glm::vec3& c) {
+    textColor = c;
+    markDirty();
+}
+
 // ===== UIPanel Implementation =====
 
 UIPanel::UIPanel(float x, float y, float width, float height)
@@ -40,8 +174,13 @@ UIPanel::UIPanel(float x, float y, float width, float height)
 {
 }
 
-void UIPanel::render() {
-    // Rendered by UIRenderer
+void UIPanel::build(UIGeometry& geometry) const {
+    geometry.addRect(position.x, position.y, size.x, size.y, color);
+}
+
+void UIPanel::setColor(const glm::vec4& c) {
+    color = c;
+    markDirty();
 }
 
 // ===== UILabel Implementation =====
@@ -52,21 +191,41 @@ UILabel::UILabel(float x, float y, const std::string& text)
     , color(1.0f, 1.0f, 1.0f)
     , scale(1.0f)
 {
+    size = UIGeometry::measureText(text, scale);
+}
+
+void UILabel::build(UIGeometry& geometry) const {
+    geometry.addText(text, position.x, position.y, scale, color);
 }
 
-void UILabel::render() {
-    // Rendered by UIRenderer
+void UILabel::setText(const std::string& txt) {
+    if (text != txt) {
+        text = txt;
+        size = UIGeometry::measureText(text, scale);
+        markDirty();
+    }
+}
+
+void UILabel::setColor(const glm::vec3& c) {
+    color = c;
+    markDirty();
+}
+
+void UILabel::setScale(float s) {
+    scale = s;
+    size = UIGeometry::measureText(text, scale);
+    markDirty();
 }
 
 // ===== UIRenderer Implementation =====
 
 UIRenderer::UIRenderer()
-    : screenWidth(1280)
+    : renderer(nullptr)
+    , screenWidth(1280)
     , screenHeight(720)
-    , VAO(0)
-    , VBO(0)
-    , fontVAO(0)
-    , fontVBO(0)
+    , textLayouts(&glyphAtlas)
+    , fontTexture(nullptr)
+    , rebuildCount(0)
 {
 }
 
@@ -74,144 +233,120 @@ UIRenderer::~UIRenderer() {
     shutdown();
 }
 
-bool UIRenderer::initialize(int width, int height) {
+bool UIRenderer::initialize(Renderer* uiRenderer, int width, int height) {
+    if (!uiRenderer) {
+        LOG_ERROR("UI Renderer needs a renderer");
+        return false;
+    }
+    
+    renderer = uiRenderer;
     screenWidth = width;
     screenHeight = height;
     
-    LOG_INFO("Initializing UI Renderer");
-    
-    // Create simple UI shader
-    // For now, we'll use a basic shader
-    // TODO: Create proper UI shaders
-    
-    setupQuadBuffers();
-    initSimpleFontRendering();
+    if (glyphAtlas.initialize()) {
+        fontTexture = glyphAtlas.getTexture();
+        buildGeometry.setTextLayouts(&textLayouts);
+        frameGeometry.setTextLayouts(&textLayouts);
+    } else {
+        LOG_WARNING("UI text disabled: no glyph atlas");
+    }
     
     LOG_INFO("UI Renderer initialized");
     return true;
 }
 
 void UIRenderer::shutdown() {
-    if (VAO != 0) {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        VAO = 0;
-        VBO = 0;
+    // Canvases own their geometry
+    renderer = nullptr;
+    buildGeometry.clear();
+    frameGeometry.clear();
+    buildGeometry.setTextLayouts(nullptr);
+    frameGeometry.setTextLayouts(nullptr);
+    textLayouts.clear();
+    fontTexture = nullptr;
+    glyphAtlas.shutdown();
+}
+
+void UIRenderer::beginFrame() {
+    frameGeometry.clear();
+    if (!renderer) {
+        return;
     }
     
-    if (fontVAO != 0) {
-        glDeleteVertexArrays(1, &fontVAO);
-        glDeleteBuffers(1, &fontVBO);
-        fontVAO = 0;
-        fontVBO = 0;
-    }
+    // Screen pixels, origin top-left; blending is the backend default
+    renderer->setViewMatrix(glm::mat4(1.0f));
+    renderer->setProjectionMatrix(glm::ortho(
+        0.0f, static_cast<float>(screenWidth),
+        static_cast<float>(screenHeight), 0.0f,
+        -1.0f, 1.0f
+    ));
 }
 
-void UIRenderer::setupQuadBuffers() {
-    // Create VAO and VBO for rendering quads
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    
-    // Reserve space for a quad (6 vertices, 2D position only)
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 2, nullptr, GL_DYNAMIC_DRAW);
-    
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glBindVertexArray(0);
+void UIRenderer::endFrame() {
+    if (renderer) {
+        renderer->drawQuads(frameGeometry.getVertices(), frameGeometry.getQuadCount(), &fontTexture, fontTexture ? 1 : 0);
+    }
+    frameGeometry.clear();
 }
 
-void UIRenderer::initSimpleFontRendering() {
-    // Initialize simple font rendering
-    glGenVertexArrays(1, &fontVAO);
-    glGenBuffers(1, &fontVBO);
+void UIRenderer::render(UICanvas& canvas) {
+    if (!renderer) {
+        return;
+    }
     
-    glBindVertexArray(fontVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, fontVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+    RenderBackend* backend = renderer->getBackend();
+    if (canvas.backend != backend) {
+        canvas.releaseGeometry();
+        canvas.backend = backend;
+    }
     
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    if (canvas.isDirty()) {
+        buildGeometry.clear();
+        buildTree(canvas);
+        rebuildCount++;
+        
+        // Keep the handle across rebuilds; an empty tree keeps none
+        size_t quadCount = buildGeometry.getQuadCount();
+        if (canvas.geometry != RenderBackend::INVALID_GEOMETRY &&
+            (quadCount == 0 || !backend->updateStaticGeometry(canvas.geometry, buildGeometry.getVertices(), quadCount))) {
+            backend->destroyStaticGeometry(canvas.geometry);
+            canvas.geometry = RenderBackend::INVALID_GEOMETRY;
+        }
+        if (canvas.geometry == RenderBackend::INVALID_GEOMETRY && quadCount > 0) {
+            canvas.geometry = backend->createStaticGeometry(buildGeometry.getVertices(), quadCount);
+        }
+    }
     
-    glBindVertexArray(0);
+    renderer->drawStaticGeometry(canvas.geometry, &fontTexture, fontTexture ? 1 : 0);
 }
 
-void UIRenderer::beginFrame() {
-    // Enable blending for UI
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Disable depth test for UI (always on top)
-    glDisable(GL_DEPTH_TEST);
-}
 
-void UIRenderer::endFrame() {
-    // Restore OpenGL state
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+void UIRenderer::buildTree(UIElement& element) {
+    element.dirty = false;
+    if (!element.visible) {
+        return;
+    }
+    
+    element.build(buildGeometry);
+    for (const std::unique_ptr<UIElement>& child : element.children) {
+        buildTree(*child);
+    }
 }
 
 void UIRenderer::drawRect(float x, float y, float width, float height, const glm::vec4& color) {
-    // Convert screen coordinates to NDC
-    float ndcX = (x / screenWidth) * 2.0f - 1.0f;
-    float ndcY = 1.0f - (y / screenHeight) * 2.0f;
-    float ndcWidth = (width / screenWidth) * 2.0f;
-    float ndcHeight = (height / screenHeight) * 2.0f;
-    
-    // Create quad vertices
-    float vertices[] = {
-        ndcX, ndcY - ndcHeight,
-        ndcX + ndcWidth, ndcY - ndcHeight,
-        ndcX + ndcWidth, ndcY,
-        
-        ndcX, ndcY - ndcHeight,
-        ndcX + ndcWidth, ndcY,
-        ndcX, ndcY
-    };
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    
-    // Simple color rendering without shader for now
-    // TODO: Use proper shader-based rendering instead of fixed-function pipeline
-    // Note: glColor4f is deprecated - this is a placeholder until proper UI shaders are implemented
-    // For now, rendering will be white/default until shaders are added
-    (void)color; // Suppress unused parameter warning
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    
-    glBindVertexArray(0);
+    frameGeometry.addRect(x, y, width, height, color);
 }
 
 void UIRenderer::drawRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness) {
-    // Draw 4 lines for outline
-    drawRect(x, y, width, thickness, color); // Top
-    drawRect(x, y + height - thickness, width, thickness, color); // Bottom
-    drawRect(x, y, thickness, height, color); // Left
-    drawRect(x + width - thickness, y, thickness, height, color); // Right
+    frameGeometry.addRectOutline(x, y, width, height, color, thickness);
+}
+
+void UIRenderer::drawLine(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float thickness) {
+    frameGeometry.addLine(from, to, color, thickness);
 }
 
 void UIRenderer::drawText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
-    // Simple text rendering using fixed-width characters
-    // This is a placeholder - proper font rendering would use FreeType
-    
-    const float charWidth = 8.0f * scale;
-    const float charHeight = 12.0f * scale;
-    
-    float currentX = x;
-    for (char c : text) {
-        (void)c; // Character not used in this placeholder implementation
-        // Very simple character rendering as rectangles
-        // In a real implementation, this would render actual glyphs
-        drawRect(currentX, y, charWidth, charHeight, glm::vec4(color, 1.0f));
-        currentX += charWidth;
-    }
+    frameGeometry.addText(text, x, y, scale, color);
 }
 
 void UIRenderer::resize(int width, int height) {
@@ -0,0 +1,140 @@
+#include "utils/ImageWriter.h"
+#include <array>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    
+    void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    
+    // Append a chunk: length, type, data, CRC over type + data
+    void appendChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+        appendU32(out, static_cast<uint32_t>(data.size()));
+        size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        appendU32(out, ImageWriter::crc32(out.data() + typeStart, out.size() - typeStart));
+    }
+    
+} // namespace
+
+namespace ImageWriter {
+    
+    uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc) {
+        // Built once; function-local static init is thread-safe
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[i] = c;
+            }
+            return t;
+        }();
+        
+        crc = ~crc;
+        for (size_t i = 0; i < length; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+    
+    uint32_t adler32(const uint8_t* data, size_t length, uint32_t adler) {
+        const uint32_t MOD = 65521;
+        uint32_t a = adler & 0xFFFF;
+        uint32_t b = adler >> 16;
+        
+        // Defer the modulo: 5552 bytes is the most that can't overflow 32 bits
+        while (length > 0) {
+            size_t block = length < 5552 ? length : 5552;
+            length -= block;
+            while (block-- > 0) {
+                a += *data++;
+                b += a;
+            }
+            a %= MOD;
+            b %= MOD;
+        }
+        return (b << 16) | a;
+    }
+    
+    bool encodePNG(int width, int height, const uint8_t* rgba, std::vector<uint8_t>& out) {
+        if (width <= 0 || height <= 0 || !rgba) {
+            return false;
+        }
+        
+        // Raw scanlines, each prefixed with filter type 0 (None)
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> raw;
+        raw.reserve((rowBytes + 1) * height);
+        for (int y = 0; y < height; ++y) {
+            raw.push_back(0);
+            const uint8_t* row = rgba + rowBytes * y;
+            raw.insert(raw.end(), row, row + rowBytes);
+        }
+        
+        // zlib stream of stored deflate blocks (max 65535 bytes each)
+        std::vector<uint8_t> zlib;
+        zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        size_t offset = 0;
+        do {
+            size_t block = raw.size() - offset;
+            if (block > 65535) {
+                block = 65535;
+            }
+            bool last = offset + block == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(block));
+            zlib.push_back(static_cast<uint8_t>(block >> 8));
+            zlib.push_back(static_cast<uint8_t>(~block));
+            zlib.push_back(static_cast<uint8_t>(~block >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + block);
+            offset += block;
+        } while (offset < raw.size());
+        appendU32(zlib, adler32(raw.data(), raw.size()));
+        
+        // IHDR: 8-bit RGBA, no interlace
+        std::vector<uint8_t> header;
+        appendU32(header, static_cast<uint32_t>(width));
+        appendU32(header, static_cast<uint32_t>(height));
+        header.push_back(8);  // Bit depth
+        header.push_back(6);  // Color type RGBA
+        header.push_back(0);  // Compression
+        header.push_back(0);  // Filter
+        header.push_back(0);  // Interlace
+        
+        static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        out.assign(signature, signature + 8);
+        appendChunk(out, "IHDR", header);
+        appendChunk(out, "IDAT", zlib);
+        appendChunk(out, "IEND", std::vector<uint8_t>());
+        return true;
+    }
+    
+    bool writePNG(const std::string& path, int width, int height, const uint8_t* rgba) {
+        std::vector<uint8_t> png;
+        if (!encodePNG(width, height, rgba, png)) {
+            std::cerr << "Failed to encode PNG: " << path << std::endl;
+            return false;
+        }
+        
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open file for writing: " << path << std::endl;
+            return false;
+        }
+        
+        file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+        return file.good();
+    }
+    
+} // namespace ImageWriter
@@ -25,9 +25,15 @@ glm::ivec2 screenToWorld(float screenX, float screenY, int tileWidth, int tileHe
 }
 
 int getRenderOrder(int gridX, int gridY) {
-    // Simple render order: back to front, left to right
-    // Higher values render later (on top)
-    return gridX + gridY;
+    // Delegate to float version to avoid code duplication
+    return getRenderOrder(static_cast<float>(gridX), static_cast<float>(gridY));
+}
+
+int getRenderOrder(float worldX, float worldY) {
+    // Screen Y grows with (x + y) and the projection is Y-up, so larger
+    // x + y is further up the screen, i.e. further back. Back to front
+    // therefore means decreasing x + y; higher values render later (on top).
+    return -static_cast<int>(std::floor((worldX + worldY) * RENDER_ORDER_STEPS));
 }
 
 } // namespace IsometricUtils
@@ -3,10 +3,30 @@
 #include <filesystem>
 #include <ctime>
 #include <random>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
 
-Logger::Logger() 
+namespace {
+    
+    // Signals the crash handler drains the log on
+    const int CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+    
+} // namespace
+
+Logger::Logger()
     : initialized(false)
+    , minLevel(0)
+    , ring(new Entry[RING_CAPACITY])
+    , pushPosition(0)
+    , popPosition(0)
+    , droppedCount(0)
+    , running(false)
+    , wakeRequested(false)
 {
+    for (size_t i = 0; i < RING_CAPACITY; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
 }
 
 Logger::~Logger() {
@@ -37,7 +57,7 @@ bool Logger::initialize(const std::string& logFilePath) {
     std::lock_guard<std::mutex> lock(logMutex);
     
     if (initialized) {
-        return true;
+        return logFile.is_open();
     }
     
     // Generate session ID
@@ -47,39 +67,53 @@ bool Logger::initialize(const std::string& logFilePath) {
     std::filesystem::path logPath(logFilePath);
     std::filesystem::path logDir = logPath.parent_path();
     
+    bool directoryReady = true;
     if (!logDir.empty() && !std::filesystem::exists(logDir)) {
         try {
             std::filesystem::create_directories(logDir);
         } catch (const std::exception& e) {
             std::cerr << "Failed to create logs directory: " << e.what() << std::endl;
-            return false;
+            directoryReady = false;
         }
     }
     
     // Open log file
-    logFile.open(logFilePath, std::ios::app);
-    if (!logFile.is_open()) {
-        std::cerr << "Failed to open log file: " << logFilePath << std::endl;
-        return false;
+    if (directoryReady) {
+        logFile.open(logFilePath, std::ios::app);
+        if (!logFile.is_open()) {
+            std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+        }
     }
     
-    initialized = true;
-    
-    // Write header
-    logFile << "\n========================================" << std::endl;
-    logFile << "The Daily Grind - C++ Engine Log" << std::endl;
-    logFile << "Session ID: " << sessionId << std::endl;
-    logFile << "Start Time: " << getTimestamp() << std::endl;
-    logFile << "========================================\n" << std::endl;
-    logFile.flush();
+    if (logFile.is_open()) {
+        // Write header
+        logFile << "\n========================================" << std::endl;
+        logFile << "The Daily Grind - C++ Engine Log" << std::endl;
+        logFile << "Session ID: " << sessionId << std::endl;
+        logFile << "Start Time: " << getTimestamp() << std::endl;
+        logFile << "========================================\n" << std::endl;
+        logFile.flush();
+        
+        std::cout << "Logger initialized - Session ID: " << sessionId << std::endl;
+    } else {
+        std::cerr << "Logging to the console only" << std::endl;
+    }
     
-    std::cout << "Logger initialized - Session ID: " << sessionId << std::endl;
+    // The writer runs either way, so messages still reach the console and
+    // the ring keeps draining; initialized also stops log() from retrying
+    installCrashHandler();
+    running = true;
+    writerThread = std::thread(&Logger::writerLoop, this);
+    initialized = true;
     
-    return true;
+    return logFile.is_open();
 }
 
 std::string Logger::getTimestamp() {
-    auto now = std::chrono::system_clock::now();
+    return formatTimestamp(Clock::now());
+}
+
+std::string Logger::formatTimestamp(Clock::time_point now) {
     auto time = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()
@@ -110,77 +144,235 @@ std::string Logger::levelToString(Level level) {
     }
 }
 
-void Logger::writeLog(Level level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    
-    if (!initialized) {
+bool Logger::tryPush(Level level, Clock::time_point time, std::string& message) {
+    size_t position = pushPosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Entry& entry = ring[position & (RING_CAPACITY - 1)];
+        size_t sequence = entry.sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            // Free: claim it, fill it, then publish
+            if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                entry.level = level;
+                entry.time = time;
+                entry.message = std::move(message);
+                entry.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (sequence < position) {
+            // Still holds the entry from a lap ago: full
+            return false;
+        } else {
+            // Another thread claimed it first
+            position = pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::wakeWriter() {
+    // Without the mutex a wakeup can be missed; the writer then still
+    // drains within WRITE_INTERVAL
+    wakeRequested.store(true, std::memory_order_release);
+    wakeCondition.notify_one();
+}
+
+void Logger::log(Level level, std::string message) {
+    if (!initialized.load(std::memory_order_acquire)) {
         // If not initialized, try to initialize with default path
         initialize();
     }
     
-    std::string timestamp = getTimestamp();
-    std::string levelStr = levelToString(level);
-    
-    // Format: [timestamp] [LEVEL] message
-    std::stringstream logEntry;
-    logEntry << "[" << timestamp << "] [" << levelStr << "] " << message;
-    
-    // Write to file
-    if (logFile.is_open()) {
-        logFile << logEntry.str() << std::endl;
-        
-        // Flush immediately for errors and fatal logs
-        if (level == Level::ERROR || level == Level::FATAL) {
-            logFile.flush();
+    const Clock::time_point now = Clock::now();
+    const bool urgent = level == Level::ERROR || level == Level::FATAL;
+    if (!tryPush(level, now, message)) {
+        // Errors wait for the writer to make room, but only for so long: a
+        // stalled writer must not hang the caller
+        bool pushed = false;
+        if (urgent) {
+            const auto deadline = std::chrono::steady_clock::now() + URGENT_WAIT;
+            while (!pushed && std::chrono::steady_clock::now() < deadline) {
+                wakeWriter();
+                std::this_thread::yield();
+                pushed = tryPush(level, now, message);
+            }
+        }
+        if (!pushed) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
         }
     }
     
-    // Also write to console
-    if (level == Level::ERROR || level == Level::FATAL) {
-        std::cerr << logEntry.str() << std::endl;
-    } else {
-        std::cout << logEntry.str() << std::endl;
+    // Errors go out right away; otherwise only wake the writer early when
+    // a burst threatens to fill the ring
+    const size_t pending = pushPosition.load(std::memory_order_relaxed) - popPosition.load(std::memory_order_relaxed);
+    if (urgent || pending > RING_CAPACITY / 2) {
+        wakeWriter();
     }
 }
 
-void Logger::log(Level level, const std::string& message) {
-    writeLog(level, message);
+void Logger::debug(std::string message) {
+    log(Level::DEBUG, std::move(message));
 }
 
-void Logger::debug(const std::string& message) {
-    log(Level::DEBUG, message);
+void Logger::info(std::string message) {
+    log(Level::INFO, std::move(message));
 }
 
-void Logger::info(const std::string& message) {
-    log(Level::INFO, message);
+void Logger::warning(std::string message) {
+    log(Level::WARNING, std::move(message));
 }
 
-void Logger::warning(const std::string& message) {
-    log(Level::WARNING, message);
+void Logger::error(std::string message) {
+    log(Level::ERROR, std::move(message));
 }
 
-void Logger::error(const std::string& message) {
-    log(Level::ERROR, message);
+void Logger::fatal(std::string message) {
+    log(Level::FATAL, std::move(message));
 }
 
-void Logger::fatal(const std::string& message) {
-    log(Level::FATAL, message);
+void Logger::writerLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, WRITE_INTERVAL, [this] {
+                return wakeRequested.load(std::memory_order_acquire) || !running.load(std::memory_order_acquire);
+            });
+            wakeRequested.store(false, std::memory_order_relaxed);
+        }
+        
+        std::lock_guard<std::mutex> lock(logMutex);
+        drainLocked();
+    }
+}
+
+void Logger::drainLocked() {
+    // Format: [timestamp] [LEVEL] message
+    // Console lines go out in order, switching streams only between runs
+    // of errors and other levels
+    fileBatch.clear();
+    consoleBatch.clear();
+    bool consoleIsError = false;
+    auto writeConsole = [this, &consoleIsError]() {
+        if (!consoleBatch.empty()) {
+            std::ostream& console = consoleIsError ? std::cerr : std::cout;
+            console << consoleBatch;
+            console.flush();
+            consoleBatch.clear();
+        }
+    };
+    
+    for (;;) {
+        const size_t position = popPosition.load(std::memory_order_relaxed);
+        Entry& entry = ring[position & (RING_CAPACITY - 1)];
+        if (entry.sequence.load(std::memory_order_acquire) != position + 1) {
+            break; // Empty, or the next entry is not published yet
+        }
+        
+        std::string line = "[" + formatTimestamp(entry.time) + "] [" + levelToString(entry.level) + "] ";
+        line += entry.message;
+        line += '\n';
+        
+        const bool isError = entry.level == Level::ERROR || entry.level == Level::FATAL;
+        // Free the text here rather than in the next producer's push
+        entry.message.clear();
+        entry.message.shrink_to_fit();
+        entry.sequence.store(position + RING_CAPACITY, std::memory_order_release);
+        popPosition.store(position + 1, std::memory_order_relaxed);
+        
+        if (isError != consoleIsError) {
+            writeConsole();
+            consoleIsError = isError;
+        }
+        consoleBatch += line;
+        fileBatch += line;
+    }
+    
+    const size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::string line = "[" + getTimestamp() + "] [WARNING] " + std::to_string(dropped) +
+                           " log messages dropped (buffer full)\n";
+        if (consoleIsError) {
+            writeConsole();
+            consoleIsError = false;
+        }
+        consoleBatch += line;
+        fileBatch += line;
+    }
+    
+    writeConsole();
+    if (!fileBatch.empty() && logFile.is_open()) {
+        logFile << fileBatch;
+        logFile.flush();
+    }
 }
 
 void Logger::flush() {
     std::lock_guard<std::mutex> lock(logMutex);
+    drainLocked();
     if (logFile.is_open()) {
         logFile.flush();
     }
 }
 
 void Logger::shutdown() {
+    if (running.exchange(false)) {
+        wakeWriter();
+        writerThread.join();
+    }
+    
     std::lock_guard<std::mutex> lock(logMutex);
     
-    if (initialized && logFile.is_open()) {
-        logFile << "\n[" << getTimestamp() << "] [INFO] Logger shutting down" << std::endl;
-        logFile << "========================================\n" << std::endl;
-        logFile.close();
+    if (initialized) {
+        drainLocked();
+        if (logFile.is_open()) {
+            logFile << "\n[" << getTimestamp() << "] [INFO] Logger shutting down" << std::endl;
+            logFile << "========================================\n" << std::endl;
+            logFile.close();
+        }
         initialized = false;
     }
 }
+
+void Logger::installCrashHandler() {
+    static bool installed = false;
+    if (installed) {
+        return;
+    }
+    installed = true;
+    
+    for (int signal : CRASH_SIGNALS) {
+        std::signal(signal, &Logger::handleCrash);
+    }
+    
+    // Uncaught exceptions: write what is queued, then abort as usual
+    std::set_terminate([]() {
+        getInstance().flush();
+        std::abort();
+    });
+}
+
+void Logger::handleCrash(int signal) {
+    // Best effort: the process is going down, so formatting and file I/O
+    // are fair game here even though they are not async-signal-safe. The
+    // writer thread may be mid-batch; give it a moment to finish.
+    Logger& logger = getInstance();
+    bool locked = false;
+    for (int attempt = 0; attempt < 100 && !locked; ++attempt) {
+        locked = logger.logMutex.try_lock();
+        if (!locked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    
+    if (locked) {
+        logger.drainLocked();
+        if (logger.logFile.is_open()) {
+            logger.logFile << "[" << getTimestamp() << "] [FATAL] Crashed (signal " << signal << ")" << std::endl;
+        }
+        logger.logMutex.unlock();
+    }
+    std::cerr << "Crashed (signal " << signal << "), see the log for details" << std::endl;
+    
+    // Die the way the signal would have killed us
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
@@ -0,0 +1,652 @@
+#include "world/ChunkMeshCache.h"
+#include "world/World.h"
+#include "world/Tile.h"
+#include "world/LightMap.h"
+#include "rendering/Renderer.h"
+#include "rendering/IsometricRenderer.h"
+#include "rendering/TextureManager.h"
+#include "rendering/DrawList.h"
+#include "rendering/DebugDraw.h"
+#include "engine/JobSystem.h"
+#include "engine/Profiler.h"
+#include "utils/IsometricUtils.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <string>
+
+ChunkMeshCache::ChunkMeshCache(const World* world, TextureManager* textureManager)
+    : world(world)
+    , textureManager(textureManager)
+    , jobSystem(nullptr)
+    , backend(nullptr)
+    , chunksX((world->getWidth() + World::CHUNK_SIZE - 1) / World::CHUNK_SIZE)
+    , chunksY((world->getHeight() + World::CHUNK_SIZE - 1) / World::CHUNK_SIZE)
+    , builtTileWidth(0)
+    , builtTileHeight(0)
+    , lastVisibleChunks(0)
+    , lastRebuiltChunks(0)
+    , residencyChanges(0)
+    , impostorsEnabled(true)
+    , impostorBytes(0)
+    , frame(0)
+    , lastImpostorChunks(0)
+    , lastImpostorRenders(0)
+{
+    chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+    for (Chunk& chunk : chunks) {
+        chunk.boundsMin = glm::vec2(0.0f);
+        chunk.boundsMax = glm::vec2(0.0f);
+        chunk.dirty = true;
+        chunk.impostor = RenderBackend::INVALID_TARGET;
+        chunk.impostorWidth = 0;
+        chunk.impostorDirty = true;
+        chunk.impostorFrame = 0;
+    }
+}
+
+ChunkMeshCache::~ChunkMeshCache() {
+    releaseGeometry();
+}
+
+void ChunkMeshCache::markTileDirty(int x, int y) {
+    if (!world->isValidPosition(x, y)) {
+        return;
+    }
+    chunks[static_cast<size_t>(y / World::CHUNK_SIZE) * chunksX + x / World::CHUNK_SIZE].dirty = true;
+}
+
+void ChunkMeshCache::markAllDirty() {
+    for (Chunk& chunk : chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void ChunkMeshCache::releaseGeometry() {
+    releaseImpostors();
+    for (Chunk& chunk : chunks) {
+        for (Batch& batch : chunk.ground) {
+            if (backend && batch.geometry != RenderBackend::INVALID_GEOMETRY) {
+                backend->destroyStaticGeometry(batch.geometry);
+            }
+        }
+        chunk.ground.clear();
+        chunk.dirty = true;
+    }
+    backend = nullptr;
+}
+
+void ChunkMeshCache::checkTextureResidency() {
+    if (!textureManager || textureManager->getResidencyChanges() == residencyChanges) {
+        return;
+    }
+    residencyChanges = textureManager->getResidencyChanges();
+    
+    for (Chunk& chunk : chunks) {
+        if (chunk.dirty) {
+            continue;
+        }
+        for (const Batch& batch : chunk.ground) {
+            for (const Texture* texture : batch.textures) {
+                chunk.dirty = chunk.dirty || !texture->isResident();
+            }
+        }
+        for (const Texture* texture : chunk.missingGround) {
+            chunk.dirty = chunk.dirty || texture->isResident();
+        }
+    }
+}
+
+void ChunkMeshCache::setImpostorsEnabled(bool enabled) {
+    impostorsEnabled = enabled;
+    if (!enabled) {
+        releaseImpostors();
+    }
+}
+
+void ChunkMeshCache::releaseImpostors() {
+    if (!backend) {
+        return;
+    }
+    for (Chunk& chunk : chunks) {
+        if (chunk.impostor != RenderBackend::INVALID_TARGET) {
+            backend->destroyRenderTarget(chunk.impostor);
+            chunk.impostor = RenderBackend::INVALID_TARGET;
+        }
+        chunk.impostorDirty = true;
+    }
+    for (const auto& free : freeImpostors) {
+        backend->destroyRenderTarget(free.second);
+    }
+    freeImpostors.clear();
+    impostorBytes = 0;
+}
+
+int ChunkMeshCache::getImpostorHeight(int width) const {
+    // A chunk spans CHUNK_SIZE tiles both ways, so it has the tile's aspect
+    return std::max(1, width * builtTileHeight / std::max(1, builtTileWidth));
+}
+
+size_t ChunkMeshCache::getImpostorBytes(int width) const {
+    return static_cast<size_t>(width) * getImpostorHeight(width) * 4;
+}
+
+void ChunkMeshCache::render(Renderer* renderer, IsometricRenderer* isoRenderer, DrawList* drawList, LightMap* lightMap) {
+    PROFILE_SCOPE("ChunkMeshCache::render");
+    lastVisibleChunks = 0;
+    lastRebuiltChunks = 0;
+    lastImpostorChunks = 0;
+    lastImpostorRenders = 0;
+    if (!renderer || !isoRenderer || chunks.empty()) {
+        return;
+    }
+    
+    // Geometry belongs to one backend; anything else means starting over
+    if (backend != renderer->getBackend()) {
+        releaseGeometry();
+        backend = renderer->getBackend();
+    }
+    
+    const int tileWidth = isoRenderer->getTileWidth();
+    const int tileHeight = isoRenderer->getTileHeight();
+    if (tileWidth != builtTileWidth || tileHeight != builtTileHeight) {
+        builtTileWidth = tileWidth;
+        builtTileHeight = tileHeight;
+        markAllDirty();
+        releaseImpostors(); // Sized for the old tile aspect
+    }
+    checkTextureResidency();
+    
+    glm::vec2 viewMin(0.0f);
+    glm::vec2 viewMax(0.0f);
+    renderer->getVisibleBounds(viewMin, viewMax);
+    const float pixelsPerUnit = renderer->getPixelsPerUnit();
+    
+    // Ground overlaps only in transparent corners, so chunk order is free
+    std::vector<int> visible;
+    std::vector<int> rebuild;
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            int index = cy * chunksX + cx;
+            Chunk& chunk = chunks[index];
+            
+            if (chunk.dirty) {
+                // Bounds are cheap and only depend on the tile size
+                int x0 = cx * World::CHUNK_SIZE;
+                int y0 = cy * World::CHUNK_SIZE;
+                int x1 = std::min(x0 + World::CHUNK_SIZE, world->getWidth()) - 1;
+                int y1 = std::min(y0 + World::CHUNK_SIZE, world->getHeight()) - 1;
+                glm::vec2 left = IsometricUtils::worldToScreen(x0, y1, tileWidth, tileHeight);
+                glm::vec2 right = IsometricUtils::worldToScreen(x1, y0, tileWidth, tileHeight);
+                glm::vec2 bottom = IsometricUtils::worldToScreen(x0, y0, tileWidth, tileHeight);
+                glm::vec2 top = IsometricUtils::worldToScreen(x1, y1, tileWidth, tileHeight);
+                chunk.boundsMin = glm::vec2(left.x, bottom.y);
+                chunk.boundsMax = glm::vec2(right.x + tileWidth, top.y + tileHeight);
+            }
+            
+            if (chunk.boundsMax.x < viewMin.x || chunk.boundsMin.x > viewMax.x ||
+                chunk.boundsMax.y < viewMin.y || chunk.boundsMin.y > viewMax.y) {
+                continue; // Off screen; dirty chunks wait until they are seen
+            }
+            
+            visible.push_back(index);
+            if (chunk.dirty) {
+                rebuild.push_back(index);
+            }
+        }
+    }
+    
+    // Build vertices on workers (tiles are only read), upload here
+    if (!rebuild.empty()) {
+        if (jobSystem && rebuild.size() > 1) {
+            jobSystem->parallelFor(0, rebuild.size(), 1, [&](size_t i) {
+                buildChunk(rebuild[i], tileWidth, tileHeight);
+            });
+        } else {
+            for (int index : rebuild) {
+                buildChunk(index, tileWidth, tileHeight);
+            }
+        }
+        
+        for (int index : rebuild) {
+            uploadChunk(chunks[index]);
+        }
+    }
+    
+    // Drawing is what brings evicted textures back; the tile colors stand
+    // in for them, so ask for them here
+    for (int index : visible) {
+        for (const Texture* texture : chunks[index].missingGround) {
+            texture->markUsed();
+        }
+    }
+    
+    // Level of detail from the chunk's on-screen width (0 = full detail only)
+    float impostorBlend = 0.0f;
+    int impostorWidth = IMPOSTOR_MIN_WIDTH;
+    if (impostorsEnabled && pixelsPerUnit > 0.0f && backend->supportsRenderTargets()) {
+        float chunkWidth = World::CHUNK_SIZE * tileWidth * pixelsPerUnit;
+        impostorBlend = glm::clamp((IMPOSTOR_FADE_END - chunkWidth) / (IMPOSTOR_FADE_END - IMPOSTOR_FADE_START), 0.0f, 1.0f);
+        while (impostorWidth < IMPOSTOR_MAX_WIDTH && impostorWidth < chunkWidth) {
+            impostorWidth *= 2;
+        }
+    }
+    
+    // Impostors of visible chunks: render missing and stale ones first,
+    // then those at another resolution (still drawn until replaced).
+    // Chunks without a current impostor are drawn in full detail.
+    frame++;
+    std::vector<int> impostors;
+    int impostorRenders = 0;
+    if (impostorBlend > 0.0f) {
+        // Claim the impostors in view first, so recycling only takes unseen ones
+        for (int index : visible) {
+            if (chunks[index].impostor != RenderBackend::INVALID_TARGET) {
+                chunks[index].impostorFrame = frame;
+            }
+        }
+        for (int pass = 0; pass < 2 && impostorRenders < MAX_IMPOSTOR_RENDERS; ++pass) {
+            for (int index : visible) {
+                Chunk& chunk = chunks[index];
+                bool missing = chunk.impostor == RenderBackend::INVALID_TARGET || chunk.impostorDirty;
+                bool resize = !missing && chunk.impostorWidth != impostorWidth;
+                if ((pass == 0 ? missing : resize) && impostorRenders < MAX_IMPOSTOR_RENDERS &&
+                    renderImpostor(renderer, chunk, impostorWidth)) {
+                    impostorRenders++;
+                }
+            }
+        }
+        for (int index : visible) {
+            Chunk& chunk = chunks[index];
+            if (chunk.impostor != RenderBackend::INVALID_TARGET && !chunk.impostorDirty) {
+                chunk.impostorFrame = frame;
+                impostors.push_back(index);
+            }
+        }
+    }
+
+#if DEBUG_DRAW_ENABLED
+    // Chunk bounds: yellow if rebuilt this frame, blue if drawn as an
+    // impostor, green otherwise (index lists are ascending)
+    if (DEBUG_DRAW_ON(Chunks)) {
+        for (int index : visible) {
+            glm::ivec2 first(index % chunksX * World::CHUNK_SIZE, index / chunksX * World::CHUNK_SIZE);
+            glm::ivec2 last(std::min(first.x + World::CHUNK_SIZE, world->getWidth()) - 1,
+                            std::min(first.y + World::CHUNK_SIZE, world->getHeight()) - 1);
+            glm::vec4 color(0.3f, 1.0f, 0.3f, 0.8f);
+            if (std::binary_search(rebuild.begin(), rebuild.end(), index)) {
+                color = glm::vec4(1.0f, 0.9f, 0.2f, 0.9f);
+            } else if (std::binary_search(impostors.begin(), impostors.end(), index)) {
+                color = glm::vec4(0.3f, 0.6f, 1.0f, 0.8f);
+            }
+            DEBUG_DRAW_TILES(Chunks, first, last, color);
+        }
+    }
+#endif
+    
+    // Decorations too small to make out are left out (unknown scale keeps them)
+    const glm::vec2 tileSize(tileWidth, tileHeight);
+    const bool drawDecorations = drawList && (pixelsPerUnit <= 0.0f || tileWidth * pixelsPerUnit >= MIN_DECORATION_PIXELS);
+    size_t nextImpostor = 0;
+    for (int index : visible) {
+        const Chunk& chunk = chunks[index];
+        
+        // Both lists are in visible order
+        bool hasImpostor = nextImpostor < impostors.size() && impostors[nextImpostor] == index;
+        if (hasImpostor) {
+            nextImpostor++;
+            if (impostorBlend >= 1.0f) {
+                continue;
+            }
+        }
+        
+        for (const Batch& batch : chunk.ground) {
+            renderer->drawStaticGeometry(
+                batch.geometry,
+                batch.textures.data(),
+                static_cast<int>(batch.textures.size())
+            );
+        }
+        
+        if (drawDecorations) {
+            for (const Decoration& decoration : chunk.decorations) {
+                // Chunks at the screen edge are partly out of view
+                if (decoration.position.x + tileSize.x < viewMin.x || decoration.position.x > viewMax.x ||
+                    decoration.position.y + tileSize.y < viewMin.y || decoration.position.y > viewMax.y) {
+                    continue;
+                }
+                glm::vec4 light = lightMap ? glm::vec4(lightMap->getColor(decoration.tile.x, decoration.tile.y), 1.0f) : glm::vec4(1.0f);
+                drawList->add(DrawList::Layer::Objects, decoration.depth, decoration.position, tileSize, decoration.texture, light);
+            }
+        }
+    }
+    
+    // Impostors over the ground, back to front (larger x + y is further back)
+    if (!impostors.empty()) {
+        std::sort(impostors.begin(), impostors.end(), [this](int a, int b) {
+            return a % chunksX + a / chunksX > b % chunksX + b / chunksX;
+        });
+        
+        // Targets hold premultiplied color; fading scales all four channels
+        backend->setBlendMode(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        for (int index : impostors) {
+            const Chunk& chunk = chunks[index];
+            renderer->drawQuad(chunk.boundsMin, chunk.boundsMax - chunk.boundsMin,
+                               backend->getRenderTargetTexture(chunk.impostor), glm::vec4(impostorBlend));
+        }
+        backend->setBlendMode(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    
+    // Nothing to darken in full daylight
+    if (lightMap && !lightMap->isFullyLit() && !visible.empty()) {
+        renderLight(renderer, *lightMap, visible);
+    }
+    
+    lastVisibleChunks = static_cast<int>(visible.size());
+    lastRebuiltChunks = static_cast<int>(rebuild.size());
+    lastImpostorChunks = static_cast<int>(impostors.size());
+    lastImpostorRenders = impostorRenders;
+}
+
+void ChunkMeshCache::renderLight(Renderer* renderer, LightMap& lightMap, const std::vector<int>& visible) {
+    std::vector<QuadVertex> vertices;
+    std::vector<const Texture*> textures;
+    vertices.reserve(visible.size() * 4);
+    auto flush = [&]() {
+        renderer->drawQuads(vertices.data(), vertices.size() / 4, textures.data(), static_cast<int>(textures.size()));
+        vertices.clear();
+        textures.clear();
+    };
+    
+    // Grid corner (x, y) is the top vertex of tile (x, y)'s diamond; the
+    // chunk's tile n is texel 1 + n of its light texture
+    const glm::vec2 tileTop(builtTileWidth * 0.5f, 0.0f);
+    const float textureSize = static_cast<float>(lightMap.getTextureSize());
+    
+    backend->setBlendMode(GL_DST_COLOR, GL_ZERO);
+    for (int index : visible) {
+        const int cx = index % chunksX;
+        const int cy = index / chunksX;
+        const Texture* texture = lightMap.getChunkTexture(cx, cy);
+        if (!texture) {
+            continue;
+        }
+        if (textures.size() == RenderBackend::MAX_TEXTURE_SLOTS) {
+            flush();
+        }
+        
+        // The chunk's diamond, in quad order: a parallelogram starting at
+        // grid corner (x0, y1), with vertex 3 at (x0, y0)
+        const int x0 = cx * World::CHUNK_SIZE;
+        const int y0 = cy * World::CHUNK_SIZE;
+        const int x1 = std::min(x0 + World::CHUNK_SIZE, world->getWidth());
+        const int y1 = std::min(y0 + World::CHUNK_SIZE, world->getHeight());
+        const glm::ivec2 corners[4] = { glm::ivec2(x0, y1), glm::ivec2(x1, y1), glm::ivec2(x1, y0), glm::ivec2(x0, y0) };
+        for (const glm::ivec2& corner : corners) {
+            QuadVertex vertex;
+            vertex.position = glm::vec3(IsometricUtils::worldToScreen(corner.x, corner.y, builtTileWidth, builtTileHeight) + tileTop, 0.0f);
+            vertex.color = glm::vec4(1.0f);
+            vertex.texCoord = glm::vec2(corner.x - x0 + 1, corner.y - y0 + 1) / textureSize;
+            vertex.texIndex = static_cast<float>(textures.size());
+            vertices.push_back(vertex);
+        }
+        textures.push_back(texture);
+    }
+    if (!textures.empty()) {
+        flush();
+    }
+    backend->setBlendMode(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+bool ChunkMeshCache::renderImpostor(Renderer* renderer, Chunk& chunk, int width) {
+    // Baking in a missing texture would keep it missing until the chunk changes
+    for (const Batch& batch : chunk.ground) {
+        for (const Texture* texture : batch.textures) {
+            if (!texture->isResident()) {
+                return false;
+            }
+        }
+    }
+    for (const Decoration& decoration : chunk.decorations) {
+        if (!decoration.texture->isResident()) {
+            return false;
+        }
+    }
+    
+    // Keep the old target until the new one is secured
+    if (chunk.impostor == RenderBackend::INVALID_TARGET || chunk.impostorWidth != width) {
+        RenderBackend::RenderTargetHandle target = acquireImpostor(width);
+        if (target == RenderBackend::INVALID_TARGET) {
+            return false;
+        }
+        if (chunk.impostor != RenderBackend::INVALID_TARGET) {
+            freeImpostors.emplace_back(chunk.impostorWidth, chunk.impostor);
+        }
+        chunk.impostor = target;
+        chunk.impostorWidth = width;
+    }
+    
+    const glm::mat4 view = renderer->getViewMatrix();
+    const glm::mat4 projection = renderer->getProjectionMatrix();
+    
+    // The chunk's bounds fill the target; the frame may itself be drawn
+    // into one (dynamic resolution), so return to whatever was bound
+    const RenderBackend::RenderTargetHandle previousTarget = backend->getRenderTarget();
+    backend->setRenderTarget(chunk.impostor);
+    renderer->clear(0.0f, 0.0f, 0.0f, 0.0f);
+    renderer->setViewMatrix(glm::mat4(1.0f));
+    renderer->setProjectionMatrix(glm::ortho(chunk.boundsMin.x, chunk.boundsMax.x,
+                                             chunk.boundsMin.y, chunk.boundsMax.y, -1.0f, 1.0f));
+    
+    for (const Batch& batch : chunk.ground) {
+        renderer->drawStaticGeometry(batch.geometry, batch.textures.data(), static_cast<int>(batch.textures.size()));
+    }
+    
+    // Decorations back to front, batched like the ground
+    std::vector<const Decoration*> sorted;
+    sorted.reserve(chunk.decorations.size());
+    for (const Decoration& decoration : chunk.decorations) {
+        sorted.push_back(&decoration);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Decoration* a, const Decoration* b) {
+        return a->depth < b->depth;
+    });
+    std::vector<BuildBatch> batches;
+    const glm::vec2 tileSize(builtTileWidth, builtTileHeight);
+    for (const Decoration* decoration : sorted) {
+        appendQuad(batches, decoration->position, tileSize, decoration->texture, glm::vec4(1.0f));
+    }
+    for (const BuildBatch& batch : batches) {
+        renderer->drawQuads(batch.vertices.data(), batch.vertices.size() / 4,
+                            batch.textures.data(), static_cast<int>(batch.textures.size()));
+    }
+    
+    backend->setRenderTarget(previousTarget);
+    renderer->setViewMatrix(view);
+    renderer->setProjectionMatrix(projection);
+    
+    chunk.impostorDirty = false;
+    return true;
+}
+
+RenderBackend::RenderTargetHandle ChunkMeshCache::acquireImpostor(int width) {
+    for (size_t i = 0; i < freeImpostors.size(); ++i) {
+        if (freeImpostors[i].first == width) {
+            RenderBackend::RenderTargetHandle target = freeImpostors[i].second;
+            freeImpostors.erase(freeImpostors.begin() + i);
+            return target;
+        }
+    }
+    
+    // Make room: free targets of other sizes first, then the least recently
+    // drawn impostors out of view (taken over directly when the size fits)
+    const size_t bytes = getImpostorBytes(width);
+    while (impostorBytes + bytes > MAX_IMPOSTOR_BYTES) {
+        if (!freeImpostors.empty()) {
+            backend->destroyRenderTarget(freeImpostors.back().second);
+            impostorBytes -= getImpostorBytes(freeImpostors.back().first);
+            freeImpostors.pop_back();
+            continue;
+        }
+        
+        Chunk* oldest = nullptr;
+        for (Chunk& chunk : chunks) {
+            if (chunk.impostor != RenderBackend::INVALID_TARGET && chunk.impostorFrame < frame &&
+                (!oldest || chunk.impostorFrame < oldest->impostorFrame)) {
+                oldest = &chunk;
+            }
+        }
+        if (!oldest) {
+            return RenderBackend::INVALID_TARGET;
+        }
+        
+        RenderBackend::RenderTargetHandle target = oldest->impostor;
+        oldest->impostor = RenderBackend::INVALID_TARGET;
+        oldest->impostorDirty = true;
+        if (oldest->impostorWidth == width) {
+            return target;
+        }
+        backend->destroyRenderTarget(target);
+        impostorBytes -= getImpostorBytes(oldest->impostorWidth);
+    }
+    
+    RenderBackend::RenderTargetHandle target = backend->createRenderTarget(width, getImpostorHeight(width));
+    if (target != RenderBackend::INVALID_TARGET) {
+        impostorBytes += bytes;
+    }
+    return target;
+}
+
+void ChunkMeshCache::buildChunk(int index, int tileWidth, int tileHeight) {
+    PROFILE_SCOPE("ChunkMeshCache::buildChunk");
+    Chunk& chunk = chunks[index];
+    const int x0 = (index % chunksX) * World::CHUNK_SIZE;
+    const int y0 = (index / chunksX) * World::CHUNK_SIZE;
+    const int x1 = std::min(x0 + World::CHUNK_SIZE, world->getWidth());
+    const int y1 = std::min(y0 + World::CHUNK_SIZE, world->getHeight());
+    const glm::vec2 size(tileWidth, tileHeight);
+    
+    chunk.pendingGround.clear();
+    chunk.decorations.clear();
+    chunk.missingGround.clear();
+    
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const Tile* tile = world->getTile(x, y);
+            if (!tile) {
+                continue;
+            }
+            
+            glm::vec2 position = IsometricUtils::worldToScreen(x, y, tileWidth, tileHeight);
+            
+            // Ground: texture, or the tile color when textures are unavailable
+            // or evicted
+            const Texture* groundTexture = getGroundTexture(*tile);
+            if (groundTexture && !groundTexture->isResident()) {
+                if (std::find(chunk.missingGround.begin(), chunk.missingGround.end(), groundTexture) ==
+                    chunk.missingGround.end()) {
+                    chunk.missingGround.push_back(groundTexture);
+                }
+                groundTexture = nullptr;
+            }
+            appendQuad(chunk.pendingGround, position, size, groundTexture,
+                       groundTexture ? glm::vec4(1.0f) : tile->getColor());
+            
+            // Decoration drawn over the tile footprint, sorted at its center
+            if (tile->hasDecoration() && textureManager) {
+                const Texture* decorTexture = textureManager->getTexture(tile->getDecoration());
+                if (decorTexture) {
+                    Decoration decoration;
+                    decoration.position = position;
+                    decoration.tile = glm::ivec2(x, y);
+                    decoration.depth = IsometricUtils::getRenderOrder(x + 0.5f, y + 0.5f);
+                    decoration.texture = decorTexture;
+                    chunk.decorations.push_back(decoration);
+                }
+            }
+        }
+    }
+}
+
+void ChunkMeshCache::uploadChunk(Chunk& chunk) {
+    std::vector<Batch>& batches = chunk.ground;
+    std::vector<BuildBatch>& pending = chunk.pendingGround;
+    
+    // Reuse existing geometry where possible, destroy what is left over
+    for (size_t i = pending.size(); i < batches.size(); ++i) {
+        backend->destroyStaticGeometry(batches[i].geometry);
+    }
+    batches.resize(pending.size(), Batch{ RenderBackend::INVALID_GEOMETRY, {} });
+    
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const QuadVertex* vertices = pending[i].vertices.data();
+        size_t quadCount = pending[i].vertices.size() / 4;
+        
+        Batch& batch = batches[i];
+        if (batch.geometry == RenderBackend::INVALID_GEOMETRY ||
+            !backend->updateStaticGeometry(batch.geometry, vertices, quadCount)) {
+            batch.geometry = backend->createStaticGeometry(vertices, quadCount);
+        }
+        batch.textures = std::move(pending[i].textures);
+    }
+    
+    // Vertices now live in the backend
+    pending.clear();
+    chunk.dirty = false;
+    chunk.impostorDirty = true;
+}
+
+const Texture* ChunkMeshCache::getGroundTexture(const Tile& tile) const {
+    if (!textureManager) {
+        return nullptr;
+    }
+    
+    // Map tile types to asset names with variations
+    std::string baseName;
+    if (tile.getType() == TileType::GRASS) {
+        baseName = "grass_green";
+    } else if (tile.getType() == TileType::SAND) {
+        baseName = "sand";
+    } else if (tile.getType() == TileType::DIRT) {
+        baseName = "dirt";
+    } else if (tile.getType() == TileType::STONE) {
+        baseName = "stone_path";
+    }
+    
+    // Use the tile's variation index for visual diversity
+    if (baseName.empty()) {
+        return nullptr;
+    }
+    return textureManager->getTileVariation(baseName, tile.getVariation());
+}
+
+void ChunkMeshCache::appendQuad(
+    std::vector<BuildBatch>& batches,
+    const glm::vec2& position,
+    const glm::vec2& size,
+    const Texture* texture,
+    const glm::vec4& color)
+{
+    if (batches.empty()) {
+        batches.emplace_back();
+    }
+    
+    float texIndex = -1.0f;
+    if (texture) {
+        BuildBatch* batch = &batches.back();
+        auto it = std::find(batch->textures.begin(), batch->textures.end(), texture);
+        if (it == batch->textures.end()) {
+            if (static_cast<int>(batch->textures.size()) == RenderBackend::MAX_TEXTURE_SLOTS) {
+                batches.emplace_back();
+                batch = &batches.back();
+            }
+            batch->textures.push_back(texture);
+            it = batch->textures.end() - 1;
+        }
+        texIndex = static_cast<float>(it - batch->textures.begin());
+    }
+    
+    BuildBatch& batch = batches.back();
+    size_t first = batch.vertices.size();
+    batch.vertices.resize(first + 4);
+    Renderer::buildQuadVertices(&batch.vertices[first], position, size, color, texIndex);
+}
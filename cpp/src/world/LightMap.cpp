@@ -0,0 +1,296 @@
+#include "world/LightMap.h"
+#include "rendering/Texture.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    
+    // Open ground on a moonlit night
+    const glm::vec3 NIGHT_AMBIENT(0.16f, 0.2f, 0.36f);
+    
+    // Lamp light at MAX_LIGHT; warm, and dimming linearly with the level
+    const glm::vec3 LAMP_COLOR(1.0f, 0.86f, 0.6f);
+    
+    // Distinct daylight values
+    constexpr float DAYLIGHT_STEPS = 32.0f;
+    
+} // namespace
+
+LightMap::LightMap(int width, int height, int chunkSize)
+    : width(width)
+    , height(height)
+    , chunkSize(chunkSize)
+    , chunksX((width + chunkSize - 1) / chunkSize)
+    , chunksY((height + chunkSize - 1) / chunkSize)
+    , daylight(1.0f)
+    , lastUpdateTiles(0)
+    , composeCount(0)
+{
+    const size_t tileCount = static_cast<size_t>(width) * height;
+    levels.assign(tileCount, 0);
+    emitters.assign(tileCount, 0);
+    opaque.assign(tileCount, 0);
+    
+    chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+    for (Chunk& chunk : chunks) {
+        chunk.dirty = true;
+    }
+    
+    updatePalette();
+}
+
+LightMap::~LightMap() {
+}
+
+void LightMap::setEmitter(int x, int y, int level) {
+    if (!isValid(x, y)) {
+        return;
+    }
+    
+    const int index = y * width + x;
+    level = std::clamp(level, 0, MAX_LIGHT);
+    const int previous = emitters[index];
+    if (level == previous) {
+        return;
+    }
+    
+    emitters[index] = static_cast<uint8_t>(level);
+    lastUpdateTiles = 0;
+    if (level > levels[index]) {
+        setLevel(index, level);
+        addQueue.push_back(index);
+    } else if (level < previous) {
+        // The old light may be what lights the area: retract, then refill
+        removeLight(index);
+    }
+    spreadLight();
+}
+
+int LightMap::getEmitter(int x, int y) const {
+    return isValid(x, y) ? emitters[y * width + x] : 0;
+}
+
+void LightMap::setOpaque(int x, int y, bool isOpaque) {
+    if (!isValid(x, y)) {
+        return;
+    }
+    
+    const int index = y * width + x;
+    if ((opaque[index] != 0) == isOpaque) {
+        return;
+    }
+    
+    opaque[index] = isOpaque ? 1 : 0;
+    lastUpdateTiles = 0;
+    if (isOpaque) {
+        // Cut off the light passing through (an emitter keeps its own)
+        if (levels[index] > 0) {
+            removeLight(index);
+        }
+    } else {
+        // Light around the opened tile flows in
+        int around[4];
+        int count = getNeighbours(index, around);
+        for (int i = 0; i < count; ++i) {
+            if (levels[around[i]] > 1) {
+                addQueue.push_back(around[i]);
+            }
+        }
+    }
+    spreadLight();
+}
+
+bool LightMap::isOpaque(int x, int y) const {
+    return isValid(x, y) && opaque[y * width + x] != 0;
+}
+
+int LightMap::getLevel(int x, int y) const {
+    return isValid(x, y) ? levels[y * width + x] : 0;
+}
+
+void LightMap::setDaylight(float value) {
+    float quantized = std::round(std::clamp(value, 0.0f, 1.0f) * DAYLIGHT_STEPS) / DAYLIGHT_STEPS;
+    if (quantized == daylight) {
+        return;
+    }
+    
+    // Same levels, new colors: recompose, nothing propagates
+    daylight = quantized;
+    updatePalette();
+    for (Chunk& chunk : chunks) {
+        chunk.dirty = true;
+    }
+}
+
+glm::vec3 LightMap::getColor(int x, int y) const {
+    if (!isValid(x, y)) {
+        return palette[0];
+    }
+    
+    const int index = y * width + x;
+    int level = levels[index];
+    if (opaque[index]) {
+        int around[4];
+        int count = getNeighbours(index, around);
+        for (int i = 0; i < count; ++i) {
+            level = std::max(level, static_cast<int>(levels[around[i]]));
+        }
+    }
+    return palette[level];
+}
+
+const Texture* LightMap::getChunkTexture(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkX >= chunksX || chunkY < 0 || chunkY >= chunksY) {
+        return nullptr;
+    }
+    
+    Chunk& chunk = chunks[static_cast<size_t>(chunkY) * chunksX + chunkX];
+    if (chunk.texture && !chunk.dirty) {
+        return chunk.texture.get();
+    }
+    
+    composeChunk(chunkX, chunkY);
+    const int size = getTextureSize();
+    if (!chunk.texture || !chunk.texture->update(composeBuffer.data())) {
+        chunk.texture = std::make_unique<Texture>();
+        chunk.texture->loadFromMemory(composeBuffer.data(), size, size, 4);
+        // The border texels already hold the neighbours
+        chunk.texture->setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    }
+    chunk.dirty = false;
+    return chunk.texture.get();
+}
+
+void LightMap::releaseTextures() {
+    for (Chunk& chunk : chunks) {
+        chunk.texture.reset();
+        chunk.dirty = true;
+    }
+}
+
+int LightMap::getNeighbours(int index, int out[4]) const {
+    const int x = index % width;
+    const int y = index / width;
+    int count = 0;
+    if (x > 0) {
+        out[count++] = index - 1;
+    }
+    if (x + 1 < width) {
+        out[count++] = index + 1;
+    }
+    if (y > 0) {
+        out[count++] = index - width;
+    }
+    if (y + 1 < height) {
+        out[count++] = index + width;
+    }
+    return count;
+}
+
+void LightMap::setLevel(int index, int level) {
+    levels[index] = static_cast<uint8_t>(level);
+    
+    // The tile shows in its own chunk and in the border of those next to it
+    const int x = index % width;
+    const int y = index / width;
+    const int firstX = std::max(x - 1, 0) / chunkSize;
+    const int lastX = std::min(x + 1, width - 1) / chunkSize;
+    const int firstY = std::max(y - 1, 0) / chunkSize;
+    const int lastY = std::min(y + 1, height - 1) / chunkSize;
+    for (int cy = firstY; cy <= lastY; ++cy) {
+        for (int cx = firstX; cx <= lastX; ++cx) {
+            chunks[static_cast<size_t>(cy) * chunksX + cx].dirty = true;
+        }
+    }
+}
+
+void LightMap::removeLight(int start) {
+    removeQueue.clear();
+    removeQueue.emplace_back(start, levels[start]);
+    setLevel(start, 0);
+    
+    for (size_t head = 0; head < removeQueue.size(); ++head) {
+        const int index = removeQueue[head].first;
+        const int level = removeQueue[head].second;
+        lastUpdateTiles++;
+        
+        int around[4];
+        int count = getNeighbours(index, around);
+        for (int i = 0; i < count; ++i) {
+            const int neighbour = around[i];
+            const int neighbourLevel = levels[neighbour];
+            if (neighbourLevel == 0) {
+                continue;
+            }
+            if (neighbourLevel < level) {
+                // Lit through this tile (or too dim to tell): dark for now
+                removeQueue.emplace_back(neighbour, static_cast<uint8_t>(neighbourLevel));
+                setLevel(neighbour, 0);
+            } else {
+                // Lit from elsewhere: spreads back into the hole
+                addQueue.push_back(neighbour);
+            }
+        }
+    }
+    
+    // Emitters inside the hole light themselves again
+    for (const auto& removed : removeQueue) {
+        const int index = removed.first;
+        if (emitters[index] > levels[index]) {
+            setLevel(index, emitters[index]);
+            addQueue.push_back(index);
+        }
+    }
+}
+
+void LightMap::spreadLight() {
+    for (size_t head = 0; head < addQueue.size(); ++head) {
+        const int index = addQueue[head];
+        const int level = levels[index];
+        lastUpdateTiles++;
+        if (level <= 1) {
+            continue;
+        }
+        
+        int around[4];
+        int count = getNeighbours(index, around);
+        for (int i = 0; i < count; ++i) {
+            const int neighbour = around[i];
+            if (!opaque[neighbour] && levels[neighbour] < level - 1) {
+                setLevel(neighbour, level - 1);
+                addQueue.push_back(neighbour);
+            }
+        }
+    }
+    addQueue.clear();
+}
+
+void LightMap::updatePalette() {
+    const glm::vec3 ambient = glm::mix(NIGHT_AMBIENT, glm::vec3(1.0f), daylight);
+    for (int level = 0; level <= MAX_LIGHT; ++level) {
+        palette[level] = glm::max(ambient, LAMP_COLOR * (static_cast<float>(level) / MAX_LIGHT));
+    }
+}
+
+void LightMap::composeChunk(int chunkX, int chunkY) {
+    const int size = getTextureSize();
+    const int firstX = chunkX * chunkSize - 1;
+    const int firstY = chunkY * chunkSize - 1;
+    composeBuffer.resize(static_cast<size_t>(size) * size * 4);
+    
+    // Rows bottom first, like the tiles: texel row j is tile row firstY + j.
+    // Outside the world the nearest tile repeats.
+    for (int j = 0; j < size; ++j) {
+        const int y = std::clamp(firstY + j, 0, height - 1);
+        for (int i = 0; i < size; ++i) {
+            const int x = std::clamp(firstX + i, 0, width - 1);
+            const glm::vec3& color = palette[levels[static_cast<size_t>(y) * width + x]];
+            unsigned char* texel = composeBuffer.data() + (static_cast<size_t>(j) * size + i) * 4;
+            texel[0] = static_cast<unsigned char>(color.x * 255.0f + 0.5f);
+            texel[1] = static_cast<unsigned char>(color.y * 255.0f + 0.5f);
+            texel[2] = static_cast<unsigned char>(color.z * 255.0f + 0.5f);
+            texel[3] = 255;
+        }
+    }
+    composeCount++;
+}
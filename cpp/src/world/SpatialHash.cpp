@@ -0,0 +1,279 @@
+#include "world/SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+SpatialHash::SpatialHash(float cellSize)
+    : cellSize(cellSize > 0.0f ? cellSize : DEFAULT_CELL_SIZE)
+    , inverseCellSize(0.0f)
+{
+    inverseCellSize = 1.0f / this->cellSize;
+}
+
+int SpatialHash::cellCoord(float value) const {
+    return static_cast<int>(std::floor(value * inverseCellSize));
+}
+
+int64_t SpatialHash::makeKey(int cellX, int cellY) {
+    // Pack both signed 32-bit cell coordinates into one 64-bit key
+    return (static_cast<int64_t>(cellX) << 32) | static_cast<int64_t>(static_cast<uint32_t>(cellY));
+}
+
+int64_t SpatialHash::keyFor(const glm::vec2& position) const {
+    return makeKey(cellCoord(position.x), cellCoord(position.y));
+}
+
+void SpatialHash::insert(Id id, const glm::vec2& position) {
+    if (contains(id)) {
+        update(id, position);
+        return;
+    }
+
+    int64_t key = keyFor(position);
+    std::vector<Entry>& bucket = cells[key];
+    locations[id] = Location{key, static_cast<uint32_t>(bucket.size())};
+    bucket.push_back(Entry{id, position});
+}
+
+bool SpatialHash::update(Id id, const glm::vec2& position) {
+    auto it = locations.find(id);
+    if (it == locations.end()) {
+        insert(id, position);
+        return true;
+    }
+
+    Location& location = it->second;
+    int64_t newKey = keyFor(position);
+
+    // Fast path: still in the same cell, just refresh the stored position
+    if (newKey == location.cellKey) {
+        cells[location.cellKey][location.index].position = position;
+        return false;
+    }
+
+    eraseFromCell(location.cellKey, location.index);
+
+    std::vector<Entry>& bucket = cells[newKey];
+    location.cellKey = newKey;
+    location.index = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(Entry{id, position});
+    return true;
+}
+
+bool SpatialHash::remove(Id id) {
+    auto it = locations.find(id);
+    if (it == locations.end()) {
+        return false;
+    }
+
+    Location location = it->second;
+    locations.erase(it);
+    eraseFromCell(location.cellKey, location.index);
+    return true;
+}
+
+void SpatialHash::clear() {
+    cells.clear();
+    locations.clear();
+}
+
+bool SpatialHash::contains(Id id) const {
+    return locations.find(id) != locations.end();
+}
+
+void SpatialHash::eraseFromCell(int64_t cellKey, uint32_t index) {
+    auto cellIt = cells.find(cellKey);
+    if (cellIt == cells.end()) {
+        return;
+    }
+
+    std::vector<Entry>& bucket = cellIt->second;
+    uint32_t last = static_cast<uint32_t>(bucket.size() - 1);
+    if (index != last) {
+        bucket[index] = bucket[last];
+        auto moved = locations.find(bucket[index].id);
+        if (moved != locations.end()) {
+            moved->second.index = index;
+        }
+    }
+    bucket.pop_back();
+
+    // Drop empty buckets so sparse worlds don't accumulate dead cells
+    if (bucket.empty()) {
+        cells.erase(cellIt);
+    }
+}
+
+template <typename Visitor>
+void SpatialHash::forEachInCells(const glm::vec2& min, const glm::vec2& max, Visitor&& visit) const {
+    int minX = cellCoord(min.x);
+    int minY = cellCoord(min.y);
+    int maxX = cellCoord(max.x);
+    int maxY = cellCoord(max.y);
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            auto it = cells.find(makeKey(cx, cy));
+            if (it == cells.end()) {
+                continue;
+            }
+            for (const Entry& entry : it->second) {
+                visit(entry);
+            }
+        }
+    }
+}
+
+void SpatialHash::queryRadius(const glm::vec2& center, float radius, std::vector<Id>& out) const {
+    const float radiusSq = radius * radius;
+    const glm::vec2 extent(radius, radius);
+
+    forEachInCells(center - extent, center + extent, [&](const Entry& entry) {
+        glm::vec2 d = entry.position - center;
+        if (d.x * d.x + d.y * d.y <= radiusSq) {
+            out.push_back(entry.id);
+        }
+    });
+}
+
+void SpatialHash::queryRect(const glm::vec2& min, const glm::vec2& max, std::vector<Id>& out) const {
+    forEachInCells(min, max, [&](const Entry& entry) {
+        if (entry.position.x >= min.x && entry.position.x <= max.x &&
+            entry.position.y >= min.y && entry.position.y <= max.y) {
+            out.push_back(entry.id);
+        }
+    });
+}
+
+void SpatialHash::queryNearest(const glm::vec2& center, size_t k, float maxRadius, std::vector<Id>& out) const {
+    if (k == 0 || locations.empty()) {
+        return;
+    }
+
+    const float maxRadiusSq = maxRadius * maxRadius;
+    const int originX = cellCoord(center.x);
+    const int originY = cellCoord(center.y);
+    const int maxRing = static_cast<int>(std::ceil(maxRadius * inverseCellSize)) + 1;
+
+    // (distance squared, id) candidates gathered ring by ring
+    std::vector<std::pair<float, Id>> candidates;
+
+    auto visitCell = [&](int cx, int cy) {
+        auto it = cells.find(makeKey(cx, cy));
+        if (it == cells.end()) {
+            return;
+        }
+        for (const Entry& entry : it->second) {
+            glm::vec2 d = entry.position - center;
+            float distSq = d.x * d.x + d.y * d.y;
+            if (distSq <= maxRadiusSq) {
+                candidates.emplace_back(distSq, entry.id);
+            }
+        }
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        if (ring == 0) {
+            visitCell(originX, originY);
+        } else {
+            // Walk the perimeter of the square ring
+            for (int i = -ring; i <= ring; ++i) {
+                visitCell(originX + i, originY - ring);
+                visitCell(originX + i, originY + ring);
+            }
+            for (int i = -ring + 1; i <= ring - 1; ++i) {
+                visitCell(originX - ring, originY + i);
+                visitCell(originX + ring, originY + i);
+            }
+        }
+
+        // Everything within ring * cellSize of the center has now been seen,
+        // so once the k-th best candidate is inside that distance we're done
+        if (candidates.size() >= k) {
+            std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+            float guaranteed = static_cast<float>(ring) * cellSize;
+            if (candidates[k - 1].first <= guaranteed * guaranteed) {
+                break;
+            }
+        }
+    }
+
+    size_t count = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(candidates[i].second);
+    }
+}
+
+void SpatialHash::queryRadiusBatch(
+    const std::vector<glm::vec2>& centers,
+    float radius,
+    std::vector<Id>& results,
+    std::vector<size_t>& offsets) const
+{
+    results.clear();
+    offsets.assign(centers.size() + 1, 0);
+    if (centers.empty()) {
+        return;
+    }
+
+    const float radiusSq = radius * radius;
+    const glm::vec2 extent(radius, radius);
+
+    // Group queriers by home cell so each group scans its buckets once
+    std::vector<std::pair<int64_t, uint32_t>> order;
+    order.reserve(centers.size());
+    for (size_t i = 0; i < centers.size(); ++i) {
+        order.emplace_back(keyFor(centers[i]), static_cast<uint32_t>(i));
+    }
+    std::sort(order.begin(), order.end());
+
+    // (querier index, hit id) pairs, scattered into CSR form afterwards
+    std::vector<std::pair<uint32_t, Id>> hits;
+    std::vector<Entry> candidates;
+
+    size_t groupStart = 0;
+    while (groupStart < order.size()) {
+        size_t groupEnd = groupStart;
+        glm::vec2 groupMin = centers[order[groupStart].second];
+        glm::vec2 groupMax = groupMin;
+        while (groupEnd < order.size() && order[groupEnd].first == order[groupStart].first) {
+            const glm::vec2& c = centers[order[groupEnd].second];
+            groupMin = glm::vec2(std::min(groupMin.x, c.x), std::min(groupMin.y, c.y));
+            groupMax = glm::vec2(std::max(groupMax.x, c.x), std::max(groupMax.y, c.y));
+            ++groupEnd;
+        }
+
+        candidates.clear();
+        forEachInCells(groupMin - extent, groupMax + extent, [&](const Entry& entry) {
+            candidates.push_back(entry);
+        });
+
+        for (size_t g = groupStart; g < groupEnd; ++g) {
+            uint32_t querier = order[g].second;
+            const glm::vec2& center = centers[querier];
+            for (const Entry& entry : candidates) {
+                glm::vec2 d = entry.position - center;
+                if (d.x * d.x + d.y * d.y <= radiusSq) {
+                    hits.emplace_back(querier, entry.id);
+                }
+            }
+        }
+
+        groupStart = groupEnd;
+    }
+
+    // Counting sort by querier index
+    for (const auto& hit : hits) {
+        offsets[hit.first + 1]++;
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    results.resize(hits.size());
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& hit : hits) {
+        results[cursor[hit.first]++] = hit.second;
+    }
+}
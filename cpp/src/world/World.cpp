@@ -5,7 +5,10 @@
 #include "rendering/Camera.h"
 #include "rendering/TextureManager.h"
 #include "utils/NoiseGenerator.h"
+#include "engine/JobSystem.h"
+#include "engine/Profiler.h"
 #include <iostream>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <sstream>
@@ -15,6 +18,9 @@ World::World(int width, int height, TextureManager* textureManager)
     , height(height)
     , textureManager(textureManager)
     , noiseGen(std::make_unique<NoiseGenerator>(static_cast<uint32_t>(std::time(nullptr))))
+    , jobSystem(nullptr)
+    , resourceIndex(static_cast<float>(CHUNK_SIZE))
+    , timeOfDay(0.35f)
 {
     // Initialize tiles
     tiles.resize(height);
@@ -24,12 +30,17 @@ World::World(int width, int height, TextureManager* textureManager)
             tiles[y][x] = std::make_unique<Tile>(x, y, TileType::GRASS);
         }
     }
+    
+    chunkMeshes = std::make_unique<ChunkMeshCache>(this, textureManager);
+    lightMap = std::make_unique<LightMap>(width, height, CHUNK_SIZE);
+    setTimeOfDay(timeOfDay);
 }
 
 World::~World() {
 }
 
 void World::generate() {
+    PROFILE_SCOPE("World::generate");
     // Seed random number generator
     std::srand(static_cast<unsigned>(std::time(nullptr)));
     
@@ -42,67 +53,48 @@ void World::generate() {
     // Generate decorations
     generateDecorations();
     
+    // Index gatherable resources for proximity queries
+    rebuildResourceIndex();
+    
+    // Every chunk's geometry is stale now
+    chunkMeshes->markAllDirty();
+    
     std::cout << "World generated: " << width << "x" << height << " tiles with biomes" << std::endl;
 }
 
 void World::update(float deltaTime) {
-    (void)deltaTime; // Unused - reserved for future weather/day-night cycle
-    // World update logic (future: weather, day/night cycle, etc.)
+    // Day/night cycle (only recolors the light map, see LightMap)
+    setTimeOfDay(timeOfDay + deltaTime / DAY_LENGTH);
 }
 
-void World::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera) {
-    (void)renderer; // Unused - using isoRenderer for rendering
-    (void)camera; // Unused - camera handled by renderer
+void World::setTimeOfDay(float time) {
+    timeOfDay = time - std::floor(time);
     
-    // Render tiles in isometric order (back to front, left to right)
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            const Tile* tile = getTile(x, y);
-            if (tile) {
-                // Try to use texture if texture manager is available
-                const Texture* tileTexture = nullptr;
-                
-                if (textureManager) {
-                    // Map tile types to asset names with variations
-                    std::string baseName;
-                    if (tile->getType() == TileType::GRASS) {
-                        baseName = "grass_green";
-                    } else if (tile->getType() == TileType::SAND) {
-                        baseName = "sand";
-                    } else if (tile->getType() == TileType::DIRT) {
-                        baseName = "dirt";
-                    } else if (tile->getType() == TileType::STONE) {
-                        baseName = "stone_path";
-                    }
-                    
-                    // Use the tile's variation index for visual diversity
-                    if (!baseName.empty()) {
-                        tileTexture = textureManager->getTileVariation(baseName, tile->getVariation());
-                    }
-                }
-                
-                // Draw tile with texture or fallback to solid color
-                if (tileTexture) {
-                    isoRenderer->drawIsometricTile(x, y, tileTexture);
-                } else {
-                    // Fallback to colored tiles if texture not available
-                    isoRenderer->drawIsometricColoredTile(x, y, tile->getColor());
-                }
-                
-                // Draw decoration if present
-                if (tile->hasDecoration() && textureManager) {
-                    const Texture* decorTexture = textureManager->getTexture(tile->getDecoration());
-                    if (decorTexture) {
-                        // Draw decoration centered on tile
-                        // Note: Decorations are drawn after tiles for proper layering
-                        // This is a simplified version - a full implementation would use
-                        // depth sorting for proper isometric rendering
-                        isoRenderer->drawIsometricTile(x, y, decorTexture);
-                    }
-                }
-            }
-        }
-    }
+    // Sun height from -1 (midnight) to 1 (noon); full daylight for the
+    // middle of the day and none at night, with dusk and dawn in between
+    const float sun = -std::cos(timeOfDay * 2.0f * 3.14159265f);
+    lightMap->setDaylight(sun * 1.5f + 0.5f);
+}
+
+void World::render(Renderer* renderer, IsometricRenderer* isoRenderer, Camera* camera, DrawList& drawList) {
+    (void)camera; // Unused - visibility comes from the renderer's matrices
+    
+    // Ground tiles and decorations are static: draw the cached chunk meshes
+    // and queue decorations so they depth sort with buildings and entities
+    chunkMeshes->render(renderer, isoRenderer, &drawList, lightMap.get());
+}
+
+void World::setJobSystem(JobSystem* jobs) {
+    jobSystem = jobs;
+    chunkMeshes->setJobSystem(jobs);
+}
+
+void World::markTileDirty(int x, int y) {
+    chunkMeshes->markTileDirty(x, y);
+}
+
+void World::markAllDirty() {
+    chunkMeshes->markAllDirty();
 }
 
 Tile* World::getTile(int x, int y) {
@@ -123,6 +115,60 @@ bool World::isValidPosition(int x, int y) const {
     return x >= 0 && x < width && y >= 0 && y < height;
 }
 
+void World::queryResources(const glm::vec2& center, float radius, std::vector<glm::ivec2>& out) const {
+    std::vector<SpatialHash::Id> ids;
+    resourceIndex.queryRadius(center, radius, ids);
+    
+    out.reserve(out.size() + ids.size());
+    for (SpatialHash::Id id : ids) {
+        out.push_back(tileFromId(id));
+    }
+}
+
+bool World::findNearestResource(const glm::vec2& center, float maxRadius, glm::ivec2& outTile) const {
+    std::vector<SpatialHash::Id> ids;
+    resourceIndex.queryNearest(center, 1, maxRadius, ids);
+    
+    if (ids.empty()) {
+        return false;
+    }
+    
+    outTile = tileFromId(ids.front());
+    return true;
+}
+
+bool World::removeResource(int x, int y) {
+    Tile* tile = getTile(x, y);
+    if (!tile || !tile->isResource()) {
+        return false;
+    }
+    
+    tile->setDecoration("");
+    tile->setResource(false);
+    resourceIndex.remove(tileId(x, y));
+    chunkMeshes->markTileDirty(x, y);
+    return true;
+}
+
+void World::rebuildResourceIndex() {
+    PROFILE_SCOPE("World::rebuildResourceIndex");
+    resourceIndex.clear();
+    
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (tiles[y][x]->isResource()) {
+                // Resources sit at the tile center in world (tile) space
+                resourceIndex.insert(tileId(x, y), glm::vec2(x + 0.5f, y + 0.5f));
+            }
+        }
+    }
+}
+
+glm::ivec2 World::tileFromId(SpatialHash::Id id) const {
+    int index = static_cast<int>(id);
+    return glm::ivec2(index % width, index / width);
+}
+
 bool World::loadFromFile(const char* filename) {
     // TODO: Implement JSON loading
     std::cout << "Loading world from: " << filename << std::endl;
@@ -136,12 +182,16 @@ bool World::saveToFile(const char* filename) const {
 }
 
 void World::generateBiomeMap() {
+    PROFILE_SCOPE("World::generateBiomeMap");
     // Create biome map using noise-based temperature and moisture
     biomeMap.resize(height);
     
     const float scale = 0.05f; // Scale for noise (larger = bigger biomes)
     
-    for (int y = 0; y < height; ++y) {
+    // Rows are independent and the noise generator is read-only, so rows can
+    // be generated in parallel when a job system is available
+    auto generateRow = [this, scale](size_t row) {
+        int y = static_cast<int>(row);
         biomeMap[y].resize(width);
         for (int x = 0; x < width; ++x) {
             // Generate temperature and moisture using different noise octaves
@@ -152,6 +202,14 @@ void World::generateBiomeMap() {
             BiomeType biomeType = getBiomeFromNoise(temperature, moisture);
             biomeMap[y][x] = std::make_unique<Biome>(biomeType);
         }
+    };
+    
+    if (jobSystem) {
+        jobSystem->parallelFor(0, static_cast<size_t>(height), 4, generateRow);
+    } else {
+        for (int y = 0; y < height; ++y) {
+            generateRow(static_cast<size_t>(y));
+        }
     }
 }
 
@@ -187,6 +245,7 @@ BiomeType World::getBiomeFromNoise(float temperature, float moisture) const {
 }
 
 void World::generateTerrain() {
+    PROFILE_SCOPE("World::generateTerrain");
     // Generate terrain based on biomes and additional noise
     const float detailScale = 0.15f; // Finer detail for terrain variation
     
@@ -220,6 +279,7 @@ void World::generateTerrain() {
 }
 
 void World::generateDecorations() {
+    PROFILE_SCOPE("World::generateDecorations");
     const int TREE_TYPES = 20;
     const int BUSH_TYPES = 3;
     const int ROCK_TYPES = 2;